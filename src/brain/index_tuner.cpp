@@ -93,16 +93,20 @@ void IndexTuner::BuildIndex(storage::DataTable* table,
   auto table_tile_group_count = table->GetTileGroupCount();
   oid_t tile_groups_indexed = 0;
 
-  auto index_schema = index->GetKeySchema();
-  auto indexed_columns = index_schema->GetIndexedColumns();
-  std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-
   while (index_tile_group_offset < table_tile_group_count &&
          (tile_groups_indexed < max_tile_groups_indexed)) {
     std::unique_ptr<storage::Tuple> tuple_ptr(
         new storage::Tuple(table_schema, true));
 
     auto tile_group = table->GetTileGroup(index_tile_group_offset);
+
+    // Skip the tile group if it was dropped by compaction
+    if (tile_group == nullptr) {
+      index->IncrementIndexedTileGroupOffset();
+      index_tile_group_offset++;
+      continue;
+    }
+
     auto tile_group_id = tile_group->GetTileGroupId();
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
@@ -113,11 +117,8 @@ void IndexTuner::BuildIndex(storage::DataTable* table,
       // Set the location
       ItemPointer location(tile_group_id, tuple_id);
 
-      // Set the key
-      key->SetFromTuple(tuple_ptr.get(), indexed_columns, index->GetPool());
-
       // Insert in specific index
-      index->InsertEntry(key.get(), location);
+      index->InsertTupleEntry(tuple_ptr.get(), location);
     }
 
     // Update indexed tile group offset (set of tgs indexed)
@@ -0,0 +1,112 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.cpp
+//
+// Identification: src/brain/tile_group_compactor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "brain/tile_group_compactor.h"
+
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace brain {
+
+TileGroupCompactor& TileGroupCompactor::GetInstance() {
+  static TileGroupCompactor tile_group_compactor;
+  return tile_group_compactor;
+}
+
+TileGroupCompactor::TileGroupCompactor() {
+  // Nothing to do here !
+}
+
+TileGroupCompactor::~TileGroupCompactor() {
+  // Nothing to do here !
+}
+
+void TileGroupCompactor::Start() {
+  // Set signal
+  compaction_stop = false;
+
+  // Launch thread
+  tile_group_compactor_thread =
+      std::thread(&brain::TileGroupCompactor::Compact, this);
+}
+
+void TileGroupCompactor::CompactTable(storage::DataTable* table,
+                                      const cid_t& max_dead_cid) {
+  auto tile_group_count = table->GetTileGroupCount();
+
+  for (oid_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    if (compaction_stop == true) return;
+
+    auto dropped =
+        table->CompactTileGroup(tile_group_offset, threshold, max_dead_cid);
+    if (dropped == true) {
+      LOG_TRACE("Compacted tile group %u of table %u", tile_group_offset,
+                table->GetOid());
+    }
+  }
+}
+
+void TileGroupCompactor::Compact() {
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // Continue till signal is not false
+  while (compaction_stop == false) {
+    std::vector<storage::DataTable*> current_tables;
+    {
+      std::lock_guard<std::mutex> lock(tile_group_compactor_mutex);
+      current_tables = tables;
+    }
+
+    // Versions created by transactions that can still be running
+    // are not moved
+    auto max_dead_cid = txn_manager.GetMaxCommittedCid();
+
+    // Go over all tables
+    for (auto table : current_tables) {
+      CompactTable(table, max_dead_cid);
+    }
+
+    // Sleep a bit
+    std::this_thread::sleep_for(std::chrono::microseconds(sleep_duration));
+  }
+}
+
+void TileGroupCompactor::Stop() {
+  // Stop compaction
+  compaction_stop = true;
+
+  // Stop thread
+  tile_group_compactor_thread.join();
+}
+
+void TileGroupCompactor::AddTable(storage::DataTable* table) {
+  {
+    std::lock_guard<std::mutex> lock(tile_group_compactor_mutex);
+    LOG_TRACE("Tile group compactor adding table : %p", table);
+
+    tables.push_back(table);
+  }
+}
+
+void TileGroupCompactor::ClearTables() {
+  {
+    std::lock_guard<std::mutex> lock(tile_group_compactor_mutex);
+    tables.clear();
+  }
+}
+
+}  // End brain namespace
+}  // End peloton namespace
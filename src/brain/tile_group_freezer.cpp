@@ -0,0 +1,111 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_freezer.cpp
+//
+// Identification: src/brain/tile_group_freezer.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "brain/tile_group_freezer.h"
+
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace brain {
+
+TileGroupFreezer& TileGroupFreezer::GetInstance() {
+  static TileGroupFreezer tile_group_freezer;
+  return tile_group_freezer;
+}
+
+TileGroupFreezer::TileGroupFreezer() {
+  // Nothing to do here !
+}
+
+TileGroupFreezer::~TileGroupFreezer() {
+  // Nothing to do here !
+}
+
+void TileGroupFreezer::Start() {
+  // Set signal
+  freezing_stop = false;
+
+  // Launch thread
+  tile_group_freezer_thread =
+      std::thread(&brain::TileGroupFreezer::Freeze, this);
+}
+
+void TileGroupFreezer::FreezeTable(storage::DataTable* table,
+                                   const cid_t& max_dead_cid) {
+  auto tile_group_count = table->GetTileGroupCount();
+
+  for (oid_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    if (freezing_stop == true) return;
+
+    auto tile_group = table->FreezeTileGroup(tile_group_offset, max_dead_cid);
+    if (tile_group != nullptr) {
+      LOG_TRACE("Froze tile group %u of table %u", tile_group_offset,
+                table->GetOid());
+    }
+  }
+}
+
+void TileGroupFreezer::Freeze() {
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // Continue till signal is not false
+  while (freezing_stop == false) {
+    std::vector<storage::DataTable*> current_tables;
+    {
+      std::lock_guard<std::mutex> lock(tile_group_freezer_mutex);
+      current_tables = tables;
+    }
+
+    // Versions created by transactions that can still be running
+    // are not frozen
+    auto max_dead_cid = txn_manager.GetMaxCommittedCid();
+
+    // Go over all tables
+    for (auto table : current_tables) {
+      FreezeTable(table, max_dead_cid);
+    }
+
+    // Sleep a bit
+    std::this_thread::sleep_for(std::chrono::microseconds(sleep_duration));
+  }
+}
+
+void TileGroupFreezer::Stop() {
+  // Stop freezing
+  freezing_stop = true;
+
+  // Stop thread
+  tile_group_freezer_thread.join();
+}
+
+void TileGroupFreezer::AddTable(storage::DataTable* table) {
+  {
+    std::lock_guard<std::mutex> lock(tile_group_freezer_mutex);
+    LOG_TRACE("Tile group freezer adding table : %p", table);
+
+    tables.push_back(table);
+  }
+}
+
+void TileGroupFreezer::ClearTables() {
+  {
+    std::lock_guard<std::mutex> lock(tile_group_freezer_mutex);
+    tables.clear();
+  }
+}
+
+}  // End brain namespace
+}  // End peloton namespace
@@ -36,21 +36,42 @@ Manager &Manager::GetInstance() {
 void Manager::AddTileGroup(const oid_t oid,
                            std::shared_ptr<storage::TileGroup> location) {
 
+  std::shared_ptr<storage::TileGroup> old_location;
+
   {
-    // add/update the catalog reference to the tile group
+    // add/update the catalog reference to the tile group. replacements of
+    // the same oid are serialized, so each replaced tile group is retired
+    // exactly once.
+    std::lock_guard<std::mutex> lock(locator_mutex);
+    old_location = locator.Find(oid);
+    raw_locator.Update(oid, location.get());
     locator.Update(oid, location);
   }
 
+  // the replaced tile group may still be referenced by running transactions
+  if (old_location != nullptr && old_location != location) {
+    RetireTileGroup(std::move(old_location));
+  }
+
 }
 
 void Manager::DropTileGroup(const oid_t oid) {
   concurrency::TransactionManagerFactory::GetInstance().DroppingTileGroup(oid);
 
+  std::shared_ptr<storage::TileGroup> old_location;
+
   {
     // drop the catalog reference to the tile group
+    std::lock_guard<std::mutex> lock(locator_mutex);
+    old_location = locator.Find(oid);
+    raw_locator.Erase(oid, nullptr);
     locator.Erase(oid, empty_location);
   }
 
+  if (old_location != nullptr) {
+    RetireTileGroup(std::move(old_location));
+  }
+
 }
 
 std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
@@ -67,11 +88,50 @@ std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
 void Manager::ClearTileGroup() {
 
   {
+    std::lock_guard<std::mutex> lock(locator_mutex);
+    raw_locator.Clear(nullptr);
     locator.Clear(empty_location);
   }
 
 }
 
+void Manager::RetireTileGroup(
+    std::shared_ptr<storage::TileGroup> &&tile_group) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // transactions that begin from now on can no longer find this tile group.
+  // they begin at or after this commit id.
+  auto retire_cid = txn_manager.GetNextCommitId();
+
+  {
+    std::lock_guard<std::mutex> lock(retired_tile_groups_mutex);
+    retired_tile_groups.emplace_back(retire_cid, std::move(tile_group));
+  }
+
+  ReclaimTileGroups(txn_manager.GetMaxCommittedCid());
+}
+
+void Manager::ReclaimTileGroups(const cid_t max_dead_cid) {
+  std::vector<std::shared_ptr<storage::TileGroup>> reclaimed_tile_groups;
+
+  {
+    std::lock_guard<std::mutex> lock(retired_tile_groups_mutex);
+
+    auto itr = retired_tile_groups.begin();
+    while (itr != retired_tile_groups.end()) {
+      if (itr->first <= max_dead_cid) {
+        reclaimed_tile_groups.push_back(std::move(itr->second));
+        itr = retired_tile_groups.erase(itr);
+      } else {
+        ++itr;
+      }
+    }
+  }
+
+  // the tile groups are destroyed outside of the latch
+  LOG_TRACE("Reclaimed %lu tile groups", reclaimed_tile_groups.size());
+}
+
 //===--------------------------------------------------------------------===//
 // DATABASE
 //===--------------------------------------------------------------------===//
@@ -16,6 +16,25 @@
 // Layout mode
 int peloton_layout_mode = LAYOUT_TYPE_ROW;
 
+// Layout of the MVCC headers in tile groups (row or column)
+LayoutType peloton_header_layout_mode = LAYOUT_TYPE_ROW;
+
+// Number of active tile groups per table used for inserts
+int peloton_active_tile_group_count = 1;
+
+// Back large in-memory allocations with huge pages
+bool peloton_huge_page_allocation = false;
+
+// Place large in-memory allocations on the NUMA node of the allocating thread
+bool peloton_numa_aware_allocation = false;
+
+// Longest time between two refreshes of the max dead txn cid (in ms)
+int peloton_epoch_length = 40;
+
+// Longest time (in us) a writer waits for the owner of a version, 0 to fail
+// at once, or -1 for the default of the concurrency control protocol
+int peloton_ownership_wait_us = -1;
+
 // Logging mode
 LoggingType peloton_logging_mode = LOGGING_TYPE_INVALID;
 
@@ -35,5 +54,8 @@ int peloton_flush_frequency_micros;
 
 int peloton_flush_mode;
 
+// Commits queued before the frontend loggers flush them as a group
+int peloton_group_commit_size = 256;
+
 // pcommit latency (for NVM WBL)
 int peloton_pcommit_latency;
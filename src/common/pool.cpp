@@ -20,101 +20,167 @@ namespace peloton {
 
 static const size_t TEMP_POOL_CHUNK_SIZE = 512;  // 512 B
 
-VarlenPool::VarlenPool(BackendType backend_type)
-    : backend_type(backend_type),
-      allocation_size(TEMP_POOL_CHUNK_SIZE),
-      max_chunk_count(1),
-      current_chunk_index(0) {
-  Init();
+// Chunks are split into this many thread-local regions
+static const size_t THREAD_REGIONS_PER_CHUNK = 16;
+
+// Smaller regions are not worth the unused space they leave behind
+static const size_t MIN_THREAD_REGION_SIZE = 256;  // 256 B
+
+// Number of pools a thread keeps a region of
+static const size_t THREAD_REGION_CACHE_SIZE = 4;
+
+// Region of a chunk that only one thread allocates from
+struct ThreadRegion {
+  uint64_t pool_id;
+  char *current;
+  char *end;
+  // when the thread last allocated from the region
+  uint64_t last_use;
+};
+
+static thread_local ThreadRegion thread_regions[THREAD_REGION_CACHE_SIZE];
+
+static thread_local uint64_t thread_region_clock = 0;
+
+// Any cached region can hold any pool, so a thread that allocates from
+// several pools in turn keeps a region of each. Otherwise the least
+// recently used region makes room for the pool.
+static ThreadRegion &GetThreadRegion(const uint64_t &pool_id) {
+  ThreadRegion *victim = &thread_regions[0];
+  for (size_t region_itr = 0; region_itr < THREAD_REGION_CACHE_SIZE;
+       region_itr++) {
+    auto &region = thread_regions[region_itr];
+    if (region.pool_id == pool_id) {
+      victim = &region;
+      break;
+    }
+    if (region.last_use < victim->last_use) {
+      victim = &region;
+    }
+  }
+
+  victim->last_use = ++thread_region_clock;
+  return *victim;
 }
 
-VarlenPool::VarlenPool(BackendType backend_type, uint64_t allocation_size,
-                       uint64_t max_chunk_count)
+// Ids are never reused, so a region of a destroyed pool is never matched
+static std::atomic<uint64_t> next_pool_id(1);
+
+static uint64_t GetThreadRegionSize(const uint64_t &allocation_size) {
+  uint64_t thread_region_size = allocation_size / THREAD_REGIONS_PER_CHUNK;
+  if (thread_region_size < MIN_THREAD_REGION_SIZE) return 0;
+  // Keep regions 8 byte aligned
+  return thread_region_size - (thread_region_size % 8);
+}
+
+VarlenPool::VarlenPool(BackendType backend_type)
+    : VarlenPool(backend_type, TEMP_POOL_CHUNK_SIZE) {}
+
+VarlenPool::VarlenPool(BackendType backend_type, uint64_t allocation_size)
     : backend_type(backend_type),
       allocation_size(allocation_size),
-      max_chunk_count(static_cast<std::size_t>(max_chunk_count)),
-      current_chunk_index(0) {
+      thread_region_size(GetThreadRegionSize(allocation_size)),
+      pool_id(next_pool_id++),
+      current_chunk(nullptr),
+      chunk_list(nullptr),
+      allocated_memory(0) {
   Init();
 }
 
 void VarlenPool::Init() {
+  auto chunk = NewChunk(allocation_size);
+  AddChunk(chunk);
+  current_chunk = chunk;
+}
+
+VarlenPool::~VarlenPool() {
+  auto chunk = chunk_list.load();
+  while (chunk != nullptr) {
+    auto next_chunk = chunk->next;
+    ReleaseChunk(chunk);
+    chunk = next_chunk;
+  }
+}
+
+VarlenPool::ArenaChunk *VarlenPool::NewChunk(const uint64_t &size) {
   auto &storage_manager = storage::StorageManager::GetInstance();
-  char *storage = reinterpret_cast<char *>(
-      storage_manager.Allocate(backend_type, allocation_size));
+  char *storage =
+      reinterpret_cast<char *>(storage_manager.Allocate(backend_type, size));
 
-  chunks.push_back(Chunk(allocation_size, storage));
+  return new ArenaChunk(size, storage);
 }
 
-VarlenPool::~VarlenPool() {
+void VarlenPool::ReleaseChunk(ArenaChunk *chunk) {
   auto &storage_manager = storage::StorageManager::GetInstance();
+  storage_manager.Release(backend_type, chunk->chunk_data);
+  delete chunk;
+}
 
-  for (std::size_t ii = 0; ii < chunks.size(); ii++) {
-    storage_manager.Release(backend_type, chunks[ii].chunk_data);
-  }
+void VarlenPool::AddChunk(ArenaChunk *chunk) {
+  allocated_memory += chunk->size;
 
-  for (std::size_t ii = 0; ii < oversize_chunks.size(); ii++) {
-    storage_manager.Release(backend_type, oversize_chunks[ii].chunk_data);
-  }
+  ArenaChunk *head = chunk_list.load();
+  do {
+    chunk->next = head;
+  } while (chunk_list.compare_exchange_weak(head, chunk) == false);
 }
 
 // Allocate a continous block of memory of the specified size.
 void *VarlenPool::Allocate(std::size_t size) {
-  void *retval = nullptr;
-
-  // Protect using pool lock
-  // TODO: Can make locking more fine-grained
-  {
-    std::lock_guard<std::mutex> pool_lock(pool_mutex);
-
-    // See if there is space in the current chunk
-    Chunk *current_chunk = &chunks[current_chunk_index];
-    if (size > current_chunk->size - current_chunk->offset) {
-      // Not enough space. Check if it is greater than our allocation size.
-      if (size > allocation_size) {
-        // Allocate an oversize chunk that will not be reused.
-        auto &storage_manager = storage::StorageManager::GetInstance();
-        char *storage = reinterpret_cast<char *>(
-            storage_manager.Allocate(backend_type, size));
-
-        oversize_chunks.push_back(Chunk(nexthigher(size), storage));
-        Chunk &newChunk = oversize_chunks.back();
-        newChunk.offset = size;
-        return newChunk.chunk_data;
-      }
-
-      // Check if there is an already allocated chunk we can use.
-      current_chunk_index++;
-
-      if (current_chunk_index < chunks.size()) {
-        current_chunk = &chunks[current_chunk_index];
-        current_chunk->offset = size;
-        return current_chunk->chunk_data;
-      } else {
-        // Need to allocate a new chunk
-        auto &storage_manager = storage::StorageManager::GetInstance();
-        char *storage = reinterpret_cast<char *>(
-            storage_manager.Allocate(backend_type, allocation_size));
-
-        chunks.push_back(Chunk(allocation_size, storage));
-        Chunk &new_chunk = chunks.back();
-        new_chunk.offset = size;
-        return new_chunk.chunk_data;
-      }
-    }
+  // Ensure 8 byte alignment of future allocations
+  std::size_t aligned_size = size + ((8 - (size % 8)) % 8);
+
+  // Large allocations would waste most of a thread region
+  if (thread_region_size == 0 || aligned_size > thread_region_size / 4) {
+    return AllocateFromChunk(aligned_size);
+  }
 
+  auto current_pool_id = pool_id.load(std::memory_order_relaxed);
+  auto &region = GetThreadRegion(current_pool_id);
+
+  // Carve a new region out of the chunk if needed
+  if (region.pool_id != current_pool_id ||
+      static_cast<std::size_t>(region.end - region.current) < aligned_size) {
+    char *storage =
+        reinterpret_cast<char *>(AllocateFromChunk(thread_region_size));
+    region.pool_id = current_pool_id;
+    region.current = storage;
+    region.end = storage + thread_region_size;
+  }
+
+  void *retval = region.current;
+  region.current += aligned_size;
+  return retval;
+}
+
+void *VarlenPool::AllocateFromChunk(const std::size_t &size) {
+  // Allocate an oversize chunk that will not be reused.
+  if (size > allocation_size) {
+    auto chunk = NewChunk(size);
+    chunk->offset = size;
+    AddChunk(chunk);
+    return chunk->chunk_data;
+  }
+
+  while (true) {
     // Get the offset into the current chunk. Then increment the
     // offset counter by the amount being allocated.
-    retval = current_chunk->chunk_data + current_chunk->offset;
-    current_chunk->offset += size;
+    ArenaChunk *chunk = current_chunk.load();
+    uint64_t offset = chunk->offset.fetch_add(size);
+    if (offset + size <= chunk->size) {
+      return chunk->chunk_data + offset;
+    }
 
-    // Ensure 8 byte alignment of future allocations
-    current_chunk->offset += (8 - (current_chunk->offset % 8));
-    if (current_chunk->offset > current_chunk->size) {
-      current_chunk->offset = current_chunk->size;
+    // Not enough space. Install a new chunk unless another thread already did.
+    auto new_chunk = NewChunk(allocation_size);
+    new_chunk->offset = size;
+    if (current_chunk.compare_exchange_strong(chunk, new_chunk)) {
+      AddChunk(new_chunk);
+      return new_chunk->chunk_data;
     }
-  }
 
-  return retval;
+    ReleaseChunk(new_chunk);
+  }
 }
 
 // Allocate a continous block of memory of the specified size conveniently
@@ -124,45 +190,27 @@ void *VarlenPool::AllocateZeroes(std::size_t size) {
 }
 
 void VarlenPool::Purge() {
-  // Protect using pool lock
-  {
-    std::lock_guard<std::mutex> pool_lock(pool_mutex);
-
-    // Erase any oversize chunks that were allocated
-    const std::size_t numOversizeChunks = oversize_chunks.size();
-    for (std::size_t ii = 0; ii < numOversizeChunks; ii++) {
-      auto &storage_manager = storage::StorageManager::GetInstance();
-      storage_manager.Release(backend_type, oversize_chunks[ii].chunk_data);
-    }
-    oversize_chunks.clear();
-
-    // Set the current chunk to the first in the list
-    current_chunk_index = 0;
-    std::size_t num_chunks = chunks.size();
-
-    // If more then maxChunkCount chunks are allocated erase all extra chunks
-    if (num_chunks > max_chunk_count) {
-      for (std::size_t ii = max_chunk_count; ii < num_chunks; ii++) {
-        auto &storage_manager = storage::StorageManager::GetInstance();
-        storage_manager.Release(backend_type, chunks[ii].chunk_data);
-      }
-      chunks.resize(max_chunk_count);
-    }
-
-    num_chunks = chunks.size();
-    for (std::size_t ii = 0; ii < num_chunks; ii++) {
-      chunks[ii].offset = 0;
+  ArenaChunk *kept_chunk = current_chunk.load();
+
+  // Erase all the other chunks
+  auto chunk = chunk_list.load();
+  while (chunk != nullptr) {
+    auto next_chunk = chunk->next;
+    if (chunk != kept_chunk) {
+      ReleaseChunk(chunk);
     }
+    chunk = next_chunk;
   }
-}
 
-int64_t VarlenPool::GetAllocatedMemory() {
-  int64_t total = 0;
-  total += chunks.size() * allocation_size;
-  for (uint32_t i = 0; i < oversize_chunks.size(); i++) {
-    total += oversize_chunks[i].getSize();
-  }
-  return total;
+  kept_chunk->offset = 0;
+  kept_chunk->next = nullptr;
+  chunk_list = kept_chunk;
+  allocated_memory = kept_chunk->size;
+
+  // Drop the thread regions on the released chunks
+  pool_id = next_pool_id++;
 }
 
+int64_t VarlenPool::GetAllocatedMemory() { return allocated_memory.load(); }
+
 }  // End peloton namespace
@@ -972,6 +972,36 @@ std::string LogRecordTypeToString(LogRecordType type) {
   return "INVALID";
 }
 
+//===--------------------------------------------------------------------===//
+// Concurrency Type - String Utilities
+//===--------------------------------------------------------------------===//
+
+std::string ConcurrencyTypeToString(ConcurrencyType type) {
+  switch (type) {
+    case CONCURRENCY_TYPE_INVALID: {
+      return "INVALID";
+    }
+    case CONCURRENCY_TYPE_OPTIMISTIC: {
+      return "OPTIMISTIC";
+    }
+    case CONCURRENCY_TYPE_TO: {
+      return "TO";
+    }
+  }
+  return "INVALID";
+}
+
+ConcurrencyType StringToConcurrencyType(const std::string& str) {
+  if (str == "INVALID") {
+    return CONCURRENCY_TYPE_INVALID;
+  } else if (str == "OPTIMISTIC") {
+    return CONCURRENCY_TYPE_OPTIMISTIC;
+  } else if (str == "TO") {
+    return CONCURRENCY_TYPE_TO;
+  }
+  return CONCURRENCY_TYPE_INVALID;
+}
+
 ValueType PostgresValueTypeToPelotonValueType(
     PostgresValueType PostgresValType) {
   ValueType value_type = VALUE_TYPE_INVALID;
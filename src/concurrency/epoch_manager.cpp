@@ -13,9 +13,191 @@
 
 #include "concurrency/epoch_manager.h"
 
+#include <algorithm>
+#include <chrono>
+
+#include "common/exception.h"
+
+// Longest time between two refreshes of the max dead txn cid (in ms)
+extern int peloton_epoch_length;
+
 namespace peloton {
 namespace concurrency {
 
-//  volatile cid_t EpochManager::curr_epoch_ = 1;
+// Slot of the calling thread, released when the thread exits
+struct EpochSlotHolder {
+  EpochManager *epoch_manager = nullptr;
+  size_t slot_id = 0;
+
+  ~EpochSlotHolder() {
+    if (epoch_manager != nullptr) {
+      epoch_manager->ReleaseSlot(slot_id);
+    }
+  }
+};
+
+static thread_local EpochSlotHolder epoch_slot_holder;
+
+EpochManager::EpochManager() : slot_count_(0), max_dead_cid_(0),
+                               finish_(false) {
+  ts_thread_ = std::thread(&EpochManager::Start, this);
 }
+
+EpochManager::~EpochManager() {
+  finish_ = true;
+  ts_thread_.join();
+}
+
+void EpochManager::Reset() {
+  finish_ = true;
+  ts_thread_.join();
+
+  for (size_t slot_itr = 0; slot_itr < slot_count_; slot_itr++) {
+    slots_[slot_itr].last_begin_cid_ = 0;
+  }
+  max_dead_cid_ = 0;
+
+  finish_ = false;
+  ts_thread_ = std::thread(&EpochManager::Start, this);
+}
+
+size_t EpochManager::AcquireSlot() {
+  for (size_t slot_itr = 0; slot_itr < EPOCH_MAX_THREAD_COUNT; slot_itr++) {
+    bool in_use = false;
+    if (slots_[slot_itr].in_use_.compare_exchange_strong(in_use, true)) {
+      // make the slot visible to RefreshMaxDeadTxnCid
+      auto slot_count = slot_count_.load();
+      while (slot_count <= slot_itr &&
+             slot_count_.compare_exchange_weak(slot_count, slot_itr + 1) ==
+                 false)
+        ;
+      return slot_itr;
+    }
+  }
+
+  throw TransactionException("Too many threads running transactions");
+}
+
+void EpochManager::ReleaseSlot(size_t slot_id) {
+  auto &slot = slots_[slot_id];
+  slot.txn_count_ = 0;
+  slot.begin_cid_ = MAX_CID;
+  slot.commit_cid_ = MAX_CID;
+  slot.in_use_ = false;
+}
+
+size_t EpochManager::EnterEpoch() {
+  if (epoch_slot_holder.epoch_manager != this) {
+    if (epoch_slot_holder.epoch_manager != nullptr) {
+      epoch_slot_holder.epoch_manager->ReleaseSlot(epoch_slot_holder.slot_id);
+    }
+    epoch_slot_holder.slot_id = AcquireSlot();
+    epoch_slot_holder.epoch_manager = this;
+  }
+
+  auto slot_id = epoch_slot_holder.slot_id;
+  auto &slot = slots_[slot_id];
+
+  // the begin cid read after this is at least the max dead txn cid, so no
+  // version the transaction can read is reclaimed in the meantime.
+  if (slot.txn_count_++ == 0) {
+    slot.begin_cid_ = max_dead_cid_.load();
+  }
+
+  return slot_id;
+}
+
+void EpochManager::SetBeginCid(size_t epoch_id, cid_t begin_cid) {
+  auto &slot = slots_[epoch_id];
+
+  if (slot.txn_count_ == 1 || begin_cid < slot.begin_cid_) {
+    slot.begin_cid_ = begin_cid;
+  }
+
+  if (begin_cid > slot.last_begin_cid_) {
+    slot.last_begin_cid_ = begin_cid;
+  }
 }
+
+void EpochManager::ExitEpoch(size_t epoch_id) {
+  auto &slot = slots_[epoch_id];
+  PL_ASSERT(slot.txn_count_ > 0);
+
+  if (--slot.txn_count_ == 0) {
+    slot.begin_cid_ = MAX_CID;
+  }
+}
+
+void EpochManager::EnterCommit(size_t epoch_id) {
+  slots_[epoch_id].commit_cid_ = INVALID_CID;
+}
+
+void EpochManager::SetCommitCid(size_t epoch_id, cid_t commit_cid) {
+  slots_[epoch_id].commit_cid_ = commit_cid;
+}
+
+void EpochManager::ExitCommit(size_t epoch_id) {
+  slots_[epoch_id].commit_cid_ = MAX_CID;
+}
+
+// a transaction that took a commit id up to the cid published that it
+// commits before the cid was read, so the slots are read after it.
+void EpochManager::WaitForCommits(cid_t cid) {
+  auto slot_count = slot_count_.load();
+
+  for (size_t slot_itr = 0; slot_itr < slot_count; slot_itr++) {
+    while (slots_[slot_itr].commit_cid_.load() <= cid) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+// the largest begin cid must be read before the running transactions. a
+// transaction that is not found running then reads its begin cid after the
+// largest begin cid was read, so it begins at or after it.
+cid_t EpochManager::RefreshMaxDeadTxnCid() {
+  auto slot_count = slot_count_.load();
+
+  cid_t max_begin_cid = 0;
+  for (size_t slot_itr = 0; slot_itr < slot_count; slot_itr++) {
+    max_begin_cid =
+        std::max(max_begin_cid, slots_[slot_itr].last_begin_cid_.load());
+  }
+
+  cid_t min_running_cid = MAX_CID;
+  for (size_t slot_itr = 0; slot_itr < slot_count; slot_itr++) {
+    min_running_cid =
+        std::min(min_running_cid, slots_[slot_itr].begin_cid_.load());
+  }
+
+  auto max_dead_cid = std::min(max_begin_cid, min_running_cid);
+  auto old_max_dead_cid = max_dead_cid_.load();
+  while (max_dead_cid > old_max_dead_cid &&
+         max_dead_cid_.compare_exchange_weak(old_max_dead_cid, max_dead_cid) ==
+             false)
+    ;
+
+  return max_dead_cid_.load();
+}
+
+void EpochManager::Start() {
+  int epoch_length = EPOCH_MIN_LENGTH;
+
+  while (!finish_) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(epoch_length));
+
+    auto old_max_dead_cid = max_dead_cid_.load();
+    auto max_dead_cid = RefreshMaxDeadTxnCid();
+
+    // refresh more often while transactions finish
+    int max_epoch_length = std::max(peloton_epoch_length, EPOCH_MIN_LENGTH);
+    if (max_dead_cid > old_max_dead_cid) {
+      epoch_length = std::max(epoch_length / 2, EPOCH_MIN_LENGTH);
+    } else {
+      epoch_length = std::min(epoch_length * 2, max_epoch_length);
+    }
+  }
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
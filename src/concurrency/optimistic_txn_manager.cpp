@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_txn_manager.cpp
+//
+// Identification: src/concurrency/optimistic_txn_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "concurrency/optimistic_txn_manager.h"
+
+#include "concurrency/transaction.h"
+#include "common/logger.h"
+
+namespace peloton {
+namespace concurrency {
+
+// Longest time (in us) a writer waits for the owner of the version it
+// updates, unless another wait is configured. Bounds the wait, and so
+// breaks cycles of waiting writers.
+#define OPTIMISTIC_OWNERSHIP_WAIT_US 10000
+
+// Longest time (in us) a writer waits for the owner of a version
+extern int peloton_ownership_wait_us;
+
+OptimisticTxnManager &OptimisticTxnManager::GetInstance() {
+  static OptimisticTxnManager txn_manager;
+  return txn_manager;
+}
+
+// the latest version is ownable even if another transaction owns it, as
+// the owner may still abort.
+// this function is called by update/delete executors.
+bool OptimisticTxnManager::IsOwnable(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+  auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+  return tuple_txn_id != INVALID_TXN_ID && tuple_end_cid == MAX_CID;
+}
+
+// writers wait for owners by default.
+int OptimisticTxnManager::GetOwnershipWait() {
+  if (peloton_ownership_wait_us < 0) {
+    return OPTIMISTIC_OWNERSHIP_WAIT_US;
+  }
+  return peloton_ownership_wait_us;
+}
+
+// get write lock on a tuple, waiting for the current owner to finish.
+// this is invoked by update/delete executors.
+bool OptimisticTxnManager::AcquireOwnership(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tile_group_id, const oid_t &tuple_id) {
+  // snapshot reads do not write.
+  if (current_txn->IsSnapshotRead() == true) {
+    LOG_TRACE("Fail to acquire tuple. Snapshot read.");
+    SetTransactionResult(Result::RESULT_FAILURE);
+    return false;
+  }
+
+  tile_group_header->IncreaseOwnerCount();
+
+  if (AcquireVersion(tile_group_header, tile_group_id, tuple_id,
+                     GetOwnershipWait(), false) == false) {
+    tile_group_header->DecreaseOwnerCount();
+    LOG_TRACE("Fail to acquire tuple. Set txn failure.");
+    SetTransactionResult(Result::RESULT_FAILURE);
+    return false;
+  }
+  return true;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -0,0 +1,154 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.cpp
+//
+// Identification: src/concurrency/read_write_set.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "concurrency/read_write_set.h"
+
+#include <algorithm>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace concurrency {
+
+// Slots of a new set
+#define RW_SET_INITIAL_SLOT_COUNT 64
+
+// Released sets are shrunk back if they grew beyond this slot count
+#define RW_SET_MAX_CACHED_SLOT_COUNT (64 * 1024)
+
+// Released sets kept per thread
+#define RW_SET_MAX_CACHED_COUNT 4
+
+// sets released on this thread
+static thread_local std::vector<std::unique_ptr<ReadWriteSet>> cached_rw_sets;
+
+ReadWriteSet::ReadWriteSet() : slots(RW_SET_INITIAL_SLOT_COUNT, 0) {}
+
+std::unique_ptr<ReadWriteSet> ReadWriteSet::Acquire() {
+  if (cached_rw_sets.empty() == true) {
+    return std::unique_ptr<ReadWriteSet>(new ReadWriteSet());
+  }
+
+  auto rw_set = std::move(cached_rw_sets.back());
+  cached_rw_sets.pop_back();
+  return rw_set;
+}
+
+void ReadWriteSet::Release(std::unique_ptr<ReadWriteSet> rw_set) {
+  if (rw_set == nullptr || cached_rw_sets.size() >= RW_SET_MAX_CACHED_COUNT) {
+    return;
+  }
+
+  // Do not keep the memory of an unusually large transaction
+  if (rw_set->slots.size() > RW_SET_MAX_CACHED_SLOT_COUNT) {
+    return;
+  }
+
+  rw_set->Clear();
+  cached_rw_sets.push_back(std::move(rw_set));
+}
+
+size_t ReadWriteSet::GetSlot(const ItemPointer &location) const {
+  uint64_t key = (static_cast<uint64_t>(location.block) << 32) |
+                 static_cast<uint64_t>(location.offset);
+
+  // 64-bit finalizer of murmur3
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+
+  auto mask = slots.size() - 1;
+  auto slot = static_cast<size_t>(key) & mask;
+
+  // Linear probing
+  while (slots[slot] != 0) {
+    auto &entry = entries[slots[slot] - 1];
+    if (entry.location.block == location.block &&
+        entry.location.offset == location.offset) {
+      break;
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  return slot;
+}
+
+RWType *ReadWriteSet::Find(const ItemPointer &location) {
+  auto slot = GetSlot(location);
+  if (slots[slot] == 0) {
+    return nullptr;
+  }
+  return &entries[slots[slot] - 1].type;
+}
+
+void ReadWriteSet::Insert(const ItemPointer &location, const RWType &type) {
+  if ((entries.size() + 1) * 2 > slots.size()) {
+    Grow();
+  }
+
+  auto slot = GetSlot(location);
+  PL_ASSERT(slots[slot] == 0);
+
+  entries.push_back({location, type});
+  slots[slot] = entries.size();
+}
+
+void ReadWriteSet::InsertScan(const oid_t &tile_group_id,
+                              const oid_t &begin_tuple_id,
+                              const oid_t &end_tuple_id) {
+  PL_ASSERT(begin_tuple_id < end_tuple_id);
+
+  // rescans of a table, e.g. by the inner side of a join, find the ranges
+  // of their tile groups here
+  auto last_scan = last_scans.find(tile_group_id);
+  if (last_scan != last_scans.end()) {
+    auto &last = scans[last_scan->second];
+    if (begin_tuple_id <= last.end_tuple_id &&
+        last.begin_tuple_id <= end_tuple_id) {
+      last.begin_tuple_id = std::min(last.begin_tuple_id, begin_tuple_id);
+      last.end_tuple_id = std::max(last.end_tuple_id, end_tuple_id);
+      return;
+    }
+  }
+
+  last_scans[tile_group_id] = scans.size();
+  scans.push_back({tile_group_id, begin_tuple_id, end_tuple_id});
+}
+
+void ReadWriteSet::Grow() {
+  slots.assign(slots.size() * 2, 0);
+
+  for (size_t entry_itr = 0; entry_itr < entries.size(); entry_itr++) {
+    slots[GetSlot(entries[entry_itr].location)] = entry_itr + 1;
+  }
+}
+
+void ReadWriteSet::Clear() {
+  // Only the slots of the entries are in use. The probe sequence of an
+  // entry only passes over older entries, so clear the newest first.
+  if (entries.size() * 8 < slots.size()) {
+    for (auto entry_itr = entries.rbegin(); entry_itr != entries.rend();
+         entry_itr++) {
+      slots[GetSlot(entry_itr->location)] = 0;
+    }
+  } else {
+    std::fill(slots.begin(), slots.end(), 0);
+  }
+
+  entries.clear();
+  scans.clear();
+  last_scans.clear();
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -24,100 +24,136 @@
 namespace peloton {
 namespace concurrency {
 
+// transaction released on this thread
+static thread_local std::unique_ptr<Transaction> cached_txn;
+
+Transaction *Transaction::Acquire(const txn_id_t &txn_id,
+                                  const cid_t &begin_cid,
+                                  const bool snapshot_read) {
+  if (cached_txn == nullptr) {
+    return new Transaction(txn_id, begin_cid, snapshot_read);
+  }
+
+  Transaction *txn = cached_txn.release();
+  txn->txn_id_ = txn_id;
+  txn->begin_cid_ = begin_cid;
+  txn->end_cid_ = MAX_CID;
+  txn->rw_set_ = ReadWriteSet::Acquire();
+  txn->result_ = Result::RESULT_SUCCESS;
+  txn->is_written_ = false;
+  txn->insert_count_ = 0;
+  txn->is_snapshot_read_ = snapshot_read;
+  return txn;
+}
+
+void Transaction::Release(Transaction *txn) {
+  if (txn == nullptr) {
+    return;
+  }
+
+  // the sets and pools are cached on their own
+  ReadWriteSet::Release(std::move(txn->rw_set_));
+  txn->rb_seg_pool_.reset();
+  txn->commit_callback_ = nullptr;
+
+  cached_txn.reset(txn);
+}
+
 void Transaction::RecordRead(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    PL_ASSERT(rw_set_.at(tile_group_id).at(tuple_id) != RW_TYPE_DELETE &&
-              rw_set_.at(tile_group_id).at(tuple_id) != RW_TYPE_INS_DEL);
+  auto type = rw_set_->Find(location);
+
+  if (type != nullptr) {
+    PL_ASSERT(*type != RW_TYPE_DELETE && *type != RW_TYPE_INS_DEL);
     return;
   } else {
-    rw_set_[tile_group_id][tuple_id] = RW_TYPE_READ;
+    rw_set_->Insert(location, RW_TYPE_READ);
   }
 }
 
+void Transaction::RecordScan(const oid_t &tile_group_id,
+                             const oid_t &begin_tuple_id,
+                             const oid_t &end_tuple_id) {
+  rw_set_->InsertScan(tile_group_id, begin_tuple_id, end_tuple_id);
+}
+
 void Transaction::RecordUpdate(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RW_TYPE_READ) {
-      type = RW_TYPE_UPDATE;
+  auto type = rw_set_->Find(location);
+
+  if (type != nullptr) {
+    if (*type == RW_TYPE_READ) {
+      *type = RW_TYPE_UPDATE;
       // record write.
       is_written_ = true;
       return;
     }
-    if (type == RW_TYPE_UPDATE) {
+    if (*type == RW_TYPE_UPDATE) {
       return;
     }
-    if (type == RW_TYPE_INSERT) {
+    if (*type == RW_TYPE_INSERT) {
       return;
     }
-    if (type == RW_TYPE_DELETE) {
+    if (*type == RW_TYPE_DELETE) {
       PL_ASSERT(false);
       return;
     }
     PL_ASSERT(false);
+  } else {
+    // the version was read through a scan range.
+    rw_set_->Insert(location, RW_TYPE_UPDATE);
+    is_written_ = true;
   }
 }
 
 void Transaction::RecordInsert(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
+  auto type = rw_set_->Find(location);
 
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    // RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
+  if (type != nullptr) {
     PL_ASSERT(false);
   } else {
-    rw_set_[tile_group_id][tuple_id] = RW_TYPE_INSERT;
+    rw_set_->Insert(location, RW_TYPE_INSERT);
     ++insert_count_;
   }
 }
 
 bool Transaction::RecordDelete(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RW_TYPE_READ) {
-      type = RW_TYPE_DELETE;
+  auto type = rw_set_->Find(location);
+
+  if (type != nullptr) {
+    if (*type == RW_TYPE_READ) {
+      *type = RW_TYPE_DELETE;
       // record write.
       is_written_ = true;
       return false;
     }
-    if (type == RW_TYPE_UPDATE) {
-      type = RW_TYPE_DELETE;
+    if (*type == RW_TYPE_UPDATE) {
+      *type = RW_TYPE_DELETE;
       return false;
     }
-    if (type == RW_TYPE_INSERT) {
-      type = RW_TYPE_INS_DEL;
+    if (*type == RW_TYPE_INSERT) {
+      *type = RW_TYPE_INS_DEL;
       --insert_count_;
       return true;
     }
-    if (type == RW_TYPE_DELETE) {
+    if (*type == RW_TYPE_DELETE) {
       PL_ASSERT(false);
       return false;
     }
     PL_ASSERT(false);
   } else {
-    PL_ASSERT(false);
+    // the version was read through a scan range.
+    rw_set_->Insert(location, RW_TYPE_DELETE);
+    is_written_ = true;
   }
   return false;
 }
 
-const std::map<oid_t, std::map<oid_t, RWType>> &Transaction::GetRWSet() {
-  return rw_set_;
+const ReadWriteSet &Transaction::GetRWSet() { return *rw_set_; }
+
+storage::RollbackSegmentPool *Transaction::GetRollbackSegmentPool() {
+  if (rb_seg_pool_ == nullptr) {
+    rb_seg_pool_.reset(new storage::RollbackSegmentPool(BACKEND_TYPE_MM));
+  }
+  return rb_seg_pool_.get();
 }
 
 const std::string Transaction::GetInfo() const {
@@ -20,9 +20,56 @@ namespace concurrency {
 // Current transaction for the backend thread
 thread_local Transaction *current_txn;
 
+// Transaction ids [next_txn_id, end_txn_id) leased by the backend thread
+struct TxnIdLease {
+  TransactionManager *txn_manager;
+  size_t generation;
+  txn_id_t next_txn_id;
+  txn_id_t end_txn_id;
+};
+
+static thread_local TxnIdLease txn_id_lease = {nullptr, 0, 0, 0};
+
+txn_id_t TransactionManager::GetNextTransactionId() {
+  auto generation = txn_id_generation_.load();
+  if (txn_id_lease.txn_manager != this ||
+      txn_id_lease.generation != generation ||
+      txn_id_lease.next_txn_id == txn_id_lease.end_txn_id) {
+    txn_id_lease.txn_manager = this;
+    txn_id_lease.generation = generation;
+    txn_id_lease.next_txn_id = next_txn_id_.fetch_add(TXN_ID_LEASE_SIZE);
+    txn_id_lease.end_txn_id = txn_id_lease.next_txn_id + TXN_ID_LEASE_SIZE;
+  }
+
+  return txn_id_lease.next_txn_id++;
+}
+
+void TransactionManager::IsVisibleBatch(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &begin_tuple_id, const oid_t &end_tuple_id,
+    std::vector<oid_t> &visible_tuple_ids) {
+  for (oid_t tuple_id = begin_tuple_id; tuple_id < end_tuple_id; tuple_id++) {
+    if (IsVisible(tile_group_header, tuple_id)) {
+      visible_tuple_ids.push_back(tuple_id);
+    }
+  }
+}
+
+bool TransactionManager::PerformScan(const oid_t &tile_group_id,
+                                     const std::vector<oid_t> &tuple_ids,
+                                     const bool owned UNUSED_ATTRIBUTE) {
+  for (auto tuple_id : tuple_ids) {
+    if (PerformRead(ItemPointer(tile_group_id, tuple_id)) == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool TransactionManager::IsOccupied(const ItemPointer &position) {
-  auto tile_group_header =
-      catalog::Manager::GetInstance().GetTileGroup(position.block)->GetHeader();
+  auto tile_group_header = catalog::Manager::GetInstance()
+                               .GetTileGroupUnsafe(position.block)
+                               ->GetHeader();
   auto tuple_id = position.offset;
 
   txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
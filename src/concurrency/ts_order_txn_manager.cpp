@@ -14,16 +14,30 @@
 #include "concurrency/ts_order_txn_manager.h"
 
 #include "common/platform.h"
+#include "concurrency/backoff.h"
 #include "logging/log_manager.h"
 #include "logging/records/transaction_record.h"
 #include "concurrency/transaction.h"
 #include "catalog/manager.h"
 #include "common/exception.h"
 #include "common/logger.h"
+#include "expression/container_tuple.h"
+#include "storage/data_table.h"
+#include "storage/tuple.h"
+
+#include <algorithm>
+#include <chrono>
+
+// Longest time (in us) a writer waits for the owner of a version, 0 to fail
+// at once, or -1 for the default of the concurrency control protocol
+extern int peloton_ownership_wait_us;
 
 namespace peloton {
 namespace concurrency {
 
+// Largest slot range per scanned tuple that is recorded as one range
+#define SCAN_RANGE_MAX_SLOTS_PER_TUPLE 4
+
 TsOrderTxnManager &TsOrderTxnManager::GetInstance() {
   static TsOrderTxnManager txn_manager;
   return txn_manager;
@@ -84,6 +98,183 @@ bool TsOrderTxnManager::IsVisible(
   }
 }
 
+// same rules as IsVisible, written without branches so that the column
+// layout loop below can be vectorized by the compiler.
+static inline bool IsVisibleEntry(const txn_id_t &txn_id,
+                                  const cid_t &txn_begin_cid,
+                                  const cid_t &dirty_begin_cid,
+                                  const cid_t &dirty_end_cid,
+                                  const txn_id_t &tuple_txn_id,
+                                  const cid_t &tuple_begin_cid,
+                                  const cid_t &tuple_end_cid) {
+  bool own = (tuple_txn_id == txn_id);
+
+  // only the newly inserted or updated version is visible to its owner.
+  bool own_visible =
+      (tuple_begin_cid == MAX_CID) & (tuple_end_cid != INVALID_CID);
+
+  // uncommitted versions of other txns are never visible.
+  bool other_visible = ((tuple_txn_id == INITIAL_TXN_ID) |
+                        (tuple_begin_cid != MAX_CID)) &
+                       (txn_begin_cid >= tuple_begin_cid) &
+                       (txn_begin_cid < tuple_end_cid);
+
+  bool available = (tuple_txn_id != INVALID_TXN_ID) &
+                   !((tuple_begin_cid > dirty_begin_cid) &
+                     (tuple_begin_cid <= dirty_end_cid));
+
+  return ((own & own_visible) | (!own & other_visible)) & available;
+}
+
+// the transaction state is loaded once and the header fields are read in a
+// tight loop without a virtual call per tuple.
+void TsOrderTxnManager::IsVisibleBatch(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &begin_tuple_id, const oid_t &end_tuple_id,
+    std::vector<oid_t> &visible_tuple_ids) {
+  const txn_id_t txn_id = current_txn->GetTransactionId();
+  const cid_t txn_begin_cid = current_txn->GetBeginCommitId();
+  const cid_t dirty_begin_cid = dirty_range_.first;
+  const cid_t dirty_end_cid = dirty_range_.second;
+
+  if (begin_tuple_id >= end_tuple_id) {
+    return;
+  }
+
+  if (tile_group_header->GetHeaderLayout() == LAYOUT_TYPE_COLUMN) {
+    // stream the dense txn id and commit id arrays, and append every slot
+    // to the selection vector while only advancing past the visible ones.
+    const txn_id_t *tuple_txn_ids = tile_group_header->GetTransactionIdColumn();
+    const cid_t *tuple_begin_cids = tile_group_header->GetBeginCommitIdColumn();
+    const cid_t *tuple_end_cids = tile_group_header->GetEndCommitIdColumn();
+
+    size_t visible_count = visible_tuple_ids.size();
+    visible_tuple_ids.resize(visible_count + end_tuple_id - begin_tuple_id);
+    oid_t *visible_tuple_id_ptr = visible_tuple_ids.data();
+
+    for (oid_t tuple_id = begin_tuple_id; tuple_id < end_tuple_id; tuple_id++) {
+      visible_tuple_id_ptr[visible_count] = tuple_id;
+      visible_count += IsVisibleEntry(
+          txn_id, txn_begin_cid, dirty_begin_cid, dirty_end_cid,
+          tuple_txn_ids[tuple_id], tuple_begin_cids[tuple_id],
+          tuple_end_cids[tuple_id]);
+    }
+
+    visible_tuple_ids.resize(visible_count);
+    return;
+  }
+
+  for (oid_t tuple_id = begin_tuple_id; tuple_id < end_tuple_id; tuple_id++) {
+    if (IsVisibleEntry(txn_id, txn_begin_cid, dirty_begin_cid, dirty_end_cid,
+                       tile_group_header->GetTransactionId(tuple_id),
+                       tile_group_header->GetBeginCommitId(tuple_id),
+                       tile_group_header->GetEndCommitId(tuple_id))) {
+      visible_tuple_ids.push_back(tuple_id);
+    }
+  }
+}
+
+// an update in place keeps the before-images of the tuple on a chain of
+// rollback segments, newest to oldest. the version visible to the
+// transaction is the tuple with the segments applied up to the first one that
+// began before the transaction. the tuple is copied again if it changed in
+// the meantime.
+bool TsOrderTxnManager::ReadVersion(storage::TileGroup *tile_group,
+                                    const oid_t &tuple_id,
+                                    storage::Tuple *tuple, VarlenPool *pool) {
+  auto tile_group_header = tile_group->GetHeader();
+  const cid_t txn_begin_cid = current_txn->GetBeginCommitId();
+
+  while (true) {
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    cid_t tuple_begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
+    char *tuple_rb_seg = GetRollbackSegment(tile_group_header, tuple_id);
+    bool visible = IsVisible(tile_group_header, tuple_id);
+
+    // older versions are only kept by updates in place of other
+    // transactions after the transaction began.
+    if (visible == false &&
+        (tuple_rb_seg == nullptr || tuple_txn_id == INVALID_TXN_ID ||
+         tuple_txn_id == current_txn->GetTransactionId() ||
+         tuple_begin_cid <= txn_begin_cid)) {
+      return false;
+    }
+
+    if (CopyVersion(tile_group, tuple_id, tuple_txn_id, tuple_begin_cid,
+                    tuple_rb_seg, txn_begin_cid, visible, tuple, pool)) {
+      if (visible == true) {
+        // the tuple must still be this version when the transaction commits.
+        PerformRead(ItemPointer(tile_group->GetTileGroupId(), tuple_id));
+      }
+      return visible;
+    }
+  }
+}
+
+// same as ReadVersion, with the visibility of a version decided by the
+// commit ids alone. uncommitted versions begin at MAX_CID.
+bool TsOrderTxnManager::ReadCommittedVersion(storage::TileGroup *tile_group,
+                                             const oid_t &tuple_id,
+                                             const cid_t &read_cid,
+                                             storage::Tuple *tuple,
+                                             VarlenPool *pool) {
+  auto tile_group_header = tile_group->GetHeader();
+
+  while (true) {
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    cid_t tuple_begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
+    cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+    char *tuple_rb_seg = GetRollbackSegment(tile_group_header, tuple_id);
+    bool visible = (tuple_begin_cid <= read_cid);
+
+    // the tuple slot is empty, or the version ended before the read cid.
+    if (tuple_txn_id == INVALID_TXN_ID || tuple_end_cid <= read_cid) {
+      return false;
+    }
+
+    // older versions are only kept by updates in place after the read cid.
+    if (visible == false && tuple_rb_seg == nullptr) {
+      return false;
+    }
+
+    if (CopyVersion(tile_group, tuple_id, tuple_txn_id, tuple_begin_cid,
+                    tuple_rb_seg, read_cid, visible, tuple, pool)) {
+      return visible;
+    }
+  }
+}
+
+// a writer that overwrites the tuple in place first puts the before-image
+// on the chain, so the copy is consistent if the chain and the header did
+// not change meanwhile.
+bool TsOrderTxnManager::CopyVersion(storage::TileGroup *tile_group,
+                                    const oid_t &tuple_id,
+                                    const txn_id_t &tuple_txn_id,
+                                    const cid_t &tuple_begin_cid,
+                                    char *tuple_rb_seg, const cid_t &read_cid,
+                                    bool &visible, storage::Tuple *tuple,
+                                    VarlenPool *pool) {
+  auto tile_group_header = tile_group->GetHeader();
+  auto schema = tile_group->GetAbstractTable()->GetSchema();
+
+  COMPILER_MEMORY_FENCE;
+
+  for (oid_t col_id = 0; col_id < schema->GetColumnCount(); col_id++) {
+    tuple->SetValue(col_id, tile_group->GetValue(tuple_id, col_id), pool);
+  }
+  for (char *rb_seg = tuple_rb_seg; visible == false && rb_seg != nullptr;
+       rb_seg = storage::RollbackSegmentPool::GetNextPtr(rb_seg)) {
+    storage::RollbackSegmentPool::ApplyToTuple(rb_seg, schema, tuple, pool);
+    visible = (storage::RollbackSegmentPool::GetTimeStamp(rb_seg) <= read_cid);
+  }
+
+  COMPILER_MEMORY_FENCE;
+
+  return tile_group_header->GetTransactionId(tuple_id) == tuple_txn_id &&
+         tile_group_header->GetBeginCommitId(tuple_id) == tuple_begin_cid &&
+         GetRollbackSegment(tile_group_header, tuple_id) == tuple_rb_seg;
+}
+
 // check whether the current transaction owns the tuple.
 // this function is called by update/delete executors.
 bool TsOrderTxnManager::IsOwner(
@@ -102,17 +293,48 @@ bool TsOrderTxnManager::IsOwnable(
     const oid_t &tuple_id) {
   auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
   auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+  // a writer that waits for owners may still get an owned version.
+  if (GetOwnershipWait() > 0) {
+    return tuple_txn_id != INVALID_TXN_ID && tuple_end_cid == MAX_CID;
+  }
   return tuple_txn_id == INITIAL_TXN_ID && tuple_end_cid == MAX_CID;
 }
 
+// a version created by the transaction has no begin commit id and keeps no
+// before-image of its own.
+bool TsOrderTxnManager::IsUpdatedInPlace(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  return IsOwner(tile_group_header, tuple_id) == true &&
+         tile_group_header->GetBeginCommitId(tuple_id) == MAX_CID &&
+         tile_group_header->GetPrevItemPointer(tuple_id).IsNull() == true &&
+         GetRollbackSegment(tile_group_header, tuple_id) != nullptr;
+}
+
+// writers do not wait for owners unless a wait is configured.
+int TsOrderTxnManager::GetOwnershipWait() {
+  return std::max(peloton_ownership_wait_us, 0);
+}
+
 // get write lock on a tuple.
 // this is invoked by update/delete executors.
 bool TsOrderTxnManager::AcquireOwnership(
     const storage::TileGroupHeader *const tile_group_header,
-    const oid_t &tile_group_id UNUSED_ATTRIBUTE, const oid_t &tuple_id) {
-  auto txn_id = current_txn->GetTransactionId();
+    const oid_t &tile_group_id, const oid_t &tuple_id) {
+  // snapshot reads do not write.
+  if (current_txn->IsSnapshotRead() == true) {
+    LOG_TRACE("Fail to acquire tuple. Snapshot read.");
+    SetTransactionResult(Result::RESULT_FAILURE);
+    return false;
+  }
+
+  // counted before the slot is owned, so that a scan validating the tile
+  // group after this point does not miss the owner.
+  tile_group_header->IncreaseOwnerCount();
 
-  if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
+  if (AcquireVersion(tile_group_header, tile_group_id, tuple_id,
+                     GetOwnershipWait(), true) == false) {
+    tile_group_header->DecreaseOwnerCount();
     LOG_TRACE("Fail to acquire tuple. Set txn failure.");
     SetTransactionResult(Result::RESULT_FAILURE);
     return false;
@@ -120,17 +342,177 @@ bool TsOrderTxnManager::AcquireOwnership(
   return true;
 }
 
+bool TsOrderTxnManager::AcquireVersion(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tile_group_id, const oid_t &tuple_id, const uint64_t wait_us,
+    const bool wait_die) {
+  auto txn_id = current_txn->GetTransactionId();
+  auto &manager = catalog::Manager::GetInstance();
+
+  std::unique_ptr<Backoff> backoff;
+  std::chrono::steady_clock::time_point deadline;
+  bool acquired = false;
+
+  while (true) {
+    if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == true) {
+      // owners set the end commit id, or the begin commit id of an update in
+      // place, before they release the version.
+      if (tile_group_header->GetEndCommitId(tuple_id) == MAX_CID &&
+          tile_group_header->GetBeginCommitId(tuple_id) <=
+              current_txn->GetBeginCommitId()) {
+        acquired = true;
+        break;
+      }
+      // the previous owner committed a newer version.
+      manager.GetTileGroupUnsafe(tile_group_id)
+          ->GetHeader()
+          ->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+      break;
+    }
+
+    auto owner_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    if (wait_us == 0 || owner_txn_id == INVALID_TXN_ID ||
+        tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+      break;
+    }
+    // wait-die: a transaction younger than the owner dies. Ages are given
+    // by transaction ids, which are unique, so no two transactions wait for
+    // each other. Ids are leased to threads in blocks, so an older id only
+    // approximately means an earlier start.
+    if (wait_die == true && owner_txn_id != INITIAL_TXN_ID &&
+        owner_txn_id < txn_id) {
+      break;
+    }
+
+    if (backoff == nullptr) {
+      backoff.reset(new Backoff());
+      deadline = std::chrono::steady_clock::now() +
+                 std::chrono::microseconds(wait_us);
+    } else if (std::chrono::steady_clock::now() > deadline) {
+      break;
+    }
+    backoff->Wait();
+  }
+
+  if (backoff != nullptr) {
+    auto table = static_cast<storage::DataTable *>(
+        manager.GetTileGroupUnsafe(tile_group_id)->GetAbstractTable());
+    if (table != nullptr) {
+      table->IncreaseOwnershipWaitCount();
+    }
+  }
+
+  return acquired;
+}
+
 bool TsOrderTxnManager::PerformRead(const ItemPointer &location) {
+  // the snapshot is consistent without validating the read.
+  if (current_txn->IsSnapshotRead() == true) {
+    return true;
+  }
+
   current_txn->RecordRead(location);
   return true;
 }
 
+// a range is validated slot by slot when its tile group was written, so
+// tuples that are sparse in their tile group are still read one by one.
+bool TsOrderTxnManager::PerformScan(const oid_t &tile_group_id,
+                                    const std::vector<oid_t> &tuple_ids,
+                                    const bool owned) {
+  if (current_txn->IsSnapshotRead() == true) {
+    return true;
+  }
+
+  // a writer that owned a version while it was scanned may end it with a
+  // commit id up to the begin commit id, which the range validation does
+  // not detect. such tile groups are read tuple by tuple. a writer that
+  // owns a version only after the scan sampled the tile group takes a
+  // larger commit id.
+  if (tuple_ids.size() < 2 || owned == true) {
+    return TransactionManager::PerformScan(tile_group_id, tuple_ids, owned);
+  }
+
+  auto bounds = std::minmax_element(tuple_ids.begin(), tuple_ids.end());
+  oid_t begin_tuple_id = *bounds.first;
+  oid_t end_tuple_id = *bounds.second + 1;
+
+  if (end_tuple_id - begin_tuple_id >
+      tuple_ids.size() * SCAN_RANGE_MAX_SLOTS_PER_TUPLE) {
+    return TransactionManager::PerformScan(tile_group_id, tuple_ids, owned);
+  }
+
+  current_txn->RecordScan(tile_group_id, begin_tuple_id, end_tuple_id);
+  return true;
+}
+
+// a scan read the versions of its range that were visible at the begin
+// commit id. the read is still valid at commit_id unless one of them was
+// ended before commit_id or is owned by another transaction. no version of
+// the tile group was owned when the scan checked visibility, so a version
+// ended up to the begin commit id was not visible to it.
+bool TsOrderTxnManager::ValidateScan(const ScanSetEntry &scan,
+                                     const cid_t &commit_id) {
+  auto tile_group_header = catalog::Manager::GetInstance()
+                               .GetTileGroupUnsafe(scan.tile_group_id)
+                               ->GetHeader();
+  const cid_t txn_begin_cid = current_txn->GetBeginCommitId();
+
+  // no version of the tile group is owned or was ended after the scan.
+  // owners release the slot after setting the last end commit id.
+  if (tile_group_header->GetOwnerCount() == 0 &&
+      tile_group_header->GetLastEndCommitId() <= txn_begin_cid) {
+    return true;
+  }
+
+  const txn_id_t txn_id = current_txn->GetTransactionId();
+  for (oid_t tuple_id = scan.begin_tuple_id; tuple_id < scan.end_tuple_id;
+       tuple_id++) {
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    if (tuple_txn_id == txn_id || tuple_txn_id == INVALID_TXN_ID) {
+      continue;
+    }
+
+    cid_t tuple_begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
+    cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+    if (tuple_begin_cid > txn_begin_cid) {
+      // the scan read a before-image of a version updated in place.
+      if (IsOverwrittenInPlace(tile_group_header, tuple_id, txn_begin_cid)) {
+        LOG_TRACE("scan of tile group %u fails at tuple %u", scan.tile_group_id,
+                  tuple_id);
+        return false;
+      }
+      // the version was not visible to the scan.
+      continue;
+    }
+    if (tuple_end_cid <= txn_begin_cid) {
+      // the version was not visible to the scan.
+      continue;
+    }
+
+    if (tuple_txn_id == INITIAL_TXN_ID && tuple_end_cid >= commit_id) {
+      // the version is not owned by other txns and is still visible.
+      continue;
+    }
+
+    LOG_TRACE("scan of tile group %u fails at tuple %u", scan.tile_group_id,
+              tuple_id);
+    return false;
+  }
+  return true;
+}
+
 bool TsOrderTxnManager::PerformInsert(const ItemPointer &location) {
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
 
+  // snapshot reads do not write.
+  if (current_txn->IsSnapshotRead() == true) {
+    return false;
+  }
+
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupUnsafe(tile_group_id)->GetHeader();
   auto transaction_id = current_txn->GetTransactionId();
 
   // Set MVCC info
@@ -139,6 +521,11 @@ bool TsOrderTxnManager::PerformInsert(const ItemPointer &location) {
   //  PL_ASSERT(tile_group_header->GetBeginCommitId(tuple_id) == MAX_CID);
   //  PL_ASSERT(tile_group_header->GetEndCommitId(tuple_id) == MAX_CID);
 
+  // a recycled slot may still point to the before-images of its last tuple.
+  SetRollbackSegment(tile_group_header, tuple_id, nullptr);
+
+  COMPILER_MEMORY_FENCE;
+
   tile_group_header->SetTransactionId(tuple_id, transaction_id);
 
   // no need to set next item pointer.
@@ -157,12 +544,20 @@ void TsOrderTxnManager::PerformUpdate(const ItemPointer &old_location,
   auto transaction_id = current_txn->GetTransactionId();
 
   auto tile_group_header = catalog::Manager::GetInstance()
-                               .GetTileGroup(old_location.block)
+                               .GetTileGroupUnsafe(old_location.block)
                                ->GetHeader();
   auto new_tile_group_header = catalog::Manager::GetInstance()
-                                   .GetTileGroup(new_location.block)
+                                   .GetTileGroupUnsafe(new_location.block)
                                    ->GetHeader();
 
+  // a version updated in place by the transaction gets its committed image
+  // back, the new version holds the update.
+  if (IsUpdatedInPlace(tile_group_header, old_location.offset) == true) {
+    UndoInplaceUpdate(catalog::Manager::GetInstance().GetTileGroupUnsafe(
+                          old_location.block),
+                      old_location.offset);
+  }
+
   // if we can perform update, then we must have already locked the older
   // version.
   //  PL_ASSERT(tile_group_header->GetTransactionId(old_location.offset) ==
@@ -177,6 +572,9 @@ void TsOrderTxnManager::PerformUpdate(const ItemPointer &old_location,
   // Set double linked list
   tile_group_header->SetNextItemPointer(old_location.offset, new_location);
   new_tile_group_header->SetPrevItemPointer(new_location.offset, old_location);
+  SetRollbackSegment(new_tile_group_header, new_location.offset, nullptr);
+
+  COMPILER_MEMORY_FENCE;
 
   new_tile_group_header->SetTransactionId(new_location.offset, transaction_id);
 
@@ -191,7 +589,7 @@ void TsOrderTxnManager::PerformUpdate(const ItemPointer &location) {
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupUnsafe(tile_group_id)->GetHeader();
 
   //  PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
   //         current_txn->GetTransactionId());
@@ -210,10 +608,10 @@ void TsOrderTxnManager::PerformDelete(const ItemPointer &old_location,
   auto transaction_id = current_txn->GetTransactionId();
 
   auto tile_group_header = catalog::Manager::GetInstance()
-                               .GetTileGroup(old_location.block)
+                               .GetTileGroupUnsafe(old_location.block)
                                ->GetHeader();
   auto new_tile_group_header = catalog::Manager::GetInstance()
-                                   .GetTileGroup(new_location.block)
+                                   .GetTileGroupUnsafe(new_location.block)
                                    ->GetHeader();
 
   // if we can perform update, then we must have already locked the older
@@ -227,9 +625,18 @@ void TsOrderTxnManager::PerformDelete(const ItemPointer &old_location,
   PL_ASSERT(new_tile_group_header->GetEndCommitId(new_location.offset) ==
             MAX_CID);
 
+  if (IsUpdatedInPlace(tile_group_header, old_location.offset) == true) {
+    UndoInplaceUpdate(catalog::Manager::GetInstance().GetTileGroupUnsafe(
+                          old_location.block),
+                      old_location.offset);
+  }
+
   // Set up double linked list
   tile_group_header->SetNextItemPointer(old_location.offset, new_location);
   new_tile_group_header->SetPrevItemPointer(new_location.offset, old_location);
+  SetRollbackSegment(new_tile_group_header, new_location.offset, nullptr);
+
+  COMPILER_MEMORY_FENCE;
 
   new_tile_group_header->SetTransactionId(new_location.offset, transaction_id);
   new_tile_group_header->SetEndCommitId(new_location.offset, INVALID_CID);
@@ -243,7 +650,15 @@ void TsOrderTxnManager::PerformDelete(const ItemPointer &location) {
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupUnsafe(tile_group_id)->GetHeader();
+
+  // the committed version is restored and stays visible to other txns until
+  // the commit ends it.
+  if (IsUpdatedInPlace(tile_group_header, tuple_id) == true) {
+    UndoInplaceUpdate(manager.GetTileGroupUnsafe(tile_group_id), tuple_id);
+    current_txn->RecordDelete(location);
+    return;
+  }
 
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
             current_txn->GetTransactionId());
@@ -262,6 +677,108 @@ void TsOrderTxnManager::PerformDelete(const ItemPointer &location) {
   }
 }
 
+// the before-image of the target columns is kept on a rollback segment in
+// front of the chain of the tuple. the first update in place of a committed
+// version hides it from other transactions until the commit, which only
+// read the before-images.
+void TsOrderTxnManager::PerformInplaceUpdate(const ItemPointer &location,
+                                             const TargetList &target_list) {
+  oid_t tile_group_id = location.block;
+  oid_t tuple_id = location.offset;
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroupUnsafe(tile_group_id);
+  auto tile_group_header = tile_group->GetHeader();
+
+  // the version was created by the transaction.
+  auto old_location = tile_group_header->GetPrevItemPointer(tuple_id);
+  if (old_location.IsNull() == false) {
+    current_txn->RecordUpdate(old_location);
+    return;
+  }
+
+  cid_t tuple_begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
+  char *next_rb_seg = GetRollbackSegment(tile_group_header, tuple_id);
+  if (tuple_begin_cid == MAX_CID && next_rb_seg == nullptr) {
+    // the version is newly inserted.
+    return;
+  }
+
+  expression::ContainerTuple<storage::TileGroup> tuple(tile_group, tuple_id);
+  auto rb_seg = current_txn->GetRollbackSegmentPool()->CreateSegmentFromTuple(
+      tile_group->GetAbstractTable()->GetSchema(), target_list, &tuple);
+  storage::RollbackSegmentPool::SetTimeStamp(rb_seg, tuple_begin_cid);
+  storage::RollbackSegmentPool::SetNextPtr(rb_seg, next_rb_seg);
+
+  SetRollbackSegment(tile_group_header, tuple_id, rb_seg);
+
+  COMPILER_MEMORY_FENCE;
+
+  if (tuple_begin_cid != MAX_CID) {
+    tile_group_header->SetBeginCommitId(tuple_id, MAX_CID);
+    current_txn->RecordUpdate(location);
+  }
+}
+
+// the segments of the transaction are the newest ones on the chain. the
+// first of them holds the committed version.
+void TsOrderTxnManager::UndoInplaceUpdate(storage::TileGroup *tile_group,
+                                          const oid_t &tuple_id) {
+  auto tile_group_header = tile_group->GetHeader();
+
+  char *rb_seg = GetRollbackSegment(tile_group_header, tuple_id);
+  while (rb_seg != nullptr) {
+    tile_group->ApplyRollbackSegment(rb_seg, tuple_id);
+    cid_t rb_seg_begin_cid = storage::RollbackSegmentPool::GetTimeStamp(rb_seg);
+    if (rb_seg_begin_cid != MAX_CID) {
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetBeginCommitId(tuple_id, rb_seg_begin_cid);
+      tile_group_header->SetEndCommitId(tuple_id, MAX_CID);
+      SetRollbackSegment(tile_group_header, tuple_id,
+                         storage::RollbackSegmentPool::GetNextPtr(rb_seg));
+      return;
+    }
+    rb_seg = storage::RollbackSegmentPool::GetNextPtr(rb_seg);
+  }
+  PL_ASSERT(false);
+}
+
+// segments are newest to oldest, so the walk stops before the segments of
+// pools that may have been freed.
+bool TsOrderTxnManager::IsOverwrittenInPlace(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id, const cid_t &begin_cid) {
+  for (char *rb_seg = GetRollbackSegment(tile_group_header, tuple_id);
+       rb_seg != nullptr;
+       rb_seg = storage::RollbackSegmentPool::GetNextPtr(rb_seg)) {
+    if (storage::RollbackSegmentPool::GetTimeStamp(rb_seg) <= begin_cid) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// a pool is retired with the current commit id. every transaction that began
+// before it is dead once the max committed id reaches it.
+void TsOrderTxnManager::RetireRollbackSegmentPool(
+    std::unique_ptr<storage::RollbackSegmentPool> rb_seg_pool) {
+  rb_seg_pool->MarkedAsGarbage();
+  rb_seg_pool->SetPoolTimestamp(GetCurrentCommitId());
+
+  std::vector<std::unique_ptr<storage::RollbackSegmentPool>> freed_pools;
+  cid_t max_committed_cid = GetMaxCommittedCid();
+  retired_pools_lock_.Lock();
+  retired_pools_.push_back(std::move(rb_seg_pool));
+  while (retired_pools_.empty() == false &&
+         retired_pools_.front()->GetPoolTimestamp() <= max_committed_cid) {
+    freed_pools.push_back(std::move(retired_pools_.front()));
+    retired_pools_.pop_front();
+  }
+  retired_pools_lock_.Unlock();
+  // the pools are freed outside the lock.
+}
+
 Result TsOrderTxnManager::CommitTransaction() {
   LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
 
@@ -269,36 +786,60 @@ Result TsOrderTxnManager::CommitTransaction() {
 
   auto &rw_set = current_txn->GetRWSet();
 
+  //*****************************************************
+  // snapshot reads recorded nothing to validate.
+  if (current_txn->IsSnapshotRead() == true) {
+    PL_ASSERT(rw_set.IsEmpty() == true);
+    Result ret = current_txn->GetResult();
+    // nothing to make durable
+    auto &callback = current_txn->GetCommitCallback();
+    if (ret == Result::RESULT_SUCCESS && callback) {
+      callback(current_txn->GetBeginCommitId());
+    }
+    EndTransaction();
+    return ret;
+  }
+
   //*****************************************************
   // we can optimize read-only transaction.
   if (current_txn->IsReadOnly() == true) {
-    // validate read set.
-    for (auto &tile_group_entry : rw_set) {
-      oid_t tile_group_id = tile_group_entry.first;
-      auto tile_group = manager.GetTileGroup(tile_group_id);
-      auto tile_group_header = tile_group->GetHeader();
-      for (auto &tuple_entry : tile_group_entry.second) {
-        auto tuple_slot = tuple_entry.first;
-        // if this tuple is not newly inserted.
-        if (tuple_entry.second == RW_TYPE_READ) {
-          if (tile_group_header->GetTransactionId(tuple_slot) ==
-                  INITIAL_TXN_ID &&
-              tile_group_header->GetBeginCommitId(tuple_slot) <=
-                  current_txn->GetBeginCommitId() &&
-              tile_group_header->GetEndCommitId(tuple_slot) >=
-                  current_txn->GetBeginCommitId()) {
-            // the version is not owned by other txns and is still visible.
-            continue;
-          }
-          // otherwise, validation fails. abort transaction.
-          return AbortTransaction();
-        } else {
-          PL_ASSERT(tuple_entry.second == RW_TYPE_INS_DEL);
+    // validate read set. a version ended by a commit at the begin commit id
+    // was not visible to the transaction.
+    for (auto &rw_entry : rw_set) {
+      oid_t tile_group_id = rw_entry.location.block;
+      oid_t tuple_slot = rw_entry.location.offset;
+      auto tile_group_header =
+          manager.GetTileGroupUnsafe(tile_group_id)->GetHeader();
+      // if this tuple is not newly inserted.
+      if (rw_entry.type == RW_TYPE_READ) {
+        if (tile_group_header->GetTransactionId(tuple_slot) ==
+                INITIAL_TXN_ID &&
+            tile_group_header->GetBeginCommitId(tuple_slot) <=
+                current_txn->GetBeginCommitId() &&
+            tile_group_header->GetEndCommitId(tuple_slot) >
+                current_txn->GetBeginCommitId()) {
+          // the version is not owned by other txns and is still visible.
+          continue;
         }
+        // otherwise, validation fails. abort transaction.
+        return AbortTransaction();
+      } else {
+        PL_ASSERT(rw_entry.type == RW_TYPE_INS_DEL);
+      }
+    }
+    // validate scan set.
+    for (auto &scan : rw_set.GetScans()) {
+      if (ValidateScan(scan, current_txn->GetBeginCommitId() + 1) == false) {
+        return AbortTransaction();
       }
     }
     // is it always true???
     Result ret = current_txn->GetResult();
+    // nothing to make durable
+    auto &callback = current_txn->GetCommitCallback();
+    if (ret == Result::RESULT_SUCCESS && callback) {
+      callback(current_txn->GetBeginCommitId());
+    }
     EndTransaction();
     return ret;
   }
@@ -306,141 +847,184 @@ Result TsOrderTxnManager::CommitTransaction() {
   // must tell the log manager we are going to log
   auto &log_manager = logging::LogManager::GetInstance();
   log_manager.PrepareLogging();
-  // generate transaction id.
+  // generate transaction id. snapshot reads that begin at or after it wait
+  // until its writes are installed.
+  auto &epoch_manager = EpochManagerFactory::GetInstance();
+  epoch_manager.EnterCommit(current_txn->GetEpochId());
   cid_t end_commit_id = GetNextCommitId();
+  epoch_manager.SetCommitCid(current_txn->GetEpochId(), end_commit_id);
   current_txn->SetEndCommitId(end_commit_id);
 
   // validate read set.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      // if this tuple is not newly inserted.
-      if (tuple_entry.second != RW_TYPE_INSERT &&
-          tuple_entry.second != RW_TYPE_INS_DEL) {
-        // if this tuple is owned by this txn, then it is safe.
+  for (auto &rw_entry : rw_set) {
+    oid_t tile_group_id = rw_entry.location.block;
+    oid_t tuple_slot = rw_entry.location.offset;
+    auto tile_group_header =
+        manager.GetTileGroupUnsafe(tile_group_id)->GetHeader();
+    // if this tuple is not newly inserted.
+    if (rw_entry.type != RW_TYPE_INSERT && rw_entry.type != RW_TYPE_INS_DEL) {
+      // if this tuple is owned by this txn, then it is safe.
+      if (tile_group_header->GetTransactionId(tuple_slot) ==
+          current_txn->GetTransactionId()) {
+        // the version is owned by the transaction.
+        continue;
+      } else {
+        // an update in place commits a newer begin commit id.
         if (tile_group_header->GetTransactionId(tuple_slot) ==
-            current_txn->GetTransactionId()) {
-          // the version is owned by the transaction.
+                INITIAL_TXN_ID &&
+            tile_group_header->GetBeginCommitId(tuple_slot) <=
+                current_txn->GetBeginCommitId() &&
+            tile_group_header->GetEndCommitId(tuple_slot) >= end_commit_id) {
+          // the version is not owned by other txns and is still visible.
           continue;
-        } else {
-          if (tile_group_header->GetTransactionId(tuple_slot) ==
-                  INITIAL_TXN_ID &&
-              tile_group_header->GetBeginCommitId(tuple_slot) <=
-                  end_commit_id &&
-              tile_group_header->GetEndCommitId(tuple_slot) >= end_commit_id) {
-            // the version is not owned by other txns and is still visible.
-            continue;
-          }
         }
-        LOG_TRACE("transaction id=%lu",
-                  tile_group_header->GetTransactionId(tuple_slot));
-        LOG_TRACE("begin commit id=%lu",
-                  tile_group_header->GetBeginCommitId(tuple_slot));
-        LOG_TRACE("end commit id=%lu",
-                  tile_group_header->GetEndCommitId(tuple_slot));
-        // otherwise, validation fails. abort transaction.
-        log_manager.DoneLogging();
-        return AbortTransaction();
       }
+      LOG_TRACE("transaction id=%lu",
+                tile_group_header->GetTransactionId(tuple_slot));
+      LOG_TRACE("begin commit id=%lu",
+                tile_group_header->GetBeginCommitId(tuple_slot));
+      LOG_TRACE("end commit id=%lu",
+                tile_group_header->GetEndCommitId(tuple_slot));
+      // otherwise, validation fails. abort transaction.
+      log_manager.DoneLogging();
+      return AbortTransaction();
+    }
+  }
+  // validate scan set.
+  for (auto &scan : rw_set.GetScans()) {
+    if (ValidateScan(scan, end_commit_id) == false) {
+      log_manager.DoneLogging();
+      return AbortTransaction();
     }
   }
   //////////////////////////////////////////////////////////
 
   log_manager.LogBeginTransaction(end_commit_id);
   // install everything.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_UPDATE) {
-        // logging.
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
-        ItemPointer old_version(tile_group_id, tuple_slot);
+  for (auto &rw_entry : rw_set) {
+    oid_t tile_group_id = rw_entry.location.block;
+    oid_t tuple_slot = rw_entry.location.offset;
+    auto tile_group_header =
+        manager.GetTileGroupUnsafe(tile_group_id)->GetHeader();
+    if (rw_entry.type == RW_TYPE_UPDATE &&
+        tile_group_header->GetNextItemPointer(tuple_slot).IsNull() == true) {
+      // the version was updated in place.
+      ItemPointer location(tile_group_id, tuple_slot);
+      log_manager.LogUpdate(end_commit_id, location, location);
 
-        // logging.
-        log_manager.LogUpdate(end_commit_id, old_version, new_version);
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetLastEndCommitId(end_commit_id);
 
-        // we must guarantee that, at any time point, AT LEAST ONE version is
-        // visible.
-        // we do not change begin cid for old tuple.
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->DecreaseOwnerCount();
 
-        COMPILER_MEMORY_FENCE;
+    } else if (rw_entry.type == RW_TYPE_DELETE &&
+               tile_group_header->GetNextItemPointer(tuple_slot).IsNull() ==
+                   true) {
+      // the version was updated in place before it was deleted.
+      ItemPointer delete_location(tile_group_id, tuple_slot);
+      log_manager.LogDelete(end_commit_id, delete_location);
 
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetLastEndCommitId(end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INITIAL_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->DecreaseOwnerCount();
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
-        ItemPointer delete_location(tile_group_id, tuple_slot);
+    } else if (rw_entry.type == RW_TYPE_UPDATE) {
+      // logging.
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      ItemPointer old_version(tile_group_id, tuple_slot);
 
-        // logging.
-        log_manager.LogDelete(end_commit_id, delete_location);
+      // logging.
+      log_manager.LogUpdate(end_commit_id, old_version, new_version);
 
-        // we do not change begin cid for old tuple.
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      // we must guarantee that, at any time point, AT LEAST ONE version is
+      // visible.
+      // we do not change begin cid for old tuple.
+      auto new_tile_group_header =
+          manager.GetTileGroupUnsafe(new_version.block)->GetHeader();
 
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetLastEndCommitId(end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->DecreaseOwnerCount();
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        //TODO: PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
-        //          current_txn->GetTransactionId());
-        // set the begin commit id to persist insert
-        ItemPointer insert_location(tile_group_id, tuple_slot);
-        log_manager.LogInsert(end_commit_id, insert_location);
+    } else if (rw_entry.type == RW_TYPE_DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
+      ItemPointer delete_location(tile_group_id, tuple_slot);
 
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      // logging.
+      log_manager.LogDelete(end_commit_id, delete_location);
 
-        COMPILER_MEMORY_FENCE;
+      // we do not change begin cid for old tuple.
+      auto new_tile_group_header =
+          manager.GetTileGroupUnsafe(new_version.block)->GetHeader();
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
 
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        // TODO: PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
-        //          current_txn->GetTransactionId());
+      COMPILER_MEMORY_FENCE;
 
-        // set the begin commit id to persist insert
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetLastEndCommitId(end_commit_id);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
-      }
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->DecreaseOwnerCount();
+
+    } else if (rw_entry.type == RW_TYPE_INSERT) {
+      //TODO: PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
+      //          current_txn->GetTransactionId());
+      // set the begin commit id to persist insert
+      ItemPointer insert_location(tile_group_id, tuple_slot);
+      log_manager.LogInsert(end_commit_id, insert_location);
+
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+    } else if (rw_entry.type == RW_TYPE_INS_DEL) {
+      // TODO: PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
+      //          current_txn->GetTransactionId());
+
+      // set the begin commit id to persist insert
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
     }
   }
-  log_manager.LogCommitTransaction(end_commit_id);
+  epoch_manager.ExitCommit(current_txn->GetEpochId());
+
+  log_manager.LogCommitTransaction(end_commit_id,
+                                   current_txn->GetCommitCallback());
   EndTransaction();
 
   return Result::RESULT_SUCCESS;
@@ -452,88 +1036,106 @@ Result TsOrderTxnManager::AbortTransaction() {
 
   auto &rw_set = current_txn->GetRWSet();
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
+  for (auto &rw_entry : rw_set) {
+    oid_t tile_group_id = rw_entry.location.block;
+    oid_t tuple_slot = rw_entry.location.offset;
+    auto tile_group_header =
+        manager.GetTileGroupUnsafe(tile_group_id)->GetHeader();
+    if ((rw_entry.type == RW_TYPE_UPDATE ||
+         rw_entry.type == RW_TYPE_DELETE) &&
+        tile_group_header->GetNextItemPointer(tuple_slot).IsNull() == true) {
+      // the version was updated in place. a delete already restored it.
+      if (IsUpdatedInPlace(tile_group_header, tuple_slot) == true) {
+        UndoInplaceUpdate(manager.GetTileGroupUnsafe(tile_group_id),
+                          tuple_slot);
+      }
 
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_UPDATE) {
-        // we do not set begin cid for old tuple.
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
+      COMPILER_MEMORY_FENCE;
 
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->DecreaseOwnerCount();
 
-        COMPILER_MEMORY_FENCE;
+    } else if (rw_entry.type == RW_TYPE_UPDATE) {
+      // we do not set begin cid for old tuple.
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
 
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      auto new_tile_group_header =
+          manager.GetTileGroupUnsafe(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // reset the item pointers.
-        tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
-        new_tile_group_header->SetPrevItemPointer(new_version.offset,
-                                                  INVALID_ITEMPOINTER);
+      COMPILER_MEMORY_FENCE;
 
-        COMPILER_MEMORY_FENCE;
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      // reset the item pointers.
+      tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+      new_tile_group_header->SetPrevItemPointer(new_version.offset,
+                                                INVALID_ITEMPOINTER);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetNextItemPointer(tuple_slot);
+      COMPILER_MEMORY_FENCE;
 
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->DecreaseOwnerCount();
 
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+    } else if (rw_entry.type == RW_TYPE_DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetNextItemPointer(tuple_slot);
 
-        COMPILER_MEMORY_FENCE;
+      auto new_tile_group_header =
+          manager.GetTileGroupUnsafe(new_version.block)->GetHeader();
 
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // reset the item pointers.
-        tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
-        new_tile_group_header->SetPrevItemPointer(new_version.offset,
-                                                  INVALID_ITEMPOINTER);
+      COMPILER_MEMORY_FENCE;
 
-        COMPILER_MEMORY_FENCE;
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      // reset the item pointers.
+      tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+      new_tile_group_header->SetPrevItemPointer(new_version.offset,
+                                                INVALID_ITEMPOINTER);
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      COMPILER_MEMORY_FENCE;
 
-        COMPILER_MEMORY_FENCE;
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->DecreaseOwnerCount();
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+    } else if (rw_entry.type == RW_TYPE_INSERT) {
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
 
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      COMPILER_MEMORY_FENCE;
 
-        COMPILER_MEMORY_FENCE;
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
-      }
+    } else if (rw_entry.type == RW_TYPE_INS_DEL) {
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
     }
   }
 
+  // a transaction that failed validation took a commit id.
+  if (current_txn->GetEndCommitId() != MAX_CID) {
+    EpochManagerFactory::GetInstance().ExitCommit(current_txn->GetEpochId());
+  }
+
   EndTransaction();
   return Result::RESULT_ABORTED;
 }
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// append_only_array.cpp
+//
+// Identification: src/container/append_only_array.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "container/append_only_array.h"
+#include "common/logger.h"
+#include "common/macros.h"
+#include "common/platform.h"
+#include "common/types.h"
+
+namespace peloton {
+
+APPEND_ONLY_ARRAY_TEMPLATE_ARGUMENTS
+APPEND_ONLY_ARRAY_TYPE::AppendOnlyArray() {
+  for (std::size_t chunk_itr = 0; chunk_itr < APPEND_ONLY_ARRAY_MAX_CHUNK_COUNT;
+       chunk_itr++) {
+    chunks[chunk_itr].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+APPEND_ONLY_ARRAY_TEMPLATE_ARGUMENTS
+APPEND_ONLY_ARRAY_TYPE::~AppendOnlyArray() {
+  for (std::size_t chunk_itr = 0; chunk_itr < APPEND_ONLY_ARRAY_MAX_CHUNK_COUNT;
+       chunk_itr++) {
+    delete chunks[chunk_itr].load();
+  }
+}
+
+APPEND_ONLY_ARRAY_TEMPLATE_ARGUMENTS
+bool APPEND_ONLY_ARRAY_TYPE::Append(const ValueType &value) {
+  // Reserve an offset
+  std::size_t offset = reserved_size.load();
+  do {
+    if (offset >= APPEND_ONLY_ARRAY_MAX_SIZE) {
+      LOG_ERROR("Append only array is full : %lu", offset);
+      return false;
+    }
+  } while (!reserved_size.compare_exchange_weak(offset, offset + 1));
+
+  LOG_TRACE("Appended at %lu", offset);
+
+  // Install the chunk if we are the first one to touch it
+  auto &chunk_slot = chunks[offset / APPEND_ONLY_ARRAY_CHUNK_SIZE];
+  chunk_t *chunk = chunk_slot.load(std::memory_order_acquire);
+  if (chunk == nullptr) {
+    chunk_t *new_chunk = new chunk_t();
+    if (chunk_slot.compare_exchange_strong(chunk, new_chunk)) {
+      chunk = new_chunk;
+    } else {
+      delete new_chunk;
+    }
+  }
+
+  (*chunk)[offset % APPEND_ONLY_ARRAY_CHUNK_SIZE] = value;
+
+  // Publish in offset order so that readers never see a hole
+  std::size_t expected = offset;
+  while (!published_size.compare_exchange_weak(expected, offset + 1,
+                                               std::memory_order_release)) {
+    expected = offset;
+    _mm_pause();
+  }
+
+  return true;
+}
+
+APPEND_ONLY_ARRAY_TEMPLATE_ARGUMENTS
+ValueType APPEND_ONLY_ARRAY_TYPE::Find(const std::size_t &offset) const {
+  PL_ASSERT(offset < published_size.load());
+  LOG_TRACE("Find at %lu", offset);
+  chunk_t *chunk = chunks[offset / APPEND_ONLY_ARRAY_CHUNK_SIZE].load(
+      std::memory_order_acquire);
+  return (*chunk)[offset % APPEND_ONLY_ARRAY_CHUNK_SIZE];
+}
+
+APPEND_ONLY_ARRAY_TEMPLATE_ARGUMENTS
+size_t APPEND_ONLY_ARRAY_TYPE::GetSize() const {
+  return published_size.load(std::memory_order_acquire);
+}
+
+APPEND_ONLY_ARRAY_TEMPLATE_ARGUMENTS
+bool APPEND_ONLY_ARRAY_TYPE::IsEmpty() const { return GetSize() == 0; }
+
+APPEND_ONLY_ARRAY_TEMPLATE_ARGUMENTS
+void APPEND_ONLY_ARRAY_TYPE::Clear() {
+  // Chunks are kept around for reuse
+  published_size = 0;
+  reserved_size = 0;
+}
+
+APPEND_ONLY_ARRAY_TEMPLATE_ARGUMENTS
+bool APPEND_ONLY_ARRAY_TYPE::Contains(const ValueType &value) const {
+  auto size = GetSize();
+
+  for (std::size_t array_itr = 0; array_itr < size; array_itr++) {
+    if (Find(array_itr) == value) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Explicit template instantiation
+template class AppendOnlyArray<oid_t>;
+
+}  // End peloton namespace
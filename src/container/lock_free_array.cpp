@@ -118,6 +118,8 @@ template class LockFreeArray<std::shared_ptr<index::Index>>;
 
 template class LockFreeArray<std::shared_ptr<storage::TileGroup>>;
 
+template class LockFreeArray<storage::TileGroup *>;
+
 template class LockFreeArray<oid_t>;
 
 }  // End peloton namespace
@@ -14,16 +14,21 @@
 #include "executor/abstract_scan_executor.h"
 
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
 #include "common/types.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "expression/abstract_expression.h"
 #include "expression/container_tuple.h"
 #include "storage/data_table.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
+#include "storage/tuple.h"
 
 #include "common/logger.h"
 
@@ -57,5 +62,54 @@ bool AbstractScanExecutor::DInit() {
   return true;
 }
 
+/**
+ * @brief The versions may be rebuilt from the rollback segments of the
+ * tuples, so they are copied to a temporary tile that belongs to no tile group.
+ * Writers fail on such tiles, as the versions are not the latest ones.
+ */
+LogicalTile *AbstractScanExecutor::ReadVersions(
+    storage::TileGroup *tile_group, const std::vector<oid_t> &tuple_ids) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto schema = tile_group->GetAbstractTable()->GetSchema();
+  auto pool = executor_context_->GetExecutorContextPool();
+
+  std::vector<std::unique_ptr<storage::Tuple>> tuples;
+  for (auto tuple_id : tuple_ids) {
+    std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+    if (transaction_manager.ReadVersion(tile_group, tuple_id, tuple.get(),
+                                        pool) == false) {
+      continue;
+    }
+    if (predicate_ != nullptr &&
+        predicate_->Evaluate(tuple.get(), nullptr, executor_context_)
+            .IsFalse()) {
+      continue;
+    }
+    tuples.push_back(std::move(tuple));
+  }
+
+  if (tuples.empty()) {
+    return nullptr;
+  }
+
+  std::shared_ptr<storage::Tile> tile(
+      storage::TileFactory::GetTempTile(*schema, tuples.size()));
+  for (oid_t tuple_itr = 0; tuple_itr < tuples.size(); tuple_itr++) {
+    for (oid_t col_id = 0; col_id < schema->GetColumnCount(); col_id++) {
+      tile->SetValue(tuples[tuple_itr]->GetValue(col_id), tuple_itr, col_id);
+    }
+  }
+
+  std::vector<oid_t> tile_column_ids(schema->GetColumnCount());
+  std::iota(tile_column_ids.begin(), tile_column_ids.end(), 0);
+
+  LogicalTile *logical_tile = LogicalTileFactory::WrapTiles({tile});
+  if (column_ids_.size() != 0) {
+    logical_tile->ProjectColumns(tile_column_ids, column_ids_);
+  }
+  return logical_tile;
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -158,7 +158,7 @@ bool AggregateExecutor::DExecute() {
 
       auto &manager = catalog::Manager::GetInstance();
       auto tile_group_header =
-          manager.GetTileGroup(location.block)->GetHeader();
+          manager.GetTileGroupUnsafe(location.block)->GetHeader();
       tile_group_header->SetTransactionId(location.offset, INITIAL_TXN_ID);
 
     } else {
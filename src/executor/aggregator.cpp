@@ -139,7 +139,8 @@ bool Helper(const planner::AggregatePlan *node, Agg **aggregates,
     return false;
   } else {
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group_header = manager.GetTileGroup(location.block)->GetHeader();
+    auto tile_group_header =
+        manager.GetTileGroupUnsafe(location.block)->GetHeader();
     tile_group_header->SetTransactionId(location.offset, INITIAL_TXN_ID);
   }
 
@@ -76,12 +76,21 @@ bool DeleteExecutor::DExecute() {
   auto &pos_lists = source_tile.get()->GetPositionLists();
   storage::Tile *tile = source_tile->GetBaseTile(0);
   storage::TileGroup *tile_group = tile->GetTileGroup();
-  storage::TileGroupHeader *tile_group_header = tile_group->GetHeader();
-
-  auto tile_group_id = tile_group->GetTileGroupId();
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
+  // the child read committed versions that were updated in place by other
+  // transactions, which are not the latest versions.
+  if (tile_group == nullptr) {
+    LOG_TRACE("Fail to delete tuple. Set txn failure.");
+    target_table_->IncreaseConflictCount();
+    transaction_manager.SetTransactionResult(RESULT_FAILURE);
+    return false;
+  }
+
+  storage::TileGroupHeader *tile_group_header = tile_group->GetHeader();
+  auto tile_group_id = tile_group->GetTileGroupId();
+
   LOG_TRACE("Source tile : %p Tuples : %lu ", source_tile.get(),
             source_tile->GetTupleCount());
 
@@ -112,6 +121,7 @@ bool DeleteExecutor::DExecute() {
     	LOG_TRACE("Thread is not the owner of the tuple, but still visible");
       if (transaction_manager.AcquireOwnership(tile_group_header, tile_group_id,
                                                physical_tuple_id) == false) {
+        target_table_->IncreaseConflictCount();
         transaction_manager.SetTransactionResult(RESULT_FAILURE);
         return false;
       }
@@ -140,6 +150,7 @@ bool DeleteExecutor::DExecute() {
     } else {
       // transaction should be aborted as we cannot update the latest version.
       LOG_TRACE("Fail to update tuple. Set txn failure.");
+      target_table_->IncreaseConflictCount();
       transaction_manager.SetTransactionResult(Result::RESULT_FAILURE);
       return false;
     }
@@ -30,6 +30,37 @@ ExecutorContext::~ExecutorContext() {
   // params will be freed automatically
 }
 
+// context released on this thread
+static thread_local std::unique_ptr<ExecutorContext> cached_executor_context;
+
+ExecutorContext *ExecutorContext::Acquire(concurrency::Transaction *transaction,
+                                          const std::vector<Value> &params) {
+  if (cached_executor_context == nullptr) {
+    return new ExecutorContext(transaction, params);
+  }
+
+  ExecutorContext *executor_context = cached_executor_context.release();
+  executor_context->transaction_ = transaction;
+  executor_context->params_.assign(params.begin(), params.end());
+  executor_context->num_processed = 0;
+  return executor_context;
+}
+
+void ExecutorContext::Release(ExecutorContext *executor_context) {
+  if (executor_context == nullptr) {
+    return;
+  }
+
+  // the values of the statement are dropped, the chunk is kept
+  executor_context->transaction_ = nullptr;
+  executor_context->params_.clear();
+  if (executor_context->pool_ != nullptr) {
+    executor_context->pool_->Purge();
+  }
+
+  cached_executor_context.reset(executor_context);
+}
+
 concurrency::Transaction *ExecutorContext::GetTransaction() const {
   return transaction_;
 }
@@ -30,6 +30,7 @@
 #include "executor/executor_context.h"
 #include "expression/abstract_expression.h"
 #include "expression/container_tuple.h"
+#include "index/index_util.h"
 #include "planner/hybrid_scan_plan.h"
 #include "executor/hybrid_scan_executor.h"
 #include "storage/data_table.h"
@@ -103,6 +104,11 @@ bool HybridScanExecutor::DInit() {
       }
     }
 
+    // All "==" on the full key is a point lookup
+    point_query_ = index::ConstructPointKeyValues(
+        index_->GetKeySchema(), values_, key_column_ids_, expr_types_,
+        point_key_values_);
+
     if (table_ != nullptr) {
       LOG_TRACE("Column count : %u", table_->GetSchema()->GetColumnCount());
       full_column_ids_.resize(table_->GetSchema()->GetColumnCount());
@@ -129,9 +135,20 @@ bool HybridScanExecutor::DInit() {
         tile_group = table_->GetTileGroup(table_tile_group_count_ - 1);
       }
 
-      oid_t tuple_id = 0;
-      ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
-      block_threshold = location.block;
+      // Skip the tile groups that were dropped by compaction
+      for (oid_t tile_group_offset = current_tile_group_offset_;
+           tile_group == nullptr && tile_group_offset < table_tile_group_count_;
+           tile_group_offset++) {
+        tile_group = table_->GetTileGroup(tile_group_offset);
+      }
+
+      if (tile_group != nullptr) {
+        oid_t tuple_id = 0;
+        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+        block_threshold = location.block;
+      } else {
+        block_threshold = INVALID_OID;
+      }
     }
 
     result_itr_ = START_OID;
@@ -161,6 +178,11 @@ bool HybridScanExecutor::DInit() {
       }
     }
 
+    // All "==" on the full key is a point lookup
+    point_query_ = index::ConstructPointKeyValues(
+        index_->GetKeySchema(), values_, key_column_ids_, expr_types_,
+        point_key_values_);
+
     if (table_ != nullptr) {
       full_column_ids_.resize(table_->GetSchema()->GetColumnCount());
       std::iota(full_column_ids_.begin(), full_column_ids_.end(), 0);
@@ -184,14 +206,39 @@ bool HybridScanExecutor::SeqScanUtil() {
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
+  if (pending_output_ != nullptr) {
+    SetOutput(pending_output_.release());
+    return true;
+  }
+
+  const cid_t txn_begin_cid =
+      executor_context_->GetTransaction()->GetBeginCommitId();
+  const bool snapshot_read =
+      executor_context_->GetTransaction()->IsSnapshotRead();
+
   // Retrieve next tile group.
   while (current_tile_group_offset_ < table_tile_group_count_) {
     LOG_TRACE("Current tile group offset : %u", current_tile_group_offset_);
     auto tile_group = table_->GetTileGroup(current_tile_group_offset_++);
+
+    // Skip the tile group if it was dropped by compaction
+    if (tile_group == nullptr) {
+      continue;
+    }
+
     auto tile_group_header = tile_group->GetHeader();
 
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
+    // Skip the tile group if its zone map rules out the predicate
+    if (tile_group->GetZoneMap().CanSkip(predicate_, active_tuple_count)) {
+      continue;
+    }
+
+    // Whether a tuple is owned before checking visibility. A writer that
+    // owns a tuple later commits after the transaction began.
+    bool owned = (tile_group_header->GetOwnerCount() > 0);
+
     // Construct position list by looping through tile group
     // and applying the predicate.
     oid_t upper_bound_block = 0;
@@ -201,6 +248,7 @@ bool HybridScanExecutor::SeqScanUtil() {
     }
 
     std::vector<oid_t> position_list;
+    std::vector<oid_t> invisible_tuple_ids;
     for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
       ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
       if (type_ == HYBRID_SCAN_TYPE_HYBRID && item_pointers_.size() > 0 &&
@@ -210,6 +258,13 @@ bool HybridScanExecutor::SeqScanUtil() {
         }
       }
 
+      // A snapshot read is not validated, so the tuples are copied before a
+      // writer can overwrite them in place.
+      if (snapshot_read == true) {
+        invisible_tuple_ids.push_back(tuple_id);
+        continue;
+      }
+
       // Check transaction visibility
       if (transaction_manager.IsVisible(tile_group_header, tuple_id)) {
         // If the tuple is visible, then perform predicate evaluation.
@@ -226,33 +281,44 @@ bool HybridScanExecutor::SeqScanUtil() {
         }
       }
       else {
-        expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
-                                                             tuple_id);
-        auto eval =
-            predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
-        if (eval == true) {
-          position_list.push_back(tuple_id);
-          auto res = transaction_manager.PerformRead(location);
-          if (!res) {
-            transaction_manager.SetTransactionResult(RESULT_FAILURE);
-            return res;
-          }
-        }
+        invisible_tuple_ids.push_back(tuple_id);
       }
     }
 
+    // Tuples updated in place since the transaction began are read from
+    // their before-images. Writers own the tuples until they set the last
+    // end commit id, so other tile groups have none.
+    std::unique_ptr<LogicalTile> version_tile;
+    if (snapshot_read == true || owned == true ||
+        tile_group_header->GetOwnerCount() > 0 ||
+        tile_group_header->GetLastEndCommitId() > txn_begin_cid) {
+      version_tile.reset(ReadVersions(tile_group.get(), invisible_tuple_ids));
+    }
+
     // Don't return empty tiles
     if (position_list.size() == 0) {
+      if (version_tile != nullptr) {
+        SetOutput(version_tile.release());
+        return true;
+      }
       continue;
     }
 
-    // Construct logical tile.
-    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-    logical_tile->AddColumns(tile_group, column_ids_);
-    logical_tile->AddPositionList(std::move(position_list));
+    // Construct logical tile. A frozen tile group has no tiles to wrap,
+    // so its values are decoded into a temporary tile.
+    std::unique_ptr<LogicalTile> logical_tile;
+    if (tile_group->IsFrozen()) {
+      logical_tile.reset(LogicalTileFactory::CopyTuples(
+          tile_group.get(), position_list, column_ids_));
+    } else {
+      logical_tile.reset(LogicalTileFactory::GetTile());
+      logical_tile->AddColumns(tile_group, column_ids_);
+      logical_tile->AddPositionList(std::move(position_list));
+    }
 
     LOG_TRACE("Hybrid executor, Seq Scan :: Got a logical tile");
     SetOutput(logical_tile.release());
+    pending_output_ = std::move(version_tile);
 
     return true;
   }
@@ -347,6 +413,9 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
   if (0 == key_column_ids_.size()) {
     LOG_TRACE("Scan all keys");
     index_->ScanAllKeys(tuple_locations);
+  } else if (point_query_ == true) {
+    LOG_TRACE("Scan key point");
+    index_->ScanKeyPoint(point_key_values_, tuple_locations);
   } else {
     LOG_TRACE("Scan");
     index_->Scan(values_,
@@ -367,6 +436,11 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
   }
 
   std::map<oid_t, std::vector<oid_t>> visible_tuples;
+  // versions of the chains without a visible tuple may have been updated in
+  // place after the transaction began.
+  std::map<oid_t, std::vector<oid_t>> version_tuples;
+  const bool snapshot_read =
+      executor_context_->GetTransaction()->IsSnapshotRead();
 
   // for every tuple that is found in the index.
   for (auto tuple_location : tuple_locations) {
@@ -376,16 +450,23 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
     }
 
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
+    auto tile_group = manager.GetTileGroupUnsafe(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
 
     // perform transaction read
+    std::vector<ItemPointer> chain_locations;
     size_t chain_length = 0;
     while (true) {
       ++chain_length;
 
       if (transaction_manager.IsVisible(tile_group_header,
                                         tuple_location.offset)) {
+        // a snapshot read is not validated, so the tuple is copied before a
+        // writer can overwrite it in place.
+        if (snapshot_read == true) {
+          version_tuples[tuple_location.block].push_back(tuple_location.offset);
+          break;
+        }
         visible_tuples[tuple_location.block].push_back(tuple_location.offset);
         auto res = transaction_manager.PerformRead(tuple_location);
         if (!res) {
@@ -396,10 +477,20 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
       } else {
         ItemPointer old_item = tuple_location;
         cid_t old_end_cid = tile_group_header->GetEndCommitId(old_item.offset);
+        chain_locations.push_back(old_item);
 
         tuple_location = tile_group_header->GetNextItemPointer(old_item.offset);
-        // there must exist a visible version.
-        assert(tuple_location.IsNull() == false);
+
+        // the chain has no visible tuple, or the rest of it was dropped by
+        // compaction.
+        if (tuple_location.IsNull() == true ||
+            manager.GetTileGroupUnsafe(tuple_location.block) == nullptr) {
+          for (auto &chain_location : chain_locations) {
+            version_tuples[chain_location.block].push_back(
+                chain_location.offset);
+          }
+          break;
+        }
 
         cid_t max_committed_cid = transaction_manager.GetMaxCommittedCid();
 
@@ -411,8 +502,8 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
                   INVALID_TXN_ID);
         }
 
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = manager.GetTileGroupUnsafe(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
       }
     }
   }
@@ -422,11 +513,17 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
     auto &manager = catalog::Manager::GetInstance();
     auto tile_group = manager.GetTileGroup(tuples.first);
 
-    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-
-    // Add relevant columns to logical tile
-    logical_tile->AddColumns(tile_group, full_column_ids_);
-    logical_tile->AddPositionList(std::move(tuples.second));
+    std::unique_ptr<LogicalTile> logical_tile;
+    if (tile_group->IsFrozen()) {
+      // Decode the values of a frozen tile group into a temporary tile
+      logical_tile.reset(LogicalTileFactory::CopyTuples(
+          tile_group.get(), tuples.second, full_column_ids_));
+    } else {
+      // Add relevant columns to logical tile
+      logical_tile.reset(LogicalTileFactory::GetTile());
+      logical_tile->AddColumns(tile_group, full_column_ids_);
+      logical_tile->AddPositionList(std::move(tuples.second));
+    }
 
     if (column_ids_.size() != 0) {
       logical_tile->ProjectColumns(full_column_ids_, column_ids_);
@@ -435,6 +532,15 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
     result_.push_back(logical_tile.release());
   }
 
+  for (auto &tuples : version_tuples) {
+    auto tile_group =
+        catalog::Manager::GetInstance().GetTileGroupUnsafe(tuples.first);
+    auto logical_tile = ReadVersions(tile_group, tuples.second);
+    if (logical_tile != nullptr) {
+      result_.push_back(logical_tile);
+    }
+  }
+
   index_done_ = true;
 
   LOG_TRACE("Result tiles : %lu", result_.size());
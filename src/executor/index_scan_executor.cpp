@@ -24,6 +24,7 @@
 #include "expression/abstract_expression.h"
 #include "expression/container_tuple.h"
 #include "index/index.h"
+#include "index/index_util.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
@@ -92,6 +93,34 @@ bool IndexScanExecutor::DInit() {
     }
   }
 
+  // Each key of an IN-list is a point lookup on the full key
+  auto &key_values_list = node.GetKeyValuesList();
+  batch_key_values_.clear();
+  point_query_ = false;
+
+  if (key_values_list.size() != 0) {
+    std::vector<ExpressionType> key_expr_types(
+        key_column_ids_.size(), EXPRESSION_TYPE_COMPARE_EQUAL);
+
+    for (auto &key_values : key_values_list) {
+      std::vector<Value> batch_key;
+      bool full_key = (key_values.size() == key_column_ids_.size()) &&
+                      index::ConstructPointKeyValues(
+                          index_->GetKeySchema(), key_values, key_column_ids_,
+                          key_expr_types, batch_key);
+      if (full_key == false) {
+        LOG_ERROR("IN-list keys must cover the full index key");
+        return false;
+      }
+      batch_key_values_.push_back(std::move(batch_key));
+    }
+  } else {
+    // All "==" on the full key is a point lookup
+    point_query_ = index::ConstructPointKeyValues(
+        index_->GetKeySchema(), values_, key_column_ids_, expr_types_,
+        point_key_values_);
+  }
+
   table_ = node.GetTable();
 
   if (table_ != nullptr) {
@@ -153,6 +182,10 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
 
   if (0 == column_ids_.size()) {
     index_->ScanAllKeys(tuple_locations);
+  } else if (batch_key_values_.size() != 0) {
+    ScanKeyBatch(tuple_locations);
+  } else if (point_query_ == true) {
+    index_->ScanKeyPoint(point_key_values_, tuple_locations);
   } else {
     index_->Scan(values_, key_column_ids_, expr_types_,
                  SCAN_DIRECTION_TYPE_FORWARD, tuple_locations);
@@ -163,17 +196,30 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
       concurrency::TransactionManagerFactory::GetInstance();
 
   std::map<oid_t, std::vector<oid_t>> visible_tuples;
+  // versions of the chains without a visible tuple may have been updated in
+  // place after the transaction began.
+  std::map<oid_t, std::vector<oid_t>> version_tuples;
+  // whether a tuple of the tile group was owned before the first visibility
+  // check in it.
+  std::map<oid_t, bool> owned_tile_groups;
+  const bool snapshot_read =
+      executor_context_->GetTransaction()->IsSnapshotRead();
 
   // for every tuple that is found in the index.
   for (auto tuple_location : tuple_locations) {
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
+    auto tile_group = manager.GetTileGroupUnsafe(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
 
+    std::vector<ItemPointer> chain_locations;
     size_t chain_length = 0;
     while (true) {
       ++chain_length;
 
+      oid_t tile_group_id = tuple_location.block;
+      owned_tile_groups.emplace(tile_group_id,
+                                tile_group_header->GetOwnerCount() > 0);
+
       // if the tuple is visible.
       if (transaction_manager.IsVisible(tile_group_header,
                                         tuple_location.offset)) {
@@ -181,29 +227,21 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         LOG_TRACE("perform read: %u, %u", tuple_location.block,
                   tuple_location.offset);
 
-        // perform predicate evaluation.
-        if (predicate_ == nullptr) {
+        // a snapshot read is not validated, so the tuple is copied before a
+        // writer can overwrite it in place.
+        if (snapshot_read == true) {
+          version_tuples[tuple_location.block].push_back(tuple_location.offset);
+        } else if (predicate_ == nullptr) {
+          // perform predicate evaluation.
           visible_tuples[tuple_location.block].push_back(tuple_location.offset);
-
-          auto res = transaction_manager.PerformRead(tuple_location);
-          if (!res) {
-            transaction_manager.SetTransactionResult(RESULT_FAILURE);
-            return res;
-          }
         } else {
           expression::ContainerTuple<storage::TileGroup> tuple(
-              tile_group.get(), tuple_location.offset);
+              tile_group, tuple_location.offset);
           auto eval =
               predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
           if (eval == true) {
             visible_tuples[tuple_location.block]
                 .push_back(tuple_location.offset);
-
-            auto res = transaction_manager.PerformRead(tuple_location);
-            if (!res) {
-              transaction_manager.SetTransactionResult(RESULT_FAILURE);
-              return res;
-            }
           }
         }
         break;
@@ -212,8 +250,20 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
       else {
         ItemPointer old_item = tuple_location;
         cid_t old_end_cid = tile_group_header->GetEndCommitId(old_item.offset);
+        chain_locations.push_back(old_item);
 
         tuple_location = tile_group_header->GetNextItemPointer(old_item.offset);
+
+        // the rest of the chain was dropped by compaction
+        if (tuple_location.IsNull() == true ||
+            manager.GetTileGroupUnsafe(tuple_location.block) == nullptr) {
+          for (auto &chain_location : chain_locations) {
+            version_tuples[chain_location.block].push_back(
+                chain_location.offset);
+          }
+          break;
+        }
+
         cid_t max_committed_cid = transaction_manager.GetMaxCommittedCid();
 
         if (old_end_cid <= max_committed_cid) {
@@ -224,19 +274,19 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
 
           if (tile_group_header->SetAtomicTransactionId(
                   old_item.offset, INVALID_TXN_ID) == true) {
-            tile_group = manager.GetTileGroup(tuple_location.block);
-            tile_group_header = tile_group.get()->GetHeader();
+            tile_group = manager.GetTileGroupUnsafe(tuple_location.block);
+            tile_group_header = tile_group->GetHeader();
             tile_group_header->SetPrevItemPointer(tuple_location.offset,
                                                   INVALID_ITEMPOINTER);
 
           } else {
-            tile_group = manager.GetTileGroup(tuple_location.block);
-            tile_group_header = tile_group.get()->GetHeader();
+            tile_group = manager.GetTileGroupUnsafe(tuple_location.block);
+            tile_group_header = tile_group->GetHeader();
           }
 
         } else {
-          tile_group = manager.GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
+          tile_group = manager.GetTileGroupUnsafe(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
         }
       }
     }
@@ -244,13 +294,28 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
 
   // Construct a logical tile for each block
   for (auto tuples : visible_tuples) {
+    // Record the read of the tuples of the block at once
+    auto res = transaction_manager.PerformScan(
+        tuples.first, tuples.second, owned_tile_groups[tuples.first]);
+    if (!res) {
+      transaction_manager.SetTransactionResult(RESULT_FAILURE);
+      return res;
+    }
+
     auto &manager = catalog::Manager::GetInstance();
     auto tile_group = manager.GetTileGroup(tuples.first);
 
-    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-    // Add relevant columns to logical tile
-    logical_tile->AddColumns(tile_group, full_column_ids_);
-    logical_tile->AddPositionList(std::move(tuples.second));
+    std::unique_ptr<LogicalTile> logical_tile;
+    if (tile_group->IsFrozen()) {
+      // Decode the values of a frozen tile group into a temporary tile
+      logical_tile.reset(LogicalTileFactory::CopyTuples(
+          tile_group.get(), tuples.second, full_column_ids_));
+    } else {
+      // Add relevant columns to logical tile
+      logical_tile.reset(LogicalTileFactory::GetTile());
+      logical_tile->AddColumns(tile_group, full_column_ids_);
+      logical_tile->AddPositionList(std::move(tuples.second));
+    }
     if (column_ids_.size() != 0) {
       logical_tile->ProjectColumns(full_column_ids_, column_ids_);
     }
@@ -258,6 +323,15 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
     result_.push_back(logical_tile.release());
   }
 
+  for (auto &tuples : version_tuples) {
+    auto tile_group =
+        catalog::Manager::GetInstance().GetTileGroupUnsafe(tuples.first);
+    auto logical_tile = ReadVersions(tile_group, tuples.second);
+    if (logical_tile != nullptr) {
+      result_.push_back(logical_tile);
+    }
+  }
+
   done_ = true;
 
   LOG_TRACE("Result tiles : %lu", result_.size());
@@ -265,6 +339,17 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   return true;
 }
 
+// look up all keys of the IN-list with one batch probe of the index
+void IndexScanExecutor::ScanKeyBatch(std::vector<ItemPointer> &tuple_locations) {
+  std::vector<std::vector<ItemPointer>> batch_locations;
+  index_->ScanBatch(batch_key_values_, batch_locations);
+
+  for (auto &locations : batch_locations) {
+    tuple_locations.insert(tuple_locations.end(), locations.begin(),
+                           locations.end());
+  }
+}
+
 bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   PL_ASSERT(!done_);
 
@@ -281,6 +366,10 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
   if (0 == key_column_ids_.size()) {
     index_->ScanAllKeys(tuple_locations);
+  } else if (batch_key_values_.size() != 0) {
+    ScanKeyBatch(tuple_locations);
+  } else if (point_query_ == true) {
+    index_->ScanKeyPoint(point_key_values_, tuple_locations);
   } else {
     index_->Scan(values_, key_column_ids_, expr_type_,
                  SCAN_DIRECTION_TYPE_FORWARD, tuple_locations);
@@ -296,50 +385,72 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
       concurrency::TransactionManagerFactory::GetInstance();
 
   std::map<oid_t, std::vector<oid_t>> visible_tuples;
+  // invisible tuples may have been updated in place after the transaction
+  // began.
+  std::map<oid_t, std::vector<oid_t>> version_tuples;
+  // whether a tuple of the tile group was owned before the first visibility
+  // check in it.
+  std::map<oid_t, bool> owned_tile_groups;
+  const bool snapshot_read =
+      executor_context_->GetTransaction()->IsSnapshotRead();
   // for every tuple that is found in the index.
   for (auto tuple_location : tuple_locations) {
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
+    auto tile_group = manager.GetTileGroupUnsafe(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
     auto tile_group_id = tuple_location.block;
     auto tuple_id = tuple_location.offset;
 
+    owned_tile_groups.emplace(tile_group_id,
+                              tile_group_header->GetOwnerCount() > 0);
+
     // if the tuple is visible.
     if (transaction_manager.IsVisible(tile_group_header, tuple_id)) {
-      // perform predicate evaluation.
-      if (predicate_ == nullptr) {
+      // a snapshot read is not validated, so the tuple is copied before a
+      // writer can overwrite it in place.
+      if (snapshot_read == true) {
+        version_tuples[tile_group_id].push_back(tuple_id);
+      } else if (predicate_ == nullptr) {
+        // perform predicate evaluation.
         visible_tuples[tile_group_id].push_back(tuple_id);
-        auto res = transaction_manager.PerformRead(tuple_location);
-        if (!res) {
-          transaction_manager.SetTransactionResult(RESULT_FAILURE);
-          return res;
-        }
       } else {
-        expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+        expression::ContainerTuple<storage::TileGroup> tuple(tile_group,
                                                              tuple_id);
         auto eval =
             predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
         if (eval == true) {
           visible_tuples[tile_group_id].push_back(tuple_id);
-          auto res = transaction_manager.PerformRead(tuple_location);
-          if (!res) {
-            transaction_manager.SetTransactionResult(RESULT_FAILURE);
-            return res;
-          }
         }
       }
+    } else {
+      version_tuples[tile_group_id].push_back(tuple_id);
     }
   }
 
   // Construct a logical tile for each block
   for (auto tuples : visible_tuples) {
+    // Record the read of the tuples of the block at once
+    auto res = transaction_manager.PerformScan(
+        tuples.first, tuples.second, owned_tile_groups[tuples.first]);
+    if (!res) {
+      transaction_manager.SetTransactionResult(RESULT_FAILURE);
+      return res;
+    }
+
     auto &manager = catalog::Manager::GetInstance();
     auto tile_group = manager.GetTileGroup(tuples.first);
 
-    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-    // Add relevant columns to logical tile
-    logical_tile->AddColumns(tile_group, full_column_ids_);
-    logical_tile->AddPositionList(std::move(tuples.second));
+    std::unique_ptr<LogicalTile> logical_tile;
+    if (tile_group->IsFrozen()) {
+      // Decode the values of a frozen tile group into a temporary tile
+      logical_tile.reset(LogicalTileFactory::CopyTuples(
+          tile_group.get(), tuples.second, full_column_ids_));
+    } else {
+      // Add relevant columns to logical tile
+      logical_tile.reset(LogicalTileFactory::GetTile());
+      logical_tile->AddColumns(tile_group, full_column_ids_);
+      logical_tile->AddPositionList(std::move(tuples.second));
+    }
     if (column_ids_.size() != 0) {
       logical_tile->ProjectColumns(full_column_ids_, column_ids_);
     }
@@ -347,6 +458,15 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
     result_.push_back(logical_tile.release());
   }
 
+  for (auto &tuples : version_tuples) {
+    auto tile_group =
+        catalog::Manager::GetInstance().GetTileGroupUnsafe(tuples.first);
+    auto logical_tile = ReadVersions(tile_group, tuples.second);
+    if (logical_tile != nullptr) {
+      result_.push_back(logical_tile);
+    }
+  }
+
   done_ = true;
 
   LOG_TRACE("Result tiles : %lu", result_.size());
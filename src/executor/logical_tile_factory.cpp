@@ -13,9 +13,12 @@
 
 #include "executor/logical_tile_factory.h"
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 #include <utility>
 
+#include "catalog/schema.h"
 #include "common/types.h"
 #include "executor/logical_tile.h"
 #include "storage/tile.h"
@@ -109,5 +112,56 @@ LogicalTile *LogicalTileFactory::WrapTileGroup(
   return new_tile.release();
 }
 
+/**
+ * @brief Copy the given columns of the given tuples to a temporary tile.
+ * Values are read through the tile group, so a frozen tile group is decoded
+ * without rebuilding its tiles. The tuples keep their slots in the
+ * temporary tile, which refers to the tile group, so that writers can
+ * still locate them.
+ * @param tile_group Tile group that holds the tuples.
+ * @param tuple_ids Tuples to copy.
+ * @param column_ids Columns to copy, all columns if empty.
+ *
+ * @return Pointer to newly created logical tile.
+ */
+LogicalTile *LogicalTileFactory::CopyTuples(
+    storage::TileGroup *tile_group, const std::vector<oid_t> &tuple_ids,
+    const std::vector<oid_t> &column_ids) {
+  auto table_schema = tile_group->GetAbstractTable()->GetSchema();
+
+  std::vector<oid_t> copied_column_ids(column_ids);
+  if (copied_column_ids.empty()) {
+    copied_column_ids.resize(table_schema->GetColumnCount());
+    std::iota(copied_column_ids.begin(), copied_column_ids.end(), 0);
+  }
+
+  oid_t tuple_count = 0;
+  for (auto tuple_id : tuple_ids) {
+    tuple_count = std::max(tuple_count, tuple_id + 1);
+  }
+
+  std::unique_ptr<catalog::Schema> schema(
+      catalog::Schema::CopySchema(table_schema, copied_column_ids));
+  std::shared_ptr<storage::Tile> tile(storage::TileFactory::GetTile(
+      BACKEND_TYPE_MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
+      nullptr, *schema, tile_group, tuple_count));
+
+  for (auto tuple_id : tuple_ids) {
+    for (oid_t col_itr = 0; col_itr < copied_column_ids.size(); col_itr++) {
+      tile->SetValue(tile_group->GetValue(tuple_id, copied_column_ids[col_itr]),
+                     tuple_id, col_itr);
+    }
+  }
+
+  std::unique_ptr<LogicalTile> new_tile(new LogicalTile());
+  const int position_list_idx = 0;
+  for (oid_t col_itr = 0; col_itr < copied_column_ids.size(); col_itr++) {
+    new_tile->AddColumn(tile, col_itr, position_list_idx);
+  }
+  new_tile->AddPositionList(std::vector<oid_t>(tuple_ids));
+
+  return new_tile.release();
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -36,6 +36,8 @@ executor::AbstractExecutor *BuildExecutorTree(
 
 void CleanExecutorTree(executor::AbstractExecutor *root);
 
+bool IsSnapshotReadPlan(const planner::AbstractPlan *plan);
+
 /**
  * @brief Build a executor tree and execute it.
  * Use std::vector<Value> as params to make it more elegant for networking
@@ -61,7 +63,7 @@ peloton_status PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
   // This happens for single statement queries in PG
   if (txn == nullptr) {
     single_statement_txn = true;
-    txn = txn_manager.BeginTransaction();
+    txn = txn_manager.BeginTransaction(IsSnapshotReadPlan(plan));
   }
   PL_ASSERT(txn);
 
@@ -69,7 +71,7 @@ peloton_status PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
   LOG_TRACE("Building the executor tree");
 
   // Use const std::vector<Value> &params to make it more elegant for network
-  std::unique_ptr<executor::ExecutorContext> executor_context(
+  executor::PooledExecutorContext executor_context(
       BuildExecutorContext(params, txn));
 
   // Build the executor tree
@@ -188,7 +190,7 @@ int PlanExecutor::ExecutePlan(
   // This happens for single statement queries in PG
   if (txn == nullptr) {
     single_statement_txn = true;
-    txn = txn_manager.BeginTransaction();
+    txn = txn_manager.BeginTransaction(IsSnapshotReadPlan(plan));
   }
   PL_ASSERT(txn);
 
@@ -196,7 +198,7 @@ int PlanExecutor::ExecutePlan(
   LOG_TRACE("Building the executor tree");
 
   // Use const std::vector<Value> &params to make it more elegant for network
-  std::unique_ptr<executor::ExecutorContext> executor_context(
+  executor::PooledExecutorContext executor_context(
       BuildExecutorContext(params, txn));
 
   // Build the executor tree
@@ -290,12 +292,45 @@ void PlanExecutor::PrintPlan(const planner::AbstractPlan *plan,
   }
 }
 
+/**
+ * @brief Check whether a single statement can run as a snapshot read.
+ * Under snapshot isolation, statements that do not write read a committed
+ * snapshot without recording their reads.
+ * @param The plan tree
+ * @return true if the plan tree does not write.
+ */
+bool IsSnapshotReadPlan(const planner::AbstractPlan *plan) {
+  if (concurrency::TransactionManagerFactory::GetIsolationLevel() !=
+      ISOLATION_LEVEL_TYPE_SNAPSHOT) {
+    return false;
+  }
+
+  switch (plan->GetPlanNodeType()) {
+    case PLAN_NODE_TYPE_UPDATE:
+    case PLAN_NODE_TYPE_INSERT:
+    case PLAN_NODE_TYPE_DELETE:
+    case PLAN_NODE_TYPE_DROP:
+    case PLAN_NODE_TYPE_CREATE:
+      return false;
+
+    default:
+      break;
+  }
+
+  for (auto &child : plan->GetChildren()) {
+    if (IsSnapshotReadPlan(child.get()) == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /**
  * @brief Build Executor Context
  */
 executor::ExecutorContext *BuildExecutorContext(
     const std::vector<Value> &params, concurrency::Transaction *txn) {
-  return new executor::ExecutorContext(txn, params);
+  return executor::ExecutorContext::Acquire(txn, params);
 }
 
 /**
@@ -120,60 +120,125 @@ bool SeqScanExecutor::DExecute() {
     concurrency::TransactionManager &transaction_manager =
         concurrency::TransactionManagerFactory::GetInstance();
 
+    if (pending_output_ != nullptr) {
+      SetOutput(pending_output_.release());
+      return true;
+    }
+
+    const cid_t txn_begin_cid =
+        executor_context_->GetTransaction()->GetBeginCommitId();
+
     // Retrieve next tile group.
     while (current_tile_group_offset_ < table_tile_group_count_) {
       auto tile_group =
           target_table_->GetTileGroup(current_tile_group_offset_++);
+
+      // Skip the tile group if it was dropped by compaction
+      if (tile_group == nullptr) {
+        continue;
+      }
+
       auto tile_group_header = tile_group->GetHeader();
 
       oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
-      // Construct position list by looping through tile group
+      // Skip the tile group if its zone map rules out the predicate
+      if (tile_group->GetZoneMap().CanSkip(predicate_, active_tuple_count)) {
+        continue;
+      }
+
+      // A snapshot read is not validated, so the visible tuples are copied
+      // before a writer can overwrite them in place.
+      if (executor_context_->GetTransaction()->IsSnapshotRead() == true) {
+        std::vector<oid_t> tuple_ids(active_tuple_count);
+        std::iota(tuple_ids.begin(), tuple_ids.end(), 0);
+        std::unique_ptr<LogicalTile> version_tile(
+            ReadVersions(tile_group.get(), tuple_ids));
+        if (version_tile == nullptr) {
+          continue;
+        }
+        SetOutput(version_tile.release());
+        return true;
+      }
+
+      // Whether a tuple is owned before checking visibility. A writer that
+      // owns a tuple later commits after the transaction began.
+      bool owned = (tile_group_header->GetOwnerCount() > 0);
+
+      // Check transaction visibility of the whole tile group at once.
+      std::vector<oid_t> visible_tuple_ids;
+      visible_tuple_ids.reserve(active_tuple_count);
+      transaction_manager.IsVisibleBatch(tile_group_header, 0,
+                                         active_tuple_count, visible_tuple_ids);
+
+      // Tuples updated in place since the transaction began are read from
+      // their before-images. Writers own the tuples until they set the last
+      // end commit id, so other tile groups have none.
+      std::unique_ptr<LogicalTile> version_tile;
+      if (owned == true || tile_group_header->GetOwnerCount() > 0 ||
+          tile_group_header->GetLastEndCommitId() > txn_begin_cid) {
+        std::vector<oid_t> invisible_tuple_ids;
+        auto visible_itr = visible_tuple_ids.begin();
+        for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+          if (visible_itr != visible_tuple_ids.end() &&
+              *visible_itr == tuple_id) {
+            visible_itr++;
+          } else {
+            invisible_tuple_ids.push_back(tuple_id);
+          }
+        }
+        version_tile.reset(ReadVersions(tile_group.get(), invisible_tuple_ids));
+      }
+
+      // Construct position list by looping through the visible tuples
       // and applying the predicate.
       std::vector<oid_t> position_list;
-      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
-
-        // check transaction visibility
-        if (transaction_manager.IsVisible(tile_group_header, tuple_id)) {
+      if (predicate_ == nullptr) {
+        position_list = std::move(visible_tuple_ids);
+      } else {
+        for (auto tuple_id : visible_tuple_ids) {
           // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
+          expression::ContainerTuple<storage::TileGroup> tuple(
+              tile_group.get(), tuple_id);
+          auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_)
+                          .IsTrue();
+          if (eval == true) {
             position_list.push_back(tuple_id);
-            auto res = transaction_manager.PerformRead(location);
-            if (!res) {
-              transaction_manager.SetTransactionResult(RESULT_FAILURE);
-              return res;
-            }
-          } else {
-            expression::ContainerTuple<storage::TileGroup> tuple(
-                tile_group.get(), tuple_id);
-            auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_)
-                            .IsTrue();
-            if (eval == true) {
-              position_list.push_back(tuple_id);
-              auto res = transaction_manager.PerformRead(location);
-              if (!res) {
-                transaction_manager.SetTransactionResult(RESULT_FAILURE);
-                return res;
-              }
-              else {
-            	  LOG_TRACE("Sequential Scan Predicate Satisfied");
-              }
-            }
+            LOG_TRACE("Sequential Scan Predicate Satisfied");
           }
         }
       }
 
       // Don't return empty tiles
       if (position_list.size() == 0) {
+        if (version_tile != nullptr) {
+          SetOutput(version_tile.release());
+          return true;
+        }
         continue;
       }
 
-      // Construct logical tile.
-      std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-      logical_tile->AddColumns(tile_group, column_ids_);
-      logical_tile->AddPositionList(std::move(position_list));
+      // Record the read of the tile group at once
+      auto res = transaction_manager.PerformScan(tile_group->GetTileGroupId(),
+                                                 position_list, owned);
+      if (!res) {
+        transaction_manager.SetTransactionResult(RESULT_FAILURE);
+        return res;
+      }
+
+      // Construct logical tile. A frozen tile group has no tiles to wrap,
+      // so its values are decoded into a temporary tile.
+      std::unique_ptr<LogicalTile> logical_tile;
+      if (tile_group->IsFrozen()) {
+        logical_tile.reset(LogicalTileFactory::CopyTuples(
+            tile_group.get(), position_list, column_ids_));
+      } else {
+        logical_tile.reset(LogicalTileFactory::GetTile());
+        logical_tile->AddColumns(tile_group, column_ids_);
+        logical_tile->AddPositionList(std::move(position_list));
+      }
 
+      pending_output_ = std::move(version_tile);
       SetOutput(logical_tile.release());
       return true;
     }
@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
 #include "executor/update_executor.h"
 #include "catalog/manager.h"
 #include "common/logger.h"
@@ -18,6 +20,7 @@
 #include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "expression/container_tuple.h"
+#include "index/index.h"
 #include "planner/update_plan.h"
 #include "storage/data_table.h"
 #include "storage/rollback_segment.h"
@@ -52,6 +55,20 @@ bool UpdateExecutor::DInit() {
   PL_ASSERT(target_table_);
   PL_ASSERT(project_info_);
 
+  // an update of an index key needs a new version for the index entries.
+  update_in_place_ = true;
+  for (oid_t index_itr = 0; index_itr < target_table_->GetIndexCount();
+       index_itr++) {
+    auto key_attrs =
+        target_table_->GetIndex(index_itr)->GetMetadata()->GetKeyAttrs();
+    for (auto &target : project_info_->GetTargetList()) {
+      if (std::find(key_attrs.begin(), key_attrs.end(), target.first) !=
+          key_attrs.end()) {
+        update_in_place_ = false;
+      }
+    }
+  }
+
   return true;
 }
 
@@ -100,6 +117,61 @@ void UpdateExecutor::InplaceUpdate(storage::TileGroup *tile_group,
   transaction_manager.PerformUpdate(location);
 }
 
+/**
+ * @brief Update the target columns of a tuple in place.
+ * @details The before-image of the target columns is saved on a rollback
+ * segment first, so that other transactions still read the committed version.
+ * All target expressions are evaluated on the old tuple before any column is
+ * written. No index entry changes, as no key column is updated.
+ */
+void UpdateExecutor::UpdateColumns(storage::TileGroup *tile_group,
+                                   ItemPointer location) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto &target_list = project_info_->GetTargetList();
+
+  expression::ContainerTuple<storage::TileGroup> old_tuple(tile_group,
+                                                           location.offset);
+  std::vector<Value> values;
+  for (auto &target : target_list) {
+    values.push_back(
+        target.second->Evaluate(&old_tuple, nullptr, executor_context_));
+  }
+
+  transaction_manager.PerformInplaceUpdate(location, target_list);
+
+  for (oid_t target_itr = 0; target_itr < target_list.size(); target_itr++) {
+    tile_group->SetValue(values[target_itr], location.offset,
+                         target_list[target_itr].first);
+  }
+}
+
+/**
+ * @brief Update a tuple by inserting a new version of it.
+ * @return true on success, false if the new version could not be inserted.
+ */
+bool UpdateExecutor::UpdateVersion(storage::TileGroup *tile_group,
+                                   ItemPointer location) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  expression::ContainerTuple<storage::TileGroup> old_tuple(tile_group,
+                                                           location.offset);
+  std::unique_ptr<storage::Tuple> new_tuple(
+      new storage::Tuple(target_table_->GetSchema(), true));
+  project_info_->Evaluate(new_tuple.get(), &old_tuple, nullptr,
+                          executor_context_);
+
+  ItemPointer new_location = target_table_->InsertVersion(new_tuple.get());
+  if (new_location.IsNull() == true) {
+    LOG_TRACE("Fail to insert new tuple. Set txn failure.");
+    transaction_manager.SetTransactionResult(Result::RESULT_FAILURE);
+    return false;
+  }
+  transaction_manager.PerformUpdate(location, new_location);
+  return true;
+}
+
 /**
  * @brief updates a set of columns
  * @return true on success, false otherwise.
@@ -123,6 +195,15 @@ bool UpdateExecutor::DExecute() {
   auto &pos_lists = source_tile.get()->GetPositionLists();
   storage::Tile *tile = source_tile->GetBaseTile(0);
   storage::TileGroup *tile_group = tile->GetTileGroup();
+
+  // the child read committed versions that were updated in place by other
+  // transactions, which are not the latest versions.
+  if (tile_group == nullptr) {
+    LOG_TRACE("Fail to update tuple. Set txn failure.");
+    target_table_->IncreaseConflictCount();
+    transaction_manager.SetTransactionResult(Result::RESULT_FAILURE);
+    return false;
+  }
   storage::TileGroupHeader *tile_group_header = tile_group->GetHeader();
   auto tile_group_id = tile_group->GetTileGroupId();
 
@@ -137,7 +218,16 @@ bool UpdateExecutor::DExecute() {
 
     if (transaction_manager.IsOwner(tile_group_header, physical_tuple_id) ==
         true) {
-      InplaceUpdate(tile_group, old_location);
+      if (update_in_place_ == true) {
+        UpdateColumns(tile_group, old_location);
+      } else if (transaction_manager.IsUpdatedInPlace(
+                     tile_group_header, physical_tuple_id) == true) {
+        if (UpdateVersion(tile_group, old_location) == false) {
+          return false;
+        }
+      } else {
+        InplaceUpdate(tile_group, old_location);
+      }
     } else if (transaction_manager.IsOwnable(tile_group_header,
                                              physical_tuple_id) == true) {
       // if the tuple is not owned by any transaction and is visible to current
@@ -146,15 +236,19 @@ bool UpdateExecutor::DExecute() {
       if (transaction_manager.AcquireOwnership(tile_group_header, tile_group_id,
                                                physical_tuple_id) == false) {
         LOG_TRACE("Fail to insert new tuple. Set txn failure.");
+        target_table_->IncreaseConflictCount();
         transaction_manager.SetTransactionResult(Result::RESULT_FAILURE);
         return false;
       }
-      // WARNING !!!!!!!!: DOING INPLACE UPDATE ONLY FOR INC BRANCH
-      //////////////////////////////////////////////////////////////////
-      InplaceUpdate(tile_group, old_location);
+      if (update_in_place_ == true) {
+        UpdateColumns(tile_group, old_location);
+      } else if (UpdateVersion(tile_group, old_location) == false) {
+        return false;
+      }
     } else {
       // transaction should be aborted as we cannot update the latest version.
       LOG_TRACE("Fail to update tuple. Set txn failure.");
+      target_table_->IncreaseConflictCount();
       transaction_manager.SetTransactionResult(Result::RESULT_FAILURE);
       return false;
     }
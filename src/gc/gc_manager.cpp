@@ -14,6 +14,7 @@
 #include "common/types.h"
 #include "gc/gc_manager.h"
 #include "gc/gc_manager_factory.h"
+#include "catalog/manager.h"
 #include "index/index.h"
 #include "concurrency/transaction_manager_factory.h"
 
@@ -154,6 +155,9 @@ void GCManager::Running() {
 
     assert(max_cid != MAX_CID);
 
+    // Release the dropped tile groups that are no longer visible
+    catalog::Manager::GetInstance().ReclaimTileGroups(max_cid);
+
     int tuple_counter = 0;
     int attempt = 0;
     auto queue_itr = local_reclaim_queue.begin();
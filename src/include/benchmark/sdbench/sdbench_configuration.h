@@ -130,6 +130,14 @@ class configuration {
 
   // write intensive workload ratio threshold
   double write_ratio_threshold;
+
+  // BACKGROUND MAINTENANCE
+
+  // freeze cold tile groups in the background
+  bool freeze_tile_groups;
+
+  // compact sparse tile groups in the background
+  bool compact_tile_groups;
 };
 
 void Usage(FILE *out);
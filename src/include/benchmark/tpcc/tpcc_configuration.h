@@ -168,6 +168,9 @@ class configuration {
   // average latency
   double latency;
 
+  // fraction of the executed transactions that aborted
+  double abort_rate;
+
   // item count
   int item_count;
 
@@ -183,6 +186,16 @@ class configuration {
   // index type
   IndexType index_type;
 
+  // concurrency control protocol
+  ConcurrencyType protocol;
+
+  // run the workload once with each protocol
+  bool compare_protocols;
+
+  // longest wait (in us) for the owner of a version, 0 to abort at once,
+  // -1 for the default of the protocol
+  int ownership_wait_us;
+
 };
 
 extern configuration state;
@@ -201,6 +214,10 @@ void ValidateTransactionCount(const configuration &state);
 
 void ValidateIndexType(const configuration &state);
 
+void ValidateProtocol(const configuration &state);
+
+void ValidateOwnershipWait(const configuration &state);
+
 }  // namespace tpcc
 }  // namespace benchmark
 }  // namespace peloton
@@ -56,6 +56,9 @@ class configuration {
   // latency average
   double latency;
 
+  // fraction of the executed transactions that aborted
+  double abort_rate;
+
   // # of transaction
   int transaction_count;
 
@@ -65,6 +68,16 @@ class configuration {
   // index type
   IndexType index_type;
 
+  // concurrency control protocol
+  ConcurrencyType protocol;
+
+  // run the workload once with each protocol
+  bool compare_protocols;
+
+  // longest wait (in us) for the owner of a version, 0 to abort at once,
+  // -1 for the default of the protocol
+  int ownership_wait_us;
+
 };
 
 extern configuration state;
@@ -87,6 +100,10 @@ void ValidateTransactionCount(const configuration &state);
 
 void ValidateIndexType(const configuration &state);
 
+void ValidateProtocol(const configuration &state);
+
+void ValidateOwnershipWait(const configuration &state);
+
 }  // namespace ycsb
 }  // namespace benchmark
 }  // namespace peloton
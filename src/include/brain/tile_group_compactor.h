@@ -0,0 +1,92 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.h
+//
+// Identification: src/include/brain/tile_group_compactor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/types.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+}
+
+namespace brain {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compactor
+//===--------------------------------------------------------------------===//
+
+// Background thread that compacts the sparse tile groups of tables
+class TileGroupCompactor {
+ public:
+  TileGroupCompactor(const TileGroupCompactor &) = delete;
+  TileGroupCompactor &operator=(const TileGroupCompactor &) = delete;
+  TileGroupCompactor(TileGroupCompactor &&) = delete;
+  TileGroupCompactor &operator=(TileGroupCompactor &&) = delete;
+
+  TileGroupCompactor();
+
+  ~TileGroupCompactor();
+
+  // Singleton
+  static TileGroupCompactor &GetInstance();
+
+  // Start compaction
+  void Start();
+
+  // Compact the sparse tile groups of all tables
+  void Compact();
+
+  // Stop compaction
+  void Stop();
+
+  // Add table to list of tables whose tile groups must be compacted
+  void AddTable(storage::DataTable *table);
+
+  // Clear list
+  void ClearTables();
+
+ protected:
+  // Compact the sparse tile groups of the table
+  void CompactTable(storage::DataTable *table, const cid_t &max_dead_cid);
+
+ private:
+  // Tables whose tile groups must be compacted
+  std::vector<storage::DataTable *> tables;
+
+  std::mutex tile_group_compactor_mutex;
+
+  // Stop signal
+  std::atomic<bool> compaction_stop;
+
+  // Compactor thread
+  std::thread tile_group_compactor_thread;
+
+  //===--------------------------------------------------------------------===//
+  // Compactor Parameters
+  //===--------------------------------------------------------------------===//
+
+  // Sleeping period (in us)
+  oid_t sleep_duration = 1000 * 100;
+
+  // Largest fraction of live tuples in a compacted tile group
+  double threshold = 0.25;
+};
+
+}  // End brain namespace
+}  // End peloton namespace
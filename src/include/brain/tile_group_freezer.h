@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_freezer.h
+//
+// Identification: src/include/brain/tile_group_freezer.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/types.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+}
+
+namespace brain {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Freezer
+//===--------------------------------------------------------------------===//
+
+// Background thread that compresses the cold tile groups of tables
+class TileGroupFreezer {
+ public:
+  TileGroupFreezer(const TileGroupFreezer &) = delete;
+  TileGroupFreezer &operator=(const TileGroupFreezer &) = delete;
+  TileGroupFreezer(TileGroupFreezer &&) = delete;
+  TileGroupFreezer &operator=(TileGroupFreezer &&) = delete;
+
+  TileGroupFreezer();
+
+  ~TileGroupFreezer();
+
+  // Singleton
+  static TileGroupFreezer &GetInstance();
+
+  // Start freezing
+  void Start();
+
+  // Freeze the cold tile groups of all tables
+  void Freeze();
+
+  // Stop freezing
+  void Stop();
+
+  // Add table to list of tables whose tile groups must be frozen
+  void AddTable(storage::DataTable *table);
+
+  // Clear list
+  void ClearTables();
+
+ protected:
+  // Freeze the cold tile groups of the table
+  void FreezeTable(storage::DataTable *table, const cid_t &max_dead_cid);
+
+ private:
+  // Tables whose tile groups must be frozen
+  std::vector<storage::DataTable *> tables;
+
+  std::mutex tile_group_freezer_mutex;
+
+  // Stop signal
+  std::atomic<bool> freezing_stop;
+
+  // Freezer thread
+  std::thread tile_group_freezer_thread;
+
+  //===--------------------------------------------------------------------===//
+  // Freezer Parameters
+  //===--------------------------------------------------------------------===//
+
+  // Sleeping period (in us)
+  oid_t sleep_duration = 1000 * 100;
+};
+
+}  // End brain namespace
+}  // End peloton namespace
@@ -65,8 +65,19 @@ class Manager {
 
   std::shared_ptr<storage::TileGroup> GetTileGroup(const oid_t oid);
 
+  // Look up the tile group without touching its reference count.
+  // The returned pointer is only guaranteed to stay valid while the caller
+  // is inside an epoch (i.e., within a running transaction), since dropped
+  // or replaced tile groups are reclaimed only after the epoch has passed.
+  storage::TileGroup *GetTileGroupUnsafe(const oid_t oid) const {
+    return raw_locator.Find(oid);
+  }
+
   void ClearTileGroup(void);
 
+  // Release the retired tile groups that no running transaction can observe
+  void ReclaimTileGroups(const cid_t max_dead_cid);
+
   //===--------------------------------------------------------------------===//
   // DATABASE
   //===--------------------------------------------------------------------===//
@@ -101,8 +112,24 @@ class Manager {
 
   std::atomic<oid_t> oid = ATOMIC_VAR_INIT(START_OID);
 
+  // Retire the tile group that is no longer reachable through the locator
+  void RetireTileGroup(std::shared_ptr<storage::TileGroup> &&tile_group);
+
   LockFreeArray<std::shared_ptr<storage::TileGroup>> locator;
 
+  // raw pointers mirroring the locator for refcount-free lookups
+  LockFreeArray<storage::TileGroup *> raw_locator;
+
+  // serializes the updates of the locators, lookups do not take it
+  std::mutex locator_mutex;
+
+  // tile groups dropped from the locator, tagged with the commit id at
+  // the time they were dropped
+  std::vector<std::pair<cid_t, std::shared_ptr<storage::TileGroup>>>
+      retired_tile_groups;
+
+  std::mutex retired_tile_groups_mutex;
+
   // DATABASES
 
   std::vector<storage::Database *> databases;
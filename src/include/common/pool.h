@@ -19,6 +19,7 @@
 #include <errno.h>
 #include <climits>
 #include <string.h>
+#include <atomic>
 #include <mutex>
 
 #include "storage/storage_manager.h"
@@ -60,6 +61,11 @@ inline T nexthigher(T k) {
  * A memory pool that provides fast allocation and deallocation. The
  * only way to release memory is to free all memory in the pool by
  * calling purge.
+ *
+ * Allocation is lock-free. Small allocations are bumped out of a region
+ * of the current chunk that is private to the allocating thread. A full
+ * chunk is replaced with a CAS, and all chunks are released together
+ * when the pool is destroyed.
  */
 class VarlenPool {
   VarlenPool(const VarlenPool &) = delete;
@@ -68,8 +74,7 @@ class VarlenPool {
  public:
   VarlenPool(BackendType backend_type);
 
-  VarlenPool(BackendType backend_type, uint64_t allocation_size,
-             uint64_t max_chunk_count);
+  VarlenPool(BackendType backend_type, uint64_t allocation_size);
 
   ~VarlenPool();
 
@@ -82,23 +87,52 @@ class VarlenPool {
   // initialized to 0s
   void *AllocateZeroes(std::size_t size);
 
+  // Release all chunks but the current one.
+  // Must not run concurrently with allocations.
   void Purge();
 
   int64_t GetAllocatedMemory();
 
  private:
+  struct ArenaChunk {
+    ArenaChunk(uint64_t size, char *chunk_data)
+        : offset(0), size(size), chunk_data(chunk_data), next(nullptr) {}
+
+    std::atomic<uint64_t> offset;
+    const uint64_t size;
+    char *chunk_data;
+
+    // next chunk in the chunk list
+    ArenaChunk *next;
+  };
+
+  void *AllocateFromChunk(const std::size_t &size);
+
+  ArenaChunk *NewChunk(const uint64_t &size);
+
+  void ReleaseChunk(ArenaChunk *chunk);
+
+  // Add the chunk to the chunk list
+  void AddChunk(ArenaChunk *chunk);
+
   // backend type
   BackendType backend_type;
 
   const uint64_t allocation_size;
-  std::size_t max_chunk_count;
-  std::size_t current_chunk_index;
-  std::vector<Chunk> chunks;
 
-  // Oversize chunks that will be freed and not reused.
-  std::vector<Chunk> oversize_chunks;
+  // size of the regions handed out to threads, 0 if threads bump the chunk
+  const uint64_t thread_region_size;
+
+  // identifies the pool in the thread-local regions, changed by purge
+  std::atomic<uint64_t> pool_id;
+
+  // chunk that allocations are bumped from
+  std::atomic<ArenaChunk *> current_chunk;
+
+  // all chunks of the pool, including oversize ones
+  std::atomic<ArenaChunk *> chunk_list;
 
-  std::mutex pool_mutex;
+  std::atomic<int64_t> allocated_memory;
 };
 
 }  // End peloton namespace
@@ -50,6 +50,15 @@ typedef enum LayoutType {
   LAYOUT_TYPE_HYBRID = 3  /* Hybrid layout */
 } LayoutType;
 
+/* Encodings of the columns of frozen tile groups */
+enum ColumnEncodingType {
+  COLUMN_ENCODING_TYPE_INVALID = 0,
+  COLUMN_ENCODING_TYPE_PLAIN = 1,       /* Uncompressed values */
+  COLUMN_ENCODING_TYPE_BIT_PACKED = 2,  /* Frame of reference + bit-packing */
+  COLUMN_ENCODING_TYPE_DICTIONARY = 3,  /* Bit-packed dictionary codes */
+  COLUMN_ENCODING_TYPE_RUN_LENGTH = 4   /* Runs of equal values */
+};
+
 enum LoggerMappingStrategyType {
   LOGGER_MAPPING_TYPE_INVALID = 0,
   LOGGER_MAPPING_TYPE_ROUND_ROBIN = 1,
@@ -382,7 +391,8 @@ enum ExpressionType {
 
 enum ConcurrencyType {
   CONCURRENCY_TYPE_INVALID = 0,
-  CONCURRENCY_TYPE_TO = 4  // timestamp ordering
+  CONCURRENCY_TYPE_OPTIMISTIC = 1,  // optimistic multi-version
+  CONCURRENCY_TYPE_TO = 4           // timestamp ordering
 };
 
 //===--------------------------------------------------------------------===//
@@ -976,6 +986,9 @@ std::string LoggingStatusToString(LoggingStatus type);
 std::string LoggerTypeToString(LoggerType type);
 std::string LogRecordTypeToString(LogRecordType type);
 
+std::string ConcurrencyTypeToString(ConcurrencyType type);
+ConcurrencyType StringToConcurrencyType(const std::string &str);
+
 ValueType PostgresValueTypeToPelotonValueType(
     PostgresValueType PostgresValType);
 ConstraintType PostgresConstraintTypeToPelotonConstraintType(
@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// backoff.h
+//
+// Identification: src/include/concurrency/backoff.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <thread>
+
+namespace peloton {
+namespace concurrency {
+
+// Shortest and longest backoff (in us)
+#define BACKOFF_MIN_US 1
+#define BACKOFF_MAX_US 1000
+
+// Backoffs up to this long (in us) yield instead of sleeping
+#define BACKOFF_YIELD_US 10
+
+//===--------------------------------------------------------------------===//
+// Backoff
+//===--------------------------------------------------------------------===//
+
+/**
+ * Exponential backoff between attempts on contended data, either waiting
+ * for the owner of a version or retrying an aborted transaction.
+ * Every wait doubles the limit, and waits a random time up to it so that
+ * the contending threads do not retry in lockstep.
+ */
+class Backoff {
+ public:
+  Backoff(const uint64_t min_us = BACKOFF_MIN_US,
+          const uint64_t max_us = BACKOFF_MAX_US)
+      : min_us_(std::max(min_us, (uint64_t)1)),
+        max_us_(std::max(max_us, min_us_)),
+        limit_us_(min_us_),
+        wait_count_(0),
+        rng_(std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+             std::chrono::steady_clock::now().time_since_epoch().count()) {}
+
+  void Wait() {
+    auto wait_us = std::uniform_int_distribution<uint64_t>(
+        min_us_, limit_us_)(rng_);
+
+    if (wait_us <= BACKOFF_YIELD_US) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(wait_us));
+    }
+
+    limit_us_ = std::min(limit_us_ * 2, max_us_);
+    wait_count_++;
+  }
+
+  // Start over after a successful attempt
+  void Reset() {
+    limit_us_ = min_us_;
+    wait_count_ = 0;
+  }
+
+  size_t GetWaitCount() const { return wait_count_; }
+
+ private:
+  uint64_t min_us_;
+
+  uint64_t max_us_;
+
+  // longest next wait
+  uint64_t limit_us_;
+
+  // waits since the last reset
+  size_t wait_count_;
+
+  std::minstd_rand rng_;
+};
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -13,8 +13,8 @@
 
 #pragma once
 
+#include <atomic>
 #include <thread>
-#include <vector>
 
 #include "common/macros.h"
 #include "common/types.h"
@@ -23,204 +23,103 @@
 namespace peloton {
 namespace concurrency {
 
+// Longest time between two refreshes of the max dead txn cid (in ms)
 #define EPOCH_LENGTH 40
 
-struct Epoch {
-  std::atomic<int> txn_ref_count_;
-  cid_t max_cid_;
+// Shortest time between two refreshes of the max dead txn cid (in ms)
+#define EPOCH_MIN_LENGTH 1
 
-  Epoch() : txn_ref_count_(0), max_cid_(0) {}
+// Threads that can run transactions at the same time
+#define EPOCH_MAX_THREAD_COUNT 1024
 
-  void Init() {
-    txn_ref_count_ = 0;
-    max_cid_ = 0;
-  }
-};
+// Transactions running on a thread. Each slot is written by its thread only
+// and has its own cache line.
+struct EpochSlot {
+  // smallest begin cid of the running transactions, MAX_CID if none
+  std::atomic<cid_t> begin_cid_;
 
-class EpochManager {
- public:
-  EpochManager()
-      : epoch_queue_(epoch_queue_size_),
-        queue_tail_(0),
-        current_epoch_(0),
-        queue_tail_gc(true),
-        max_cid(0),
-        finish_(false) {
-    // ts_thread_.reset(new std::thread(&EpochManager::Start, this));
-    // ts_thread_->detach();
-    ts_thread_ = std::thread(&EpochManager::Start, this);
-  }
+  // largest begin cid of any transaction of the thread
+  std::atomic<cid_t> last_begin_cid_;
 
-  void Reset() {
-    finish_ = true;
-    ts_thread_.join();
+  // commit id whose writes the transaction of the thread is installing,
+  // INVALID_CID while it takes one, MAX_CID if none
+  std::atomic<cid_t> commit_cid_;
 
-    queue_tail_ = 0;
-    current_epoch_ = 0;
-    epoch_queue_[0].Init();
-    queue_tail_gc = true;
-    max_cid = 0;
+  std::atomic<bool> in_use_;
 
-    finish_ = false;
-    ts_thread_ = std::thread(&EpochManager::Start, this);
-  }
+  // running transactions, only read by the thread
+  size_t txn_count_;
 
-  ~EpochManager() {
-    finish_ = true;
-    ts_thread_.join();
-  }
+  EpochSlot()
+      : begin_cid_(MAX_CID), last_begin_cid_(0), commit_cid_(MAX_CID),
+        in_use_(false), txn_count_(0) {}
+} CACHE_ALIGNED;
 
-  //    static uint64_t GetEpoch() {
-  //
-  //      COMPILER_MEMORY_FENCE;
-  //
-  //      uint64_t ret_ts = curr_epoch_;
-  //
-  //      COMPILER_MEMORY_FENCE;
-  //
-  //      return ret_ts;
-  //    }
+/**
+ * Tracks the begin cids of the running transactions in per-thread slots.
+ *
+ * A background thread periodically computes the max dead txn cid from the
+ * slots. It refreshes it more often while transactions finish and less
+ * often while the system is idle, between EPOCH_MIN_LENGTH and
+ * peloton_epoch_length ms.
+ */
+class EpochManager {
+ public:
+  EpochManager();
 
-  size_t EnterEpoch(cid_t begin_cid) {
-    auto epoch = current_epoch_.load();
+  ~EpochManager();
 
-    size_t epoch_idx = epoch % epoch_queue_size_;
-    epoch_queue_[epoch_idx].txn_ref_count_++;
+  void Reset();
 
-    // Set the max cid in the tuple
-    auto max_cid_ptr = &(epoch_queue_[epoch_idx].max_cid_);
-    AtomicMax(max_cid_ptr, begin_cid);
+  // Register a transaction of the calling thread. Must be called before its
+  // begin cid is read, returns the epoch id of the transaction.
+  size_t EnterEpoch();
 
-    return epoch;
-  }
+  // Publish the begin cid of the transaction
+  void SetBeginCid(size_t epoch_id, cid_t begin_cid);
 
-  void ExitEpoch(size_t epoch) {
-    PL_ASSERT(epoch >= queue_tail_);
-    PL_ASSERT(epoch <= current_epoch_);
+  void ExitEpoch(size_t epoch_id);
 
-    auto epoch_idx = epoch % epoch_queue_size_;
+  // Publish that the transaction takes a commit id. Must be called before
+  // the commit id is taken.
+  void EnterCommit(size_t epoch_id);
 
-    epoch_queue_[epoch_idx].txn_ref_count_--;
-  }
-  // assume we store epoch_store max_store previously
-  cid_t GetMaxDeadTxnCid() {
-    // TODO:
-    // change to:
-    // increase tail
-    // return max
-    auto tail = queue_tail_.load();
-    auto head = current_epoch_.load();
-    if (head > 0) {
-      head--;
-    }
-    auto res = max_cid;
-
-    auto dead_num = 0;
-    while (tail < head) {
-      auto idx = tail % epoch_queue_size_;
-      // break when meeting running txn
-      if (epoch_queue_[idx].txn_ref_count_ > 0) {
-        break;
-      }
-
-      if (epoch_queue_[idx].max_cid_ > res) {
-        res = epoch_queue_[idx].max_cid_;
-      }
-      tail++;
-      dead_num++;
-    }
-    if (res > max_cid) {
-      AtomicMax(&max_cid, res);
-    }
-
-    if (dead_num > 32) {
-      IncreaseTail();
-    }
-    return max_cid;
-  }
+  // Publish the commit id whose writes the transaction installs
+  void SetCommitCid(size_t epoch_id, cid_t commit_cid);
 
- private:
-  void Start() {
-    while (!finish_) {
-      // the epoch advances every 40 milliseconds.
-      std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
-
-      auto next_idx = (current_epoch_.load() + 1) % epoch_queue_size_;
-      auto tail_idx = queue_tail_.load() % epoch_queue_size_;
-      if (next_idx == tail_idx) {
-        // overflow
-        // in this case, just increase tail
-        IncreaseTail();
-        continue;
-      }
-
-      // we have to init it first, then increase current epoch
-      // otherwise may read dirty data
-      epoch_queue_[next_idx].Init();
-      current_epoch_++;
-
-      IncreaseTail();
-    }
-  }
+  // Called once the transaction installed or rolled back its writes
+  void ExitCommit(size_t epoch_id);
 
-  void IncreaseTail() {
-    bool expect = true, desired = false;
-    if (!queue_tail_gc.compare_exchange_weak(expect, desired)) {
-      // someone now is increasing tail
-      return;
-    }
+  // Wait until every transaction that took a commit id up to the cid has
+  // installed or rolled back its writes
+  void WaitForCommits(cid_t cid);
 
-    auto current = current_epoch_.load();
-    auto tail = queue_tail_.load();
+  // Every transaction with a begin cid up to the max dead txn cid has
+  // finished, as has every transaction that took a commit id up to it.
+  // Running transactions began at or after it.
+  cid_t GetMaxDeadTxnCid() { return max_dead_cid_.load(); }
 
-    while (true) {
-      if (tail + 1 == current) {
-        break;
-      }
+  // Compute the max dead txn cid from the slots now
+  cid_t RefreshMaxDeadTxnCid();
 
-      auto idx = tail % epoch_queue_size_;
+ private:
+  void Start();
 
-      // inc tail until we find an epoch that has running txn
-      if (epoch_queue_[idx].txn_ref_count_ > 0) {
-        break;
-      }
+  size_t AcquireSlot();
 
-      // save max cid
-      auto max = epoch_queue_[idx].max_cid_;
-      AtomicMax(&max_cid, max);
-      tail++;
-    }
+  void ReleaseSlot(size_t slot_id);
 
-    queue_tail_ = tail;
+  friend struct EpochSlotHolder;
 
-    expect = false;
-    desired = true;
+ private:
+  // thread slots
+  EpochSlot slots_[EPOCH_MAX_THREAD_COUNT];
 
-    queue_tail_gc.compare_exchange_weak(expect, desired);
-    return;
-  }
+  // slots ever acquired
+  std::atomic<size_t> slot_count_;
 
-  void AtomicMax(cid_t* addr, cid_t max) {
-    while (true) {
-      auto old = *addr;
-      if (old > max) {
-        return;
-      } else if (__sync_bool_compare_and_swap(addr, old, max)) {
-        return;
-      }
-    }
-  }
+  std::atomic<cid_t> max_dead_cid_;
 
- private:
-  // queue size
-  static const size_t epoch_queue_size_ = 2048;
-
-  // Epoch vector
-  std::vector<Epoch> epoch_queue_;
-  std::atomic<size_t> queue_tail_;
-  std::atomic<size_t> current_epoch_;
-  std::atomic<bool> queue_tail_gc;
-  cid_t max_cid;
   bool finish_;
 
   std::thread ts_thread_;
@@ -13,8 +13,7 @@
 
 #pragma once
 
-#include "concurrency/transaction_manager.h"
-#include "storage/tile_group.h"
+#include "concurrency/ts_order_txn_manager.h"
 
 namespace peloton {
 namespace concurrency {
@@ -23,7 +22,11 @@ namespace concurrency {
 // optimistic concurrency control
 //===--------------------------------------------------------------------===//
 
-class OptimisticTxnManager : public TransactionManager {
+// Reads, visibility and the backward validation at commit are the same as
+// in timestamp ordering. A write to a version owned by a running
+// transaction waits for it instead of aborting, and fails only if the
+// owner commits (first committer wins).
+class OptimisticTxnManager : public TsOrderTxnManager {
  public:
   OptimisticTxnManager() {}
 
@@ -31,13 +34,6 @@ class OptimisticTxnManager : public TransactionManager {
 
   static OptimisticTxnManager &GetInstance();
 
-  virtual bool IsVisible(
-      const storage::TileGroupHeader *const tile_group_header,
-      const oid_t &tuple_id);
-
-  virtual bool IsOwner(const storage::TileGroupHeader *const tile_group_header,
-                       const oid_t &tuple_id);
-
   virtual bool IsOwnable(
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id);
@@ -46,43 +42,7 @@ class OptimisticTxnManager : public TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tile_group_id, const oid_t &tuple_id);
 
-  virtual bool PerformInsert(const ItemPointer &location);
-
-  virtual bool PerformRead(const ItemPointer &location);
-
-  virtual void PerformUpdate(const ItemPointer &old_location,
-                             const ItemPointer &new_location);
-
-  virtual void PerformDelete(const ItemPointer &old_location,
-                             const ItemPointer &new_location);
-
-  virtual void PerformUpdate(const ItemPointer &location);
-
-  virtual void PerformDelete(const ItemPointer &location);
-
-  virtual Result CommitTransaction();
-
-  virtual Result AbortTransaction();
-
-  virtual Transaction *BeginTransaction() {
-    txn_id_t txn_id = GetNextTransactionId();
-    cid_t begin_cid = GetNextCommitId();
-    Transaction *txn = new Transaction(txn_id, begin_cid);
-
-    auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
-    txn->SetEpochId(eid);
-
-    current_txn = txn;
-
-    return txn;
-  }
-
-  virtual void EndTransaction() {
-    EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId());
-
-    delete current_txn;
-    current_txn = nullptr;
-  }
+  virtual int GetOwnershipWait();
 };
 }
 }
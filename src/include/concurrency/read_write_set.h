@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.h
+//
+// Identification: src/include/concurrency/read_write_set.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/types.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// Read Write Set
+//===--------------------------------------------------------------------===//
+
+enum RWType {
+  RW_TYPE_READ,
+  RW_TYPE_UPDATE,
+  RW_TYPE_INSERT,
+  RW_TYPE_DELETE,
+  RW_TYPE_INS_DEL  // delete after insert.
+};
+
+struct RWSetEntry {
+  ItemPointer location;
+  RWType type;
+};
+
+// Tuple slots [begin_tuple_id, end_tuple_id) of a tile group read by a scan
+// at the begin commit id of the transaction.
+struct ScanSetEntry {
+  oid_t tile_group_id;
+  oid_t begin_tuple_id;
+  oid_t end_tuple_id;
+};
+
+/**
+ * Tuples accessed by a transaction, in the order they were first accessed,
+ * and the slot ranges read by its scans.
+ *
+ * Entries are appended to a flat array and found through an open-addressing
+ * index of entry offsets, so recording an access does not allocate once the
+ * arrays are large enough. Cleared sets are cached per thread and handed to
+ * the next transaction, which keeps their capacity.
+ */
+class ReadWriteSet {
+  ReadWriteSet(ReadWriteSet const &) = delete;
+
+ public:
+  typedef std::vector<RWSetEntry>::const_iterator const_iterator;
+
+  ReadWriteSet();
+
+  // Get a cleared set, reusing one released on this thread if possible
+  static std::unique_ptr<ReadWriteSet> Acquire();
+
+  // Clear the set and keep it for the next transaction on this thread
+  static void Release(std::unique_ptr<ReadWriteSet> rw_set);
+
+  // Returns nullptr if the location is not in the set
+  RWType *Find(const ItemPointer &location);
+
+  // The location must not be in the set
+  void Insert(const ItemPointer &location, const RWType &type);
+
+  // Record a scanned slot range, merged with the last range recorded for the
+  // tile group if they touch
+  void InsertScan(const oid_t &tile_group_id, const oid_t &begin_tuple_id,
+                  const oid_t &end_tuple_id);
+
+  const std::vector<ScanSetEntry> &GetScans() const { return scans; }
+
+  void Clear();
+
+  size_t GetSize() const { return entries.size(); }
+
+  bool IsEmpty() const { return entries.empty(); }
+
+  const_iterator begin() const { return entries.begin(); }
+
+  const_iterator end() const { return entries.end(); }
+
+ private:
+  size_t GetSlot(const ItemPointer &location) const;
+
+  void Grow();
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+
+  // accessed tuples in access order
+  std::vector<RWSetEntry> entries;
+
+  // offset of the entry plus one, 0 if the slot is empty.
+  // the slot count is a power of two and at least twice the entry count.
+  std::vector<uint32_t> slots;
+
+  // slot ranges read by scans in scan order
+  std::vector<ScanSetEntry> scans;
+
+  // offset of the last range of each scanned tile group
+  std::unordered_map<oid_t, size_t> last_scans;
+};
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -15,6 +15,8 @@
 
 #include <mutex>
 #include <atomic>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -23,22 +25,19 @@
 #include "common/printable.h"
 #include "common/types.h"
 #include "common/exception.h"
+#include "concurrency/read_write_set.h"
+#include "storage/rollback_segment.h"
 
 namespace peloton {
 namespace concurrency {
 
+// Acknowledges a commit once it is durable, gets the commit id
+typedef std::function<void(cid_t)> CommitCallback;
+
 //===--------------------------------------------------------------------===//
 // Transaction
 //===--------------------------------------------------------------------===//
 
-enum RWType {
-  RW_TYPE_READ,
-  RW_TYPE_UPDATE,
-  RW_TYPE_INSERT,
-  RW_TYPE_DELETE,
-  RW_TYPE_INS_DEL  // delete after insert.
-};
-
 class Transaction : public Printable {
   Transaction(Transaction const &) = delete;
 
@@ -47,24 +46,38 @@ class Transaction : public Printable {
       : txn_id_(INVALID_TXN_ID),
         begin_cid_(INVALID_CID),
         end_cid_(MAX_CID),
+        rw_set_(ReadWriteSet::Acquire()),
         is_written_(false),
-        insert_count_(0) {}
+        insert_count_(0),
+        is_snapshot_read_(false) {}
 
   Transaction(const txn_id_t &txn_id)
       : txn_id_(txn_id),
         begin_cid_(INVALID_CID),
         end_cid_(MAX_CID),
+        rw_set_(ReadWriteSet::Acquire()),
         is_written_(false),
-        insert_count_(0) {}
+        insert_count_(0),
+        is_snapshot_read_(false) {}
 
-  Transaction(const txn_id_t &txn_id, const cid_t &begin_cid)
+  Transaction(const txn_id_t &txn_id, const cid_t &begin_cid,
+              const bool snapshot_read = false)
       : txn_id_(txn_id),
         begin_cid_(begin_cid),
         end_cid_(MAX_CID),
+        rw_set_(ReadWriteSet::Acquire()),
         is_written_(false),
-        insert_count_(0) {}
+        insert_count_(0),
+        is_snapshot_read_(snapshot_read) {}
+
+  ~Transaction() { ReadWriteSet::Release(std::move(rw_set_)); }
+
+  // Get a transaction, reusing the one released last on this thread
+  static Transaction *Acquire(const txn_id_t &txn_id, const cid_t &begin_cid,
+                              const bool snapshot_read = false);
 
-  ~Transaction() {}
+  // Keep the transaction for the next one on this thread
+  static void Release(Transaction *txn);
 
   //===--------------------------------------------------------------------===//
   // Mutators and Accessors
@@ -84,6 +97,10 @@ class Transaction : public Printable {
 
   void RecordRead(const ItemPointer &);
 
+  // Record a read of the visible versions in a slot range of a tile group
+  void RecordScan(const oid_t &tile_group_id, const oid_t &begin_tuple_id,
+                  const oid_t &end_tuple_id);
+
   void RecordUpdate(const ItemPointer &);
 
   void RecordInsert(const ItemPointer &);
@@ -91,7 +108,7 @@ class Transaction : public Printable {
   // Return true if we detect INS_DEL
   bool RecordDelete(const ItemPointer &);
 
-  const std::map<oid_t, std::map<oid_t, RWType>> &GetRWSet();
+  const ReadWriteSet &GetRWSet();
 
   // Get a string representation for debugging
   const std::string GetInfo() const;
@@ -106,6 +123,29 @@ class Transaction : public Printable {
     return is_written_ == false && insert_count_ == 0;
   }
 
+  // Snapshot reads do not write, record no reads and are never validated
+  inline bool IsSnapshotRead() const { return is_snapshot_read_; }
+
+  // With a commit callback, the commit returns before it is durable and the
+  // frontend logger runs the callback once it is flushed
+  inline void SetCommitCallback(CommitCallback callback) {
+    commit_callback_ = std::move(callback);
+  }
+
+  inline const CommitCallback &GetCommitCallback() const {
+    return commit_callback_;
+  }
+
+  // Before-images of the versions updated in place, allocated on first use
+  storage::RollbackSegmentPool *GetRollbackSegmentPool();
+
+  // Running transactions may still read the before-images after the
+  // transaction ends, so the pool is handed over to the transaction manager
+  inline std::unique_ptr<storage::RollbackSegmentPool>
+  ReleaseRollbackSegmentPool() {
+    return std::move(rb_seg_pool_);
+  }
+
  private:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -123,13 +163,23 @@ class Transaction : public Printable {
   // epoch id
   size_t epoch_id_;
 
-  std::map<oid_t, std::map<oid_t, RWType>> rw_set_;
+  // tuples read or written by the transaction
+  std::unique_ptr<ReadWriteSet> rw_set_;
 
   // result of the transaction
   Result result_ = peloton::RESULT_SUCCESS;
 
   bool is_written_;
   size_t insert_count_;
+
+  // declared read-only, reads a committed snapshot
+  bool is_snapshot_read_;
+
+  // acknowledges an asynchronous commit
+  CommitCallback commit_callback_;
+
+  // rollback segments of the updates in place
+  std::unique_ptr<storage::RollbackSegmentPool> rb_seg_pool_;
 };
 
 }  // End concurrency namespace
@@ -17,6 +17,7 @@
 #include <unordered_map>
 #include <list>
 #include <utility>
+#include <vector>
 
 #include "storage/tile_group_header.h"
 #include "concurrency/transaction.h"
@@ -29,9 +30,12 @@
 namespace peloton {
 
 class ItemPointer;
+class VarlenPool;
 
 namespace storage {
 class DataTable;
+class TileGroup;
+class Tuple;
 }
 
 namespace concurrency {
@@ -42,18 +46,26 @@ extern thread_local Transaction *current_txn;
 
 #define RUNNING_TXN_BUCKET_NUM 10
 
+// Transaction ids a thread takes from the shared counter at a time
+#define TXN_ID_LEASE_SIZE 64
+
 class TransactionManager {
  public:
   TransactionManager() {
     next_txn_id_ = ATOMIC_VAR_INIT(START_TXN_ID);
+    txn_id_generation_ = ATOMIC_VAR_INIT(0);
     next_cid_ = ATOMIC_VAR_INIT(START_CID);
     maximum_grant_cid_ = ATOMIC_VAR_INIT(MAX_CID);
   }
 
   virtual ~TransactionManager() {}
 
-  txn_id_t GetNextTransactionId() { return next_txn_id_++; }
+  // Each thread hands out ids from a block it leased from the shared
+  // counter. Ids are unique, but their order only approximates the order in
+  // which transactions began, e.g. for the ages used by wait-die.
+  txn_id_t GetNextTransactionId();
 
+  // Only transactions that write take a commit id.
   cid_t GetNextCommitId() {
     cid_t temp_cid = next_cid_++;
     // wait if we do not yet have a grant for this commit id
@@ -64,12 +76,43 @@ class TransactionManager {
 
   cid_t GetCurrentCommitId() { return next_cid_.load(); }
 
+  // The last commit id handed out. A transaction that begins at it sees the
+  // commits up to it without taking a commit id of its own. Every commit id
+  // handed out later is larger.
+  cid_t GetLastCommitId() { return next_cid_.load() - 1; }
+
   bool IsOccupied(const ItemPointer &position);
 
   virtual bool IsVisible(
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id) = 0;
 
+  // Copy the version of a tuple that is visible to the transaction. When the
+  // tuple itself is not, the before-images kept by updates in place are
+  // applied. Uninlined values are allocated from pool. Returns false if no
+  // version is visible.
+  virtual bool ReadVersion(storage::TileGroup *tile_group,
+                           const oid_t &tuple_id, storage::Tuple *tuple,
+                           VarlenPool *pool) = 0;
+
+  // Read the version of a tuple that was committed as of the read cid,
+  // outside of a transaction. The caller must hold an epoch that began at or
+  // before the read cid, so that the before-images are not freed. Returns
+  // false if no version was committed then.
+  virtual bool ReadCommittedVersion(storage::TileGroup *tile_group,
+                                    const oid_t &tuple_id,
+                                    const cid_t &read_cid,
+                                    storage::Tuple *tuple,
+                                    VarlenPool *pool) = 0;
+
+  // Append the ids of the visible tuples in [begin_tuple_id, end_tuple_id)
+  // to visible_tuple_ids. Used by sequential scans to check a whole tile
+  // group in one call.
+  virtual void IsVisibleBatch(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &begin_tuple_id, const oid_t &end_tuple_id,
+      std::vector<oid_t> &visible_tuple_ids);
+
   virtual bool IsOwner(const storage::TileGroupHeader *const tile_group_header,
                        const oid_t &tuple_id) = 0;
 
@@ -77,14 +120,32 @@ class TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id) = 0;
 
+  // Returns true if the transaction owns a committed version that it updated
+  // in place, rather than a version it created.
+  virtual bool IsUpdatedInPlace(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id) = 0;
+
   virtual bool AcquireOwnership(
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tile_group_id, const oid_t &tuple_id) = 0;
 
+  // Longest time (in us) AcquireOwnership() waits for the owner of a
+  // version under the configured ownership wait, 0 if it fails at once.
+  virtual int GetOwnershipWait() = 0;
+
   virtual bool PerformInsert(const ItemPointer &location) = 0;
 
   virtual bool PerformRead(const ItemPointer &location) = 0;
 
+  // Record the read of the visible tuples of a tile group returned by a
+  // scan. Owned tells whether a tuple of the tile group was owned before
+  // their visibility was checked. Protocols that validate reads per tuple
+  // read each of them.
+  virtual bool PerformScan(const oid_t &tile_group_id,
+                           const std::vector<oid_t> &tuple_ids,
+                           const bool owned);
+
   virtual void PerformUpdate(const ItemPointer &old_location,
                              const ItemPointer &new_location) = 0;
 
@@ -95,6 +156,11 @@ class TransactionManager {
 
   virtual void PerformDelete(const ItemPointer &location) = 0;
 
+  // Update the version owned by the transaction in place. Called before the
+  // target columns are written, to keep their before-image.
+  virtual void PerformInplaceUpdate(const ItemPointer &location,
+                                    const TargetList &target_list) = 0;
+
   // Txn manager may store related information in TileGroupHeader, so when
   // TileGroup is dropped, txn manager might need to be notified
   virtual void DroppingTileGroup(const oid_t &tile_group_id UNUSED_ATTRIBUTE) {
@@ -110,7 +176,9 @@ class TransactionManager {
 
   void SetMaxGrantCid(cid_t cid) { maximum_grant_cid_ = cid; }
 
-  virtual Transaction *BeginTransaction() = 0;
+  // A snapshot read transaction reads the writes of every transaction that
+  // committed before it began, and may not write.
+  virtual Transaction *BeginTransaction(const bool snapshot_read = false) = 0;
 
   virtual void EndTransaction() = 0;
 
@@ -120,6 +188,8 @@ class TransactionManager {
 
   void ResetStates() {
     next_txn_id_ = START_TXN_ID;
+    // leased ids are no longer unique
+    txn_id_generation_++;
     next_cid_ = START_CID;
   }
 
@@ -145,6 +215,7 @@ class TransactionManager {
 
  private:
   std::atomic<txn_id_t> next_txn_id_;
+  std::atomic<size_t> txn_id_generation_;
   std::atomic<cid_t> next_cid_;
   std::atomic<cid_t> maximum_grant_cid_;
 };
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "concurrency/optimistic_txn_manager.h"
 #include "concurrency/ts_order_txn_manager.h"
 
 namespace peloton {
@@ -22,6 +23,9 @@ class TransactionManagerFactory {
   static TransactionManager &GetInstance() {
     switch (protocol_) {
 
+      case CONCURRENCY_TYPE_OPTIMISTIC:
+        return OptimisticTxnManager::GetInstance();
+
       case CONCURRENCY_TYPE_TO:
         return TsOrderTxnManager::GetInstance();
 
@@ -32,8 +36,14 @@ class TransactionManagerFactory {
 
   static void Configure(ConcurrencyType protocol,
                         IsolationLevelType level = ISOLATION_LEVEL_TYPE_FULL) {
+    // versions and epochs compare commit ids of every manager, so they keep
+    // increasing when the protocol changes.
+    cid_t next_cid = GetInstance().GetCurrentCommitId();
     protocol_ = protocol;
     isolation_level_ = level;
+    if (GetInstance().GetCurrentCommitId() < next_cid) {
+      GetInstance().SetNextCid(next_cid);
+    }
   }
 
   static ConcurrencyType GetProtocol() { return protocol_; }
@@ -13,7 +13,10 @@
 
 #pragma once
 
+#include <deque>
+
 #include "concurrency/transaction_manager.h"
+#include "storage/rollback_segment.h"
 #include "storage/tile_group.h"
 
 namespace peloton {
@@ -35,6 +38,20 @@ class TsOrderTxnManager : public TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id);
 
+  virtual void IsVisibleBatch(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &begin_tuple_id, const oid_t &end_tuple_id,
+      std::vector<oid_t> &visible_tuple_ids);
+
+  virtual bool ReadVersion(storage::TileGroup *tile_group,
+                           const oid_t &tuple_id, storage::Tuple *tuple,
+                           VarlenPool *pool);
+
+  virtual bool ReadCommittedVersion(storage::TileGroup *tile_group,
+                                    const oid_t &tuple_id,
+                                    const cid_t &read_cid,
+                                    storage::Tuple *tuple, VarlenPool *pool);
+
   virtual bool IsOwner(const storage::TileGroupHeader *const tile_group_header,
                        const oid_t &tuple_id);
 
@@ -42,14 +59,24 @@ class TsOrderTxnManager : public TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id);
 
+  virtual bool IsUpdatedInPlace(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
   virtual bool AcquireOwnership(
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tile_group_id, const oid_t &tuple_id);
 
+  virtual int GetOwnershipWait();
+
   virtual bool PerformInsert(const ItemPointer &location);
 
   virtual bool PerformRead(const ItemPointer &location);
 
+  virtual bool PerformScan(const oid_t &tile_group_id,
+                           const std::vector<oid_t> &tuple_ids,
+                           const bool owned);
+
   virtual void PerformUpdate(const ItemPointer &old_location,
                              const ItemPointer &new_location);
 
@@ -60,30 +87,84 @@ class TsOrderTxnManager : public TransactionManager {
 
   virtual void PerformDelete(const ItemPointer &location);
 
+  virtual void PerformInplaceUpdate(const ItemPointer &location,
+                                    const TargetList &target_list);
+
   virtual Result CommitTransaction();
 
   virtual Result AbortTransaction();
 
-  virtual Transaction *BeginTransaction() {
+  virtual Transaction *BeginTransaction(const bool snapshot_read = false) {
     txn_id_t txn_id = GetNextTransactionId();
-    cid_t begin_cid = GetNextCommitId();
-    Transaction *txn = new Transaction(txn_id, begin_cid);
-    current_txn = txn;
+    auto &epoch_manager = EpochManagerFactory::GetInstance();
+    // enter the epoch before reading the begin cid, so the versions the
+    // transaction can read are not reclaimed in between.
+    auto eid = epoch_manager.EnterEpoch();
+
+    cid_t begin_cid = GetLastCommitId();
+    epoch_manager.SetBeginCid(eid, begin_cid);
+
+    // a snapshot read is not validated, so it reads once every transaction
+    // with a commit id up to its begin cid has installed its writes.
+    if (snapshot_read == true) {
+      epoch_manager.WaitForCommits(begin_cid);
+    }
 
-    auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
+    Transaction *txn = Transaction::Acquire(txn_id, begin_cid, snapshot_read);
     txn->SetEpochId(eid);
+    current_txn = txn;
 
     return txn;
   }
 
   virtual void EndTransaction() {
+    auto rb_seg_pool = current_txn->ReleaseRollbackSegmentPool();
+    if (rb_seg_pool != nullptr) {
+      RetireRollbackSegmentPool(std::move(rb_seg_pool));
+    }
+
     EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId());
 
-    delete current_txn;
+    Transaction::Release(current_txn);
     current_txn = nullptr;
   }
 
+ protected:
+  // Own the version, waiting up to wait_us for its current owner to release
+  // it. With wait_die, only transactions with a smaller id than the owner
+  // wait, so no two transactions wait for each other. Ids only approximate
+  // the age of a transaction since they are leased to threads in blocks.
+  bool AcquireVersion(const storage::TileGroupHeader *const tile_group_header,
+                      const oid_t &tile_group_id, const oid_t &tuple_id,
+                      const uint64_t wait_us, const bool wait_die);
+
  private:
+  bool ValidateScan(const ScanSetEntry &scan, const cid_t &commit_id);
+
+  // Copy the tuple, applying its rollback segments up to the first one that
+  // began at or before the read cid, which makes it visible. Returns false
+  // if the tuple changed since its header fields were read.
+  bool CopyVersion(storage::TileGroup *tile_group, const oid_t &tuple_id,
+                   const txn_id_t &tuple_txn_id, const cid_t &tuple_begin_cid,
+                   char *tuple_rb_seg, const cid_t &read_cid, bool &visible,
+                   storage::Tuple *tuple, VarlenPool *pool);
+
+  // Returns true if a version that was visible at begin_cid was overwritten
+  // by an update in place.
+  bool IsOverwrittenInPlace(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id, const cid_t &begin_cid);
+
+  // Write back the before-images of the updates in place of the transaction,
+  // restoring the committed version it acquired.
+  void UndoInplaceUpdate(storage::TileGroup *tile_group,
+                         const oid_t &tuple_id);
+
+  // Free the rollback segments of a finished transaction once no running
+  // transaction can read them.
+  void RetireRollbackSegmentPool(
+      std::unique_ptr<storage::RollbackSegmentPool> rb_seg_pool);
+
   inline cid_t GetLastReaderCid(
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id) {
@@ -103,6 +184,27 @@ class TsOrderTxnManager : public TransactionManager {
       PL_MEMCPY(reserved_field, &last_read_ts, sizeof(cid_t));
     }
   }
+
+  // the newest before-image of the tuple follows the last reader cid in the
+  // reserved field.
+  inline char *GetRollbackSegment(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id) {
+    char *reserved_field = tile_group_header->GetReservedFieldRef(tuple_id);
+    return *(reinterpret_cast<char **>(reserved_field + sizeof(cid_t)));
+  }
+
+  inline void SetRollbackSegment(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id, const char *rb_seg) {
+    char *reserved_field = tile_group_header->GetReservedFieldRef(tuple_id);
+    *(reinterpret_cast<const char **>(reserved_field + sizeof(cid_t))) = rb_seg;
+  }
+
+  // rollback segment pools of finished transactions, oldest first
+  std::deque<std::unique_ptr<storage::RollbackSegmentPool>> retired_pools_;
+
+  Spinlock retired_pools_lock_;
 };
 }
 }
@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// append_only_array.h
+//
+// Identification: src/include/container/append_only_array.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include <cstdlib>
+#include <array>
+#include <atomic>
+
+namespace peloton {
+
+#define APPEND_ONLY_ARRAY_CHUNK_SIZE 1024
+
+#define APPEND_ONLY_ARRAY_MAX_CHUNK_COUNT 1024
+
+#define APPEND_ONLY_ARRAY_MAX_SIZE \
+  (APPEND_ONLY_ARRAY_CHUNK_SIZE * APPEND_ONLY_ARRAY_MAX_CHUNK_COUNT)
+
+// APPEND_ONLY_ARRAY_TEMPLATE_ARGUMENTS
+#define APPEND_ONLY_ARRAY_TEMPLATE_ARGUMENTS template <typename ValueType>
+
+// APPEND_ONLY_ARRAY_TYPE
+#define APPEND_ONLY_ARRAY_TYPE AppendOnlyArray<ValueType>
+
+/**
+ * Append-only array with lock-free readers.
+ *
+ * Items live in fixed-size chunks that are allocated on demand, so an item
+ * never moves once it is appended. Appenders reserve an offset, write the
+ * item and then publish it in offset order. Readers only load the published
+ * size, so GetSize() and Find() take no lock.
+ */
+APPEND_ONLY_ARRAY_TEMPLATE_ARGUMENTS
+class AppendOnlyArray {
+ public:
+  AppendOnlyArray(AppendOnlyArray const &) = delete;
+  AppendOnlyArray &operator=(AppendOnlyArray const &) = delete;
+
+  AppendOnlyArray();
+  ~AppendOnlyArray();
+
+  // Append an item
+  bool Append(const ValueType &value);
+
+  // Get a published item
+  ValueType Find(const std::size_t &offset) const;
+
+  // Returns published item count in the array
+  size_t GetSize() const;
+
+  // Checks if the array is empty
+  bool IsEmpty() const;
+
+  // Drop all items. Not safe against concurrent appends.
+  void Clear();
+
+  // Exists ?
+  bool Contains(const ValueType &value) const;
+
+ private:
+  // chunk type
+  typedef std::array<ValueType, APPEND_ONLY_ARRAY_CHUNK_SIZE> chunk_t;
+
+  // next offset handed out to an appender
+  std::atomic<std::size_t> reserved_size{0};
+
+  // all items below this offset are visible to readers
+  std::atomic<std::size_t> published_size{0};
+
+  // chunk directory
+  std::atomic<chunk_t *> chunks[APPEND_ONLY_ARRAY_MAX_CHUNK_COUNT];
+};
+
+}  // namespace peloton
@@ -18,8 +18,16 @@
 #include "executor/abstract_executor.h"
 
 namespace peloton {
+
+namespace storage {
+class TileGroup;
+class Tuple;
+}
+
 namespace executor {
 
+class LogicalTile;
+
 /**
  * Super class for different kinds of scan executor.
  * It provides common codes for all kinds of scan:
@@ -40,6 +48,16 @@ class AbstractScanExecutor : public AbstractExecutor {
 
   virtual bool DExecute() = 0;
 
+  /**
+   * @brief Copy the versions of the given tuples that are visible to the
+   * transaction, rebuilding those updated in place after it began, and apply
+   * the predicate to them.
+   * @return A logical tile of the columns to scan, or nullptr if no version
+   * is visible.
+   */
+  LogicalTile *ReadVersions(storage::TileGroup *tile_group,
+                            const std::vector<oid_t> &tuple_ids);
+
  protected:
   //===--------------------------------------------------------------------===//
   // Plan Info
@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "common/pool.h"
 
 namespace peloton {
@@ -43,6 +46,14 @@ class ExecutorContext {
 
   ~ExecutorContext();
 
+  // Get a context, reusing the one released last on this thread
+  static ExecutorContext *Acquire(concurrency::Transaction *transaction,
+                                  const std::vector<Value> &params);
+
+  // Keep the context, with its params and pool, for the next statement on
+  // this thread
+  static void Release(ExecutorContext *executor_context);
+
   concurrency::Transaction *GetTransaction() const;
 
   const std::vector<Value> &GetParams() const;
@@ -73,5 +84,15 @@ class ExecutorContext {
 
 };
 
+// Releases the context when the statement is done
+struct ExecutorContextReleaser {
+  void operator()(ExecutorContext *executor_context) const {
+    ExecutorContext::Release(executor_context);
+  }
+};
+
+typedef std::unique_ptr<ExecutorContext, ExecutorContextReleaser>
+    PooledExecutorContext;
+
 }  // namespace executor
 }  // namespace peloton
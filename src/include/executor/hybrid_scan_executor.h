@@ -79,6 +79,10 @@ class HybridScanExecutor : public AbstractScanExecutor {
   /** @brief Computed the result */
   bool index_done_ = false;
 
+  /** @brief Versions read from rollback segments, output after the tuples
+   * of their tile group. */
+  std::unique_ptr<LogicalTile> pending_output_;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
@@ -86,6 +90,12 @@ class HybridScanExecutor : public AbstractScanExecutor {
 
   std::vector<peloton::Value> values_;
 
+  /** @brief Whether the scan keys are "==" on the full index key. */
+  bool point_query_ = false;
+
+  /** @brief Values of the key columns for a point query. */
+  std::vector<peloton::Value> point_key_values_;
+
   std::vector<oid_t> full_column_ids_;
 
   bool key_ready_ = false;
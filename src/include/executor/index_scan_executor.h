@@ -47,6 +47,7 @@ class IndexScanExecutor : public AbstractScanExecutor {
   //===--------------------------------------------------------------------===//
   bool ExecPrimaryIndexLookup();
   bool ExecSecondaryIndexLookup();
+  void ScanKeyBatch(std::vector<ItemPointer> &tuple_locations);
 
   //===--------------------------------------------------------------------===//
   // Executor State
@@ -72,6 +73,15 @@ class IndexScanExecutor : public AbstractScanExecutor {
 
   std::vector<peloton::Value> values_;
 
+  /** @brief Whether the scan keys are "==" on the full index key. */
+  bool point_query_ = false;
+
+  /** @brief Values of the key columns for a point query. */
+  std::vector<peloton::Value> point_key_values_;
+
+  /** @brief Values of the key columns of each key of an IN-list. */
+  std::vector<std::vector<peloton::Value>> batch_key_values_;
+
   std::vector<oid_t> full_column_ids_;
 
   bool key_ready_ = false;
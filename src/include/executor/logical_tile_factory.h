@@ -42,6 +42,10 @@ class LogicalTileFactory {
 
   static LogicalTile *WrapTileGroup(
       const std::shared_ptr<storage::TileGroup> &tile_group);
+
+  static LogicalTile *CopyTuples(storage::TileGroup *tile_group,
+                                 const std::vector<oid_t> &tuple_ids,
+                                 const std::vector<oid_t> &column_ids);
 };
 
 }  // namespace executor
@@ -15,6 +15,7 @@
 
 #include "planner/seq_scan_plan.h"
 #include "executor/abstract_scan_executor.h"
+#include "executor/logical_tile.h"
 
 namespace peloton {
 namespace executor {
@@ -45,6 +46,10 @@ class SeqScanExecutor : public AbstractScanExecutor {
   /** @brief Keeps track of the number of tile groups to scan. */
   oid_t table_tile_group_count_ = INVALID_OID;
 
+  /** @brief Versions read from rollback segments, output after the tuples
+   * of their tile group. */
+  std::unique_ptr<LogicalTile> pending_output_;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
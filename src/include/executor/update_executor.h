@@ -39,9 +39,16 @@ class UpdateExecutor : public AbstractExecutor {
 
   void InplaceUpdate(storage::TileGroup *tile_group, ItemPointer location);
 
+  void UpdateColumns(storage::TileGroup *tile_group, ItemPointer location);
+
+  bool UpdateVersion(storage::TileGroup *tile_group, ItemPointer location);
+
  private:
   storage::DataTable *target_table_ = nullptr;
   const planner::ProjectInfo *project_info_ = nullptr;
+
+  // no index key column is updated, so the tuples are updated in place.
+  bool update_in_place_ = false;
 };
 
 }  // namespace executor
@@ -557,6 +557,20 @@ class BwTree {
     return value_eq_obj(v1, v2);
   }
 
+  /*
+   * enum class SearchMode - Which leaf page a traversal looks for
+   *
+   * AtKey looks for the page whose range contains the search key. BeforeKey
+   * looks for the page holding the keys right before the search key, i.e.
+   * low key < search key <= high key. Last looks for the rightmost page and
+   * ignores the search key. The latter two are used by ReverseIterator
+   */
+  enum class SearchMode {
+    AtKey = 0,
+    BeforeKey,
+    Last,
+  };
+
   /*
    * class Context - Stores per thread context data that is used during
    *                 tree traversal
@@ -570,6 +584,9 @@ class BwTree {
     // inside the context object
     const KeyType search_key;
 
+    // How the search key is used to locate the leaf page
+    const SearchMode search_mode;
+
     // We only need to keep current snapshot and parent snapshot
     NodeSnapshot current_snapshot;
     NodeSnapshot parent_snapshot;
@@ -597,7 +614,8 @@ class BwTree {
     /*
      * Constructor - Initialize a context object into initial state
      */
-    inline Context(const KeyType &p_search_key) :
+    inline Context(const KeyType &p_search_key,
+                   SearchMode p_search_mode = SearchMode::AtKey) :
       #ifdef BWTREE_PELOTON
 
       // Because earlier versions of g++ does not support
@@ -609,6 +627,8 @@ class BwTree {
       search_key{p_search_key},
 
       #endif
+
+      search_mode{p_search_mode},
       
       #ifdef BWTREE_DEBUG
       
@@ -2336,6 +2356,26 @@ abort_traverse:
   // Data Storage Core
   ///////////////////////////////////////////////////////////////////
   
+  /*
+   * SearchKeyGreaterEqual() - Returns true if the traversal should go to the
+   *                           right of a separator key
+   *
+   * For SearchMode::AtKey this is search key >= key. For BeforeKey the keys
+   * right before the search key are still on the left of a separator equal
+   * to it, so this is search key > key. For Last it is always true
+   */
+  inline bool SearchKeyGreaterEqual(const Context *context_p,
+                                    const KeyType &key) const {
+    switch(context_p->search_mode) {
+      case SearchMode::AtKey:
+        return KeyCmpGreaterEqual(context_p->search_key, key);
+      case SearchMode::BeforeKey:
+        return KeyCmpGreater(context_p->search_key, key);
+      default:
+        return true;
+    }
+  }
+
   /*
    * NavigateSiblingChain() - Traverse on sibling chain to adjust current
    *                          position so that the range of the node matches
@@ -2371,7 +2411,7 @@ abort_traverse:
       // the high key of split node will be inherited by all nodes
       // posted later and by the consolidated version of the node
       if((node_p->GetNextNodeID() != INVALID_NODE_ID) &&
-         (KeyCmpGreaterEqual(context_p->search_key, node_p->GetHighKey()))) {
+         (SearchKeyGreaterEqual(context_p, node_p->GetHighKey()))) {
         bwt_printf("Bounds checking failed (id = %lu) - "
                    "Go right.\n",
                    snapshot_p->node_id);
@@ -2420,6 +2460,36 @@ abort_traverse:
     return (it - 1)->second;
   }
 
+  /*
+   * LocateSeparatorBySearchMode() - Locate the child node for a traversal
+   *                                 that is not SearchMode::AtKey
+   *
+   * This is the last separator the traversal goes to the right of, i.e. the
+   * last separator < search key for BeforeKey, or the last separator for
+   * Last
+   */
+  inline NodeID LocateSeparatorBySearchMode(const Context *context_p,
+                                            const InnerNode *inner_node_p) {
+    const std::vector<KeyNodeIDPair> *sep_list_p = &inner_node_p->sep_list;
+
+    // Inner node could not be empty
+    assert(sep_list_p->size() != 0UL);
+
+    if(context_p->search_mode == SearchMode::Last) {
+      return sep_list_p->back().second;
+    }
+
+    // lower_bound returns the first element >= given key, so the one before
+    // it is the last element < given key
+    auto it = std::lower_bound(sep_list_p->begin() + 1,
+                               sep_list_p->end(),
+                               std::make_pair(context_p->search_key,
+                                              INVALID_NODE_ID),
+                               key_node_id_pair_cmp_obj);
+
+    return (it - 1)->second;
+  }
+
   /*
    * NavigateInnerNode() - Traverse down through the inner node delta chain
    *                       and probably horizontally to right sibling nodes
@@ -2488,7 +2558,12 @@ abort_traverse:
 
           // We always use the ubound recorded inside the top of the
           // delta chain
-          NodeID target_id = LocateSeparatorByKey(search_key, inner_node_p);
+          NodeID target_id = INVALID_NODE_ID;
+          if(context_p->search_mode == SearchMode::AtKey) {
+            target_id = LocateSeparatorByKey(search_key, inner_node_p);
+          } else {
+            target_id = LocateSeparatorBySearchMode(context_p, inner_node_p);
+          }
 
           bwt_printf("Found child in inner node; child ID = %lu\n",
                      target_id);
@@ -2510,9 +2585,9 @@ abort_traverse:
           // If the next item has +Inf as its key (checking that using
           // next_node_id), or it > search key
           if((next_item.second == INVALID_NODE_ID) ||
-             (KeyCmpLess(search_key, next_item.first))) {
+             (!SearchKeyGreaterEqual(context_p, next_item.first))) {
             // If search key >= insert key
-            if(KeyCmpGreaterEqual(search_key, insert_item.first)) {
+            if(SearchKeyGreaterEqual(context_p, insert_item.first)) {
               bwt_printf("Find target ID = %lu in insert delta\n",
                          insert_item.second);
 
@@ -2542,12 +2617,12 @@ abort_traverse:
           // with the low key of the current delete node which always
           // reflects the low key of this branch
           if((delete_node_p->GetLowKeyNodeID() == prev_item.second) ||
-             (KeyCmpGreaterEqual(search_key, prev_item.first))) {
+             (SearchKeyGreaterEqual(context_p, prev_item.first))) {
             // If the next item is +Inf key then we also choose not to compare
             // keys directly since we know the search key is definitely smaller
             // then +Inf
             if((next_item.second == INVALID_NODE_ID) ||
-               (KeyCmpLess(search_key, next_item.first))) {
+               (!SearchKeyGreaterEqual(context_p, next_item.first))) {
               bwt_printf("Find target ID = %lu in delete delta\n",
                          prev_item.second);
 
@@ -2581,7 +2656,7 @@ abort_traverse:
           // Here since we will only take one branch, so
           // high key does not need to be updated
           // Since we still could not know the high key
-          if(KeyCmpGreaterEqual(search_key, merge_key)) {
+          if(SearchKeyGreaterEqual(context_p, merge_key)) {
             bwt_printf("Take merge right branch (ID = %lu)\n",
                        snapshot_p->node_id);
 
@@ -6356,6 +6431,45 @@ before_switch:
     return;
   }
 
+  /*
+   * GetValueBatch() - Fill a value list for each key of a batch
+   *
+   * Keys are searched in the order given by search_order, all inside one
+   * epoch. If the order is sorted then neighbouring searches go down the
+   * same path and find its nodes still in cache, and equal keys are only
+   * searched once
+   *
+   * value_list_list[i] receives the values of key_list[i]
+   */
+  void GetValueBatch(const std::vector<KeyType> &key_list,
+                     const std::vector<size_t> &search_order,
+                     std::vector<std::vector<ValueType>> &value_list_list) {
+    bwt_printf("GetValueBatch()\n");
+
+    value_list_list.resize(key_list.size());
+
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    for(size_t i = 0;i < search_order.size();i++) {
+      size_t key_index = search_order[i];
+
+      if(i > 0 && \
+         KeyCmpEqual(key_list[key_index], key_list[search_order[i - 1]])) {
+        value_list_list[key_index] = value_list_list[search_order[i - 1]];
+
+        continue;
+      }
+
+      Context context{key_list[key_index]};
+
+      TraverseReadOptimized(&context, &value_list_list[key_index]);
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return;
+  }
+
   /*
    * GetValue() - Return value in a ValueSet object
    *
@@ -7162,6 +7276,7 @@ try_join_again:
    * Iterator Interface
    */
   class ForwardIterator;
+  class ReverseIterator;
 
   /*
    * Begin() - Return an iterator pointing the first element in the tree
@@ -7198,6 +7313,24 @@ try_join_again:
     return ForwardIterator{};
   }
 
+  /*
+   * RBegin() - Return a reverse iterator pointing to the last element in
+   *            the tree
+   */
+  ReverseIterator RBegin() {
+    return ReverseIterator{this};
+  }
+
+  /*
+   * RBegin() - Return a reverse iterator using a given key
+   *
+   * The iterator returned points to the last data item whose key is less
+   * than or equal to the given end key
+   */
+  ReverseIterator RBegin(const KeyType &end_key) {
+    return ReverseIterator{this, end_key};
+  }
+
   /*
    * Iterators
    */
@@ -7675,6 +7808,274 @@ try_join_again:
     }
   }; // ForwardIterator
 
+  /*
+   * class ReverseIterator - Iterator that supports backward iteration of
+   *                         tree elements
+   *
+   * Leaf pages only link to their right siblings, so instead of following
+   * a link this iterator finds the page before the current one by traversing
+   * down with the low key of the current page as the search key and
+   * SearchMode::BeforeKey. operator++ moves towards smaller keys
+   */
+  class ReverseIterator {
+   public:
+    /*
+     * Default Constructor - Place holder that does not load any page
+     */
+    ReverseIterator() :
+      leaf_node_p{nullptr}
+    {}
+
+    /*
+     * Constructor - Construct an iterator on the last item of the tree
+     */
+    ReverseIterator(BwTree *p_tree_p) :
+      tree_p{p_tree_p},
+      leaf_node_p{nullptr},
+      is_end{false} {
+      UpperBound(SearchMode::Last, nullptr);
+
+      return;
+    }
+
+    /*
+     * Constructor - Construct an iterator given a key
+     *
+     * The iterator is located on the last data item whose key is <= the
+     * given key
+     */
+    ReverseIterator(BwTree *p_tree_p,
+                    const KeyType &end_key) :
+      tree_p{p_tree_p},
+      leaf_node_p{nullptr},
+      is_end{false} {
+      UpperBound(SearchMode::AtKey, &end_key);
+
+      return;
+    }
+
+    /*
+     * Copy Constructor - Copies the logical leaf node and relocates the
+     *                    iterator on the copy
+     */
+    ReverseIterator(const ReverseIterator &other) :
+      tree_p{other.tree_p},
+      leaf_node_p{new LeafNode{*other.leaf_node_p}},
+      low_key{other.low_key},
+      is_first_page{other.is_first_page},
+      is_end{other.is_end} {
+      it = leaf_node_p->data_list.begin() + \
+           std::distance(((const LeafNode *)other.leaf_node_p)->data_list.begin(), other.it);
+
+      return;
+    }
+
+    /*
+     * Move Assignment - Takes over the leaf node of a temporary iterator
+     */
+    ReverseIterator &operator=(ReverseIterator &&other) {
+      if(this == &other) {
+        return *this;
+      }
+
+      if(leaf_node_p != nullptr) {
+        delete leaf_node_p;
+      }
+
+      leaf_node_p = other.leaf_node_p;
+      it = other.it;
+
+      tree_p = other.tree_p;
+      low_key = other.low_key;
+      is_first_page = other.is_first_page;
+
+      is_end = other.is_end;
+
+      other.leaf_node_p = nullptr;
+
+      return *this;
+    }
+
+    ReverseIterator &operator=(const ReverseIterator &other) = delete;
+
+    ~ReverseIterator() {
+      if(leaf_node_p != nullptr) {
+        delete leaf_node_p;
+      }
+
+      return;
+    }
+
+    inline const KeyValuePair &operator*() {
+      return (*it);
+    }
+
+    inline const KeyValuePair *operator->() {
+      return &(*it);
+    }
+
+    /*
+     * Prefix operator++ - Move the iterator to the previous item
+     *
+     * If the iterator is end() iterator then we do nothing
+     */
+    inline ReverseIterator &operator++() {
+      if(is_end == true) {
+        return *this;
+      }
+
+      MoveBackByOne();
+
+      return *this;
+    }
+
+    /*
+     * Postfix operator++ - Move the iterator to the previous item, and
+     *                      return the old one
+     */
+    inline ReverseIterator operator++(int) {
+      if(is_end == true) {
+        return *this;
+      }
+
+      ReverseIterator temp = *this;
+
+      MoveBackByOne();
+
+      return temp;
+    }
+
+    /*
+     * IsEnd() - Returns true if we have passed the first item
+     */
+    inline bool IsEnd() const {
+      return is_end;
+    }
+
+   private:
+    BwTree *tree_p;
+
+    // This points to a consolidated leaf node owned by the iterator
+    LeafNode *leaf_node_p;
+
+    // The low key of current logical leaf node. All items we have not seen
+    // are < this key
+    // NOTE: Like next_key_pair in ForwardIterator, this is copied from the
+    // physical node since the node might be recycled after we leave the
+    // epoch
+    KeyType low_key;
+
+    // Whether the current page is the first leaf page, whose low key is
+    // -Inf. The first page is never removed by a merge
+    bool is_first_page;
+
+    // This is the actual iterator
+    typename std::vector<KeyValuePair>::const_iterator it;
+
+    // Whether we have passed the first item of the tree
+    bool is_end;
+
+    /*
+     * UpperBound() - Load the leaf page holding the last item that is before
+     *                the search key according to the search mode
+     *
+     * AtKey stops at the last item <= search key, BeforeKey at the last
+     * item < search key, and Last at the last item of the tree. If the page
+     * has no such item (it might be empty, or it might have been merged
+     * with its right sibling since we read its low key) we keep loading the
+     * page before it until we run out of pages
+     */
+    void UpperBound(SearchMode search_mode, const KeyType *search_key_p) {
+      assert(is_end == false);
+
+      while(1) {
+        // We need to save this since the key pointer might point to
+        // low_key which will be overwritten
+        const KeyType search_key = \
+          (search_key_p == nullptr) ? KeyType{} : *search_key_p;
+
+        EpochNode *epoch_node_p = tree_p->epoch_manager.JoinEpoch();
+
+        Context context{search_key, search_mode};
+
+        tree_p->Traverse(&context, nullptr, nullptr);
+
+        NodeSnapshot *snapshot_p = tree_p->GetLatestNodeSnapshot(&context);
+        const BaseNode *node_p = snapshot_p->node_p;
+
+        assert(node_p->IsOnLeafDeltaChain() == true);
+
+        // Set low key for loading the page before this one
+        low_key = node_p->GetLowKeyPair().first;
+        is_first_page = (snapshot_p->node_id == FIRST_LEAF_NODE_ID);
+
+        if(leaf_node_p != nullptr) {
+          delete leaf_node_p;
+        }
+
+        leaf_node_p = tree_p->CollectAllValuesOnLeaf(snapshot_p);
+
+        tree_p->epoch_manager.LeaveEpoch(epoch_node_p);
+
+        // Find the first item that is past the bound
+        auto end_it = leaf_node_p->data_list.end();
+        if(search_mode == SearchMode::AtKey) {
+          end_it = std::upper_bound(leaf_node_p->data_list.begin(),
+                                    leaf_node_p->data_list.end(),
+                                    std::make_pair(search_key, ValueType{}),
+                                    this->tree_p->key_value_pair_cmp_obj);
+        } else if(search_mode == SearchMode::BeforeKey) {
+          end_it = std::lower_bound(leaf_node_p->data_list.begin(),
+                                    leaf_node_p->data_list.end(),
+                                    std::make_pair(search_key, ValueType{}),
+                                    this->tree_p->key_value_pair_cmp_obj);
+        }
+
+        if(end_it != leaf_node_p->data_list.begin()) {
+          it = end_it - 1;
+
+          return;
+        }
+
+        // There is no page before the first page
+        if(is_first_page == true) {
+          is_end = true;
+
+          return;
+        }
+
+        search_mode = SearchMode::BeforeKey;
+        search_key_p = &low_key;
+      } // while(1)
+
+      assert(false);
+      return;
+    }
+
+    /*
+     * MoveBackByOne() - Move the iterator to the previous item
+     */
+    inline void MoveBackByOne() {
+      assert(leaf_node_p != nullptr);
+
+      if(it != leaf_node_p->data_list.begin()) {
+        it--;
+
+        return;
+      }
+
+      if(is_first_page == true) {
+        is_end = true;
+
+        return;
+      }
+
+      UpperBound(SearchMode::BeforeKey, &low_key);
+
+      return;
+    }
+  }; // ReverseIterator
+
 }; // class BwTree
 
 #ifdef BWTREE_PELOTON
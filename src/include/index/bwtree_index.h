@@ -95,6 +95,12 @@ class BWTreeIndex : public Index {
                        const ItemPointer &location,
                        std::function<bool(const ItemPointer &)> predicate);
 
+  bool InsertTupleEntry(const AbstractTuple *tuple,
+                        const ItemPointer &location);
+
+  bool DeleteTupleEntry(const AbstractTuple *tuple,
+                        const ItemPointer &location);
+
   void Scan(const std::vector<Value> &values,
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &expr_types,
@@ -105,6 +111,15 @@ class BWTreeIndex : public Index {
 
   void ScanKey(const storage::Tuple *key, std::vector<ItemPointer> &);
 
+  void ScanTupleKey(const AbstractTuple *tuple,
+                    std::vector<ItemPointer> &result);
+
+  void ScanKeyPoint(const std::vector<Value> &values,
+                    std::vector<ItemPointer> &result);
+
+  void ScanBatch(const std::vector<std::vector<Value>> &keys,
+                 std::vector<std::vector<ItemPointer>> &results);
+
   std::string GetTypeName() const;
 
   // TODO: Implement this
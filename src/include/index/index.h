@@ -155,6 +155,15 @@ class Index : public Printable {
   virtual bool DeleteEntry(const storage::Tuple *key,
                            const ItemPointer &location) = 0;
 
+  // Insert / delete an index entry whose key is made of the indexed columns
+  // of a table tuple. By default these build a key tuple and call
+  // InsertEntry() / DeleteEntry()
+  virtual bool InsertTupleEntry(const AbstractTuple *tuple,
+                                const ItemPointer &location);
+
+  virtual bool DeleteTupleEntry(const AbstractTuple *tuple,
+                                const ItemPointer &location);
+
   // First retrieve all Key-Value pairs of the given key
   // Return false if any of those k-v pairs satisfy the predicate
   // If not any of those k-v pair satisfy the predicate, insert the k-v pair
@@ -179,6 +188,22 @@ class Index : public Printable {
   virtual void ScanKey(const storage::Tuple *key,
                        std::vector<ItemPointer> &result) = 0;
 
+  // Lookup of the key made of the indexed columns of a table tuple.
+  // By default this builds a key tuple and calls ScanKey()
+  virtual void ScanTupleKey(const AbstractTuple *tuple,
+                            std::vector<ItemPointer> &result);
+
+  // Point lookup given the values of all key columns in key column order.
+  // By default this builds a key tuple and calls ScanKey()
+  virtual void ScanKeyPoint(const std::vector<Value> &values,
+                            std::vector<ItemPointer> &result);
+
+  // Point lookups of a batch of keys, each given by the values of all key
+  // columns in key column order. results[i] receives the matches of
+  // keys[i]. By default this calls ScanKeyPoint() for every key
+  virtual void ScanBatch(const std::vector<std::vector<Value>> &keys,
+                         std::vector<std::vector<ItemPointer>> &results);
+
   // This gives a hint on whether GC is needed on the index
   // for those that do not need GC this always return false
   virtual bool NeedGC() = 0;
@@ -17,6 +17,7 @@
 
 #include "common/logger.h"
 #include "common/macros.h"
+#include "common/value_factory.h"
 #include "common/value_peeker.h"
 #include "index/index.h"
 #include "storage/tuple.h"
@@ -89,6 +90,9 @@ inline uint64_t ConvertSignedValueToUnsignedValue<INT64_MAX, int64_t, uint64_t>(
   return retval;
 }
 
+template <std::size_t KeySize>
+class IntsKeyTuple;
+
 /**
  *  class IntsKey - Integer key
  *
@@ -170,9 +174,59 @@ class IntsKey {
     return retval;
   }
 
-  const storage::Tuple GetTupleForComparison(
+  // The packed data is not laid out as a tuple, so the values are decoded
+  // from the key when they are read
+  const IntsKeyTuple<KeySize> GetTupleForComparison(
       const catalog::Schema *key_schema) const {
-    return storage::Tuple(key_schema, data);
+    return IntsKeyTuple<KeySize>(key_schema, this);
+  }
+
+  /*
+   * ToValue() - Decode the value of a key column
+   *
+   * Columns are packed back to back from the most significant byte of the
+   * key, so the column starts after the bytes of the columns before it
+   */
+  inline const Value ToValue(const catalog::Schema *key_schema,
+                             oid_t column_id) const {
+    int column_offset = 0;
+    for (oid_t ii = 0; ii < column_id; ii++) {
+      column_offset += key_schema->GetLength(ii);
+    }
+
+    int key_offset = column_offset / sizeof(uint64_t);
+    int intra_key_offset =
+        sizeof(uint64_t) - 1 - column_offset % sizeof(uint64_t);
+    switch (key_schema->GetType(column_id)) {
+      case VALUE_TYPE_BIGINT: {
+        const uint64_t key_value =
+            ExtractKeyValue<uint64_t>(key_offset, intra_key_offset);
+        return ValueFactory::GetBigIntValue(
+            ConvertUnsignedValueToSignedValue<int64_t, INT64_MAX>(key_value));
+      }
+      case VALUE_TYPE_INTEGER: {
+        const uint64_t key_value =
+            ExtractKeyValue<uint32_t>(key_offset, intra_key_offset);
+        return ValueFactory::GetIntegerValue(
+            ConvertUnsignedValueToSignedValue<int32_t, INT32_MAX>(key_value));
+      }
+      case VALUE_TYPE_SMALLINT: {
+        const uint64_t key_value =
+            ExtractKeyValue<uint16_t>(key_offset, intra_key_offset);
+        return ValueFactory::GetSmallIntValue(
+            ConvertUnsignedValueToSignedValue<int16_t, INT16_MAX>(key_value));
+      }
+      case VALUE_TYPE_TINYINT: {
+        const uint64_t key_value =
+            ExtractKeyValue<uint8_t>(key_offset, intra_key_offset);
+        return ValueFactory::GetTinyIntValue(
+            ConvertUnsignedValueToSignedValue<int8_t, INT8_MAX>(key_value));
+      }
+      default:
+        throw IndexException(
+            "We currently only support a specific set of "
+            "column index sizes...");
+    }
   }
 
   std::string Debug(const catalog::Schema *key_schema) const {
@@ -328,12 +382,118 @@ class IntsKey {
     }
   }
 
+  /*
+   * SetFromColumns() - Set a key from the values of the key columns
+   *
+   * get_value(i) returns the value of the i-th key column, so the values
+   * are packed directly instead of going through a key tuple, e.g. for
+   * point lookups or for the indexed columns of a table tuple. Returns true
+   * since any integer key can be set
+   */
+  template <typename GetValueFunc>
+  inline bool SetFromColumns(const catalog::Schema *key_schema,
+                             const GetValueFunc &get_value) {
+    PL_MEMSET(data, 0, KeySize * sizeof(uint64_t));
+    const int GetColumnCount = key_schema->GetColumnCount();
+    int key_offset = 0;
+    int intra_key_offset = sizeof(uint64_t) - 1;
+    for (int ii = 0; ii < GetColumnCount; ii++) {
+      const ValueType column_type = key_schema->GetType(ii);
+      // The value as it would be stored in the key tuple
+      const Value column_value = get_value(ii);
+      const Value value = (column_value.GetValueType() == column_type)
+                              ? column_value
+                              : column_value.CastAs(column_type);
+      switch (column_type) {
+        case VALUE_TYPE_BIGINT: {
+          const uint64_t key_value =
+              ConvertSignedValueToUnsignedValue<INT64_MAX, int64_t, uint64_t>(
+                  ValuePeeker::PeekBigInt(value));
+          InsertKeyValue<uint64_t>(key_offset, intra_key_offset, key_value);
+          break;
+        }
+        case VALUE_TYPE_INTEGER: {
+          const uint32_t key_value =
+              ConvertSignedValueToUnsignedValue<INT32_MAX, int32_t, uint32_t>(
+                  ValuePeeker::PeekInteger(value));
+          InsertKeyValue<uint32_t>(key_offset, intra_key_offset, key_value);
+          break;
+        }
+        case VALUE_TYPE_SMALLINT: {
+          const uint16_t key_value =
+              ConvertSignedValueToUnsignedValue<INT16_MAX, int16_t, uint16_t>(
+                  ValuePeeker::PeekSmallInt(value));
+          InsertKeyValue<uint16_t>(key_offset, intra_key_offset, key_value);
+          break;
+        }
+        case VALUE_TYPE_TINYINT: {
+          const uint8_t key_value =
+              ConvertSignedValueToUnsignedValue<INT8_MAX, int8_t, uint8_t>(
+                  ValuePeeker::PeekTinyInt(value));
+          InsertKeyValue<uint8_t>(key_offset, intra_key_offset, key_value);
+          break;
+        }
+        default:
+          throw IndexException(
+              "We currently only support a specific set of "
+              "column index sizes...");
+          break;
+      }
+    }
+
+    return true;
+  }
+
+  // Set a key from the values of the key columns
+  inline bool SetFromValues(const catalog::Schema *key_schema,
+                            const std::vector<Value> &values) {
+    return SetFromColumns(key_schema, [&values](int column_itr) {
+      return values[column_itr];
+    });
+  }
+
+  // Set a key from the given columns of a table tuple
+  inline bool SetFromTupleColumns(const catalog::Schema *key_schema,
+                                  const AbstractTuple *tuple,
+                                  const std::vector<oid_t> &column_ids) {
+    return SetFromColumns(key_schema, [tuple, &column_ids](int column_itr) {
+      return tuple->GetValue(column_ids[column_itr]);
+    });
+  }
+
   // actual location of data
   uint64_t data[KeySize];
 
  private:
 };
 
+/*
+ * class IntsKeyTuple - Tuple view of the columns packed in an IntsKey
+ *
+ * This lets a scan check a key against its predicate without unpacking the
+ * whole key into a tuple
+ */
+template <std::size_t KeySize>
+class IntsKeyTuple : public AbstractTuple {
+ public:
+  IntsKeyTuple(const catalog::Schema *key_schema,
+               const IntsKey<KeySize> *key_p)
+      : key_schema(key_schema), key_p(key_p) {}
+
+  Value GetValue(oid_t column_id) const {
+    return key_p->ToValue(key_schema, column_id);
+  }
+
+  char *GetData() const {
+    return reinterpret_cast<char *>(const_cast<uint64_t *>(key_p->data));
+  }
+
+ private:
+  const catalog::Schema *key_schema;
+
+  const IntsKey<KeySize> *key_p;
+};
+
 /** comparator for Int specialized indexes. */
 template <std::size_t KeySize>
 class IntsComparator {
@@ -454,6 +614,60 @@ class GenericKey {
     return storage::Tuple(key_schema, data);
   }
 
+  /*
+   * SetFromColumns() - Set a key from the values of the key columns
+   *
+   * get_value(i) returns the value of the i-th key column, which is
+   * serialized directly into the key instead of being copied from a key
+   * tuple. A column that is not inlined would need its data allocated
+   * outside the key, so in that case nothing is set and this returns false
+   */
+  template <typename GetValueFunc>
+  inline bool SetFromColumns(const catalog::Schema *key_schema,
+                             const GetValueFunc &get_value) {
+    const oid_t column_count = key_schema->GetColumnCount();
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      if (key_schema->IsInlined(column_itr) == false) {
+        return false;
+      }
+    }
+
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      const ValueType column_type = key_schema->GetType(column_itr);
+      char *data_ptr = &data[key_schema->GetOffset(column_itr)];
+      const int32_t column_length = key_schema->GetLength(column_itr);
+      const Value column_value = get_value(column_itr);
+
+      if (column_value.GetValueType() == column_type) {
+        column_value.SerializeToTupleStorage(data_ptr, true, column_length,
+                                             false);
+      } else {
+        column_value.CastAs(column_type).SerializeToTupleStorage(
+            data_ptr, true, column_length, false);
+      }
+    }
+
+    schema = key_schema;
+    return true;
+  }
+
+  // Set a key from the values of the key columns
+  inline bool SetFromValues(const catalog::Schema *key_schema,
+                            const std::vector<Value> &values) {
+    return SetFromColumns(key_schema, [&values](oid_t column_itr) {
+      return values[column_itr];
+    });
+  }
+
+  // Set a key from the given columns of a table tuple
+  inline bool SetFromTupleColumns(const catalog::Schema *key_schema,
+                                  const AbstractTuple *tuple,
+                                  const std::vector<oid_t> &column_ids) {
+    return SetFromColumns(key_schema, [tuple, &column_ids](oid_t column_itr) {
+      return tuple->GetValue(column_ids[column_itr]);
+    });
+  }
+
   inline const Value ToValueFast(const catalog::Schema *schema,
                                  int column_id) const {
     const ValueType column_type = schema->GetType(column_id);
@@ -616,6 +830,21 @@ class TupleKey {
     key_tuple_schema = tuple->GetSchema();
   }
 
+  // A TupleKey only points to the data of a tuple, so it cannot be set
+  // from values or from the columns of a table tuple without building a
+  // key tuple
+  inline bool SetFromValues(UNUSED_ATTRIBUTE const catalog::Schema *key_schema,
+                            UNUSED_ATTRIBUTE const std::vector<Value> &values) {
+    return false;
+  }
+
+  inline bool SetFromTupleColumns(
+      UNUSED_ATTRIBUTE const catalog::Schema *key_schema,
+      UNUSED_ATTRIBUTE const AbstractTuple *tuple,
+      UNUSED_ATTRIBUTE const std::vector<oid_t> &column_ids) {
+    return false;
+  }
+
   // Return true if the TupleKey references an ephemeral index key.
   bool IsKeySchema() const { return column_indices == NULL; }
 
@@ -14,6 +14,11 @@
 #pragma once
 
 namespace peloton {
+
+namespace catalog {
+class Schema;
+}
+
 namespace index {
 
 void ConstructIntervals(oid_t leading_column_id,
@@ -28,5 +33,18 @@ void FindMaxMinInColumns(oid_t leading_column_id,
                          const std::vector<ExpressionType> &expr_types,
                          std::map<oid_t, std::pair<Value, Value>> &non_leading_columns);
 
+bool ConstructKeyBounds(const catalog::Schema *key_schema,
+                        const std::vector<Value> &values,
+                        const std::vector<oid_t> &key_column_ids,
+                        const std::vector<ExpressionType> &expr_types,
+                        std::vector<Value> &low_key_values,
+                        std::vector<Value> &high_key_values);
+
+bool ConstructPointKeyValues(const catalog::Schema *key_schema,
+                             const std::vector<Value> &values,
+                             const std::vector<oid_t> &key_column_ids,
+                             const std::vector<ExpressionType> &expr_types,
+                             std::vector<Value> &key_values);
+
 }  // End index namespace
 }  // End peloton namespace
@@ -61,6 +61,9 @@ class SkipListIndex : public Index {
 
   void ScanKey(const storage::Tuple *key, std::vector<ItemPointer> &result);
 
+  void ScanBatch(const std::vector<std::vector<Value>> &keys,
+                 std::vector<std::vector<ItemPointer>> &results);
+
   std::string GetTypeName() const;
 
   bool Cleanup() { return true; }
@@ -45,14 +45,11 @@ class CheckpointTileScanner {
 
   ~CheckpointTileScanner() {}
 
-  // Scan a tile group r.w.t start_cid
+  // Scan a tile group r.w.t start_cid. The caller must hold an epoch that
+  // began at or before start_cid.
   std::unique_ptr<executor::LogicalTile> Scan(
       std::shared_ptr<storage::TileGroup>, const std::vector<oid_t> &column_ids,
       cid_t start_cid);
-
-  // check whether a tuple is visible to current checkpoint.
-  bool IsVisible(const storage::TileGroupHeader *const tile_group_header,
-                 const oid_t &tuple_id, cid_t start_cid);
 };
 
 }  // namespace logging
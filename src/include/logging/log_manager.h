@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <map>
 #include <vector>
@@ -30,6 +33,8 @@
 //===--------------------------------------------------------------------===//
 extern LoggingType peloton_logging_mode;
 
+extern int peloton_group_commit_size;
+
 namespace peloton {
 namespace logging {
 
@@ -111,6 +116,37 @@ class LogManager {
   // get the current persistent flushed commit
   cid_t GetPersistentFlushedCommitId();
 
+  //===--------------------------------------------------------------------===//
+  // Group Commit
+  //===--------------------------------------------------------------------===//
+
+  // queue a commit until it is flushed, the callback (if any) acknowledges it.
+  // a commit that is already flushed is acknowledged at once.
+  void EnqueueCommit(cid_t commit_id,
+                     const concurrency::CommitCallback &callback);
+
+  // acknowledge the queued commits up to the persistent flushed commit id
+  void AcknowledgeCommits();
+
+  // wait until a group of commits is queued or the timeout expires (for
+  // frontend loggers). a group that the logger already flushed up to
+  // max_flushed_commit_id does not wake it.
+  void WaitForGroupCommit(std::chrono::microseconds timeout,
+                          cid_t max_flushed_commit_id);
+
+  // whether enough commits are queued to flush them as a group
+  inline bool IsGroupCommitFull() const {
+    return pending_commit_count_ >= group_commit_size_;
+  }
+
+  inline size_t GetPendingCommitCount() const { return pending_commit_count_; }
+
+  inline void SetGroupCommitSize(size_t group_commit_size) {
+    group_commit_size_ = std::max(group_commit_size, (size_t)1);
+  }
+
+  inline size_t GetGroupCommitSize() const { return group_commit_size_; }
+
   // called by frontends when recovery is complete.(for a particular frontend)
   void NotifyRecoveryDone();
 
@@ -186,8 +222,11 @@ class LogManager {
   // log a delete
   void LogDelete(cid_t commit_id, const ItemPointer &delete_location);
 
-  // commit a transaction and wait until stable
-  void LogCommitTransaction(cid_t commit_id);
+  // commit a transaction. with synchronous commit, wait until stable.
+  // otherwise the callback acknowledges the commit once it is stable.
+  void LogCommitTransaction(cid_t commit_id,
+                            const concurrency::CommitCallback &callback =
+                                concurrency::CommitCallback());
 
   // used by the checkpointer to truncate unneeded log files
   void TruncateLogs(txn_id_t commit_id);
@@ -292,6 +331,17 @@ class LogManager {
   // maximum flushed commit id
   cid_t max_flushed_cid = 0;
 
+  // commits waiting for a flush, ordered by commit id
+  std::multimap<cid_t, concurrency::CommitCallback> commit_queue_;
+
+  std::mutex commit_queue_mutex_;
+  std::condition_variable commit_queue_cv_;
+
+  std::atomic<size_t> pending_commit_count_;
+
+  // commits to queue before a flush is forced
+  size_t group_commit_size_;
+
   bool syncronization_commit =
       true;  // default should be true because it is safest
 
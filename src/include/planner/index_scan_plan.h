@@ -64,6 +64,11 @@ class IndexScanPlan : public AbstractScan {
     std::vector<Value> values;
 
     std::vector<expression::AbstractExpression *> runtime_keys;
+
+    // IN-list of point lookups. When it is not empty, each entry holds the
+    // values of key_column_ids for one key, compared with "==", and values
+    // and expr_types are not used.
+    std::vector<std::vector<Value>> key_values_list;
   };
 
   IndexScanPlan(storage::DataTable *table,
@@ -93,6 +98,10 @@ class IndexScanPlan : public AbstractScan {
     return runtime_keys_;
   }
 
+  const std::vector<std::vector<Value>> &GetKeyValuesList() const {
+    return key_values_list_;
+  }
+
   inline PlanNodeType GetPlanNodeType() const {
     return PLAN_NODE_TYPE_INDEXSCAN;
   }
@@ -109,6 +118,7 @@ class IndexScanPlan : public AbstractScan {
 
     IndexScanDesc desc(index_, key_column_ids_, expr_types_, values_,
                        new_runtime_keys);
+    desc.key_values_list = key_values_list_;
     IndexScanPlan *new_plan = new IndexScanPlan(
         GetTable(), GetPredicate()->Copy(), GetColumnIds(), desc);
     return std::unique_ptr<AbstractPlan>(new_plan);
@@ -130,6 +140,8 @@ class IndexScanPlan : public AbstractScan {
   std::vector<Value> values_;
 
   const std::vector<expression::AbstractExpression *> runtime_keys_;
+
+  const std::vector<std::vector<Value>> key_values_list_;
 };
 
 }  // namespace planner
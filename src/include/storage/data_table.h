@@ -20,6 +20,7 @@
 
 #include "common/abstract_tuple.h"
 #include "common/platform.h"
+#include "container/append_only_array.h"
 #include "container/lock_free_array.h"
 #include "index/index.h"
 #include "storage/abstract_table.h"
@@ -30,6 +31,8 @@
 
 extern LayoutType peloton_layout_mode;
 
+extern int peloton_active_tile_group_count;
+
 //===--------------------------------------------------------------------===//
 // Configuration Variables
 //===--------------------------------------------------------------------===//
@@ -171,6 +174,26 @@ class DataTable : public AbstractTable {
   storage::TileGroup *TransformTileGroup(const oid_t &tile_group_offset,
                                          const double &theta);
 
+  // Replace a full tile group whose versions are all older than the given
+  // commit id with a compressed frozen copy.
+  // Returns nullptr if the tile group cannot be frozen.
+  storage::TileGroup *FreezeTileGroup(const oid_t &tile_group_offset,
+                                      const cid_t &max_dead_cid);
+
+  //===--------------------------------------------------------------------===//
+  // COMPACTION
+  //===--------------------------------------------------------------------===//
+
+  // Take the next compaction step for a full tile group whose versions are
+  // all older than the given commit id and whose live fraction is at most
+  // the threshold: move its live versions into the active tile groups,
+  // then unlink it from the indexes and version chains, and finally drop it
+  // once no transaction can still be traversing it.
+  // Runs its own transaction, so it must not be called inside one.
+  // Returns true once the tile group is dropped.
+  bool CompactTileGroup(const oid_t &tile_group_offset, const double &threshold,
+                        const cid_t &max_dead_cid);
+
   //===--------------------------------------------------------------------===//
   // STATS
   //===--------------------------------------------------------------------===//
@@ -187,6 +210,19 @@ class DataTable : public AbstractTable {
 
   void ResetDirty();
 
+  // Writes that failed because another transaction owned or had already
+  // replaced the version
+  void IncreaseConflictCount() { conflict_count_++; }
+
+  size_t GetConflictCount() const { return conflict_count_; }
+
+  // Writes that waited for the owner of the version
+  void IncreaseOwnershipWaitCount() { ownership_wait_count_++; }
+
+  size_t GetOwnershipWaitCount() const { return ownership_wait_count_; }
+
+  void ResetContentionStats();
+
   //===--------------------------------------------------------------------===//
   // LAYOUT TUNER
   //===--------------------------------------------------------------------===//
@@ -251,8 +287,13 @@ class DataTable : public AbstractTable {
   ItemPointer GetEmptyTupleSlot(const storage::Tuple *tuple,
                                 bool check_constraint = true);
 
-  // add a default unpartitioned tile group to table
-  oid_t AddDefaultTileGroup();
+  // add a default unpartitioned tile group to table and make it the
+  // active tile group at the given slot. Returns INVALID_OID if the table
+  // has no room for another tile group
+  oid_t AddDefaultTileGroup(const size_t &active_tile_group_id);
+
+  // refill all empty active tile group slots. Used by recovery
+  void AddActiveTileGroups();
 
   // get a partitioning with given layout type
   column_map_type GetTileGroupLayout(LayoutType layout_type);
@@ -270,6 +311,17 @@ class DataTable : public AbstractTable {
   // check the foreign key constraints
   bool CheckForeignKeyConstraints(const storage::Tuple *tuple);
 
+  //===--------------------------------------------------------------------===//
+  // COMPACTION HELPERS
+  //===--------------------------------------------------------------------===//
+
+  // Copy the live versions of the tile group into new versions
+  bool RelocateLiveVersions(storage::TileGroup *tile_group);
+
+  // Remove the index entries and version chain pointers that lead into
+  // the tile group. Returns false if a writer owns a version to rewrite.
+  bool UnlinkTileGroup(storage::TileGroup *tile_group);
+
  private:
   //===--------------------------------------------------------------------===//
   // MEMBERS
@@ -280,15 +332,18 @@ class DataTable : public AbstractTable {
   size_t tuples_per_tilegroup_;
 
   // TILE GROUPS
-  RWLock tile_group_lock_;
-
-  std::vector<oid_t> tile_groups_;
+  // append-only, so that scans can read it without taking a lock
+  AppendOnlyArray<oid_t> tile_groups_;
 
   // set of current tile groups
+  // each inserting thread is mapped to one of the active tile groups,
+  // and each active tile group is refilled on its own once it is full
   static constexpr std::size_t ACTIVE_TILE_GROUP_COUNT = 8;
 
+  std::size_t active_tile_group_count_;
+
   std::shared_ptr<storage::TileGroup>
-      last_tile_groups_[ACTIVE_TILE_GROUP_COUNT];
+      active_tile_groups_[ACTIVE_TILE_GROUP_COUNT];
 
   // data table mutex
   std::mutex data_table_mutex_;
@@ -314,6 +369,12 @@ class DataTable : public AbstractTable {
   // dirty flag
   bool dirty_ = false;
 
+  // # of write conflicts
+  std::atomic<size_t> conflict_count_ = ATOMIC_VAR_INIT(0);
+
+  // # of waits for version owners
+  std::atomic<size_t> ownership_wait_count_ = ATOMIC_VAR_INIT(0);
+
   //===--------------------------------------------------------------------===//
   // TUNING MEMBERS
   //===--------------------------------------------------------------------===//
@@ -336,6 +397,16 @@ class DataTable : public AbstractTable {
   // index samples mutex
   std::mutex index_samples_mutex_;
 
+  //===--------------------------------------------------------------------===//
+  // COMPACTION MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  // unlinked tile groups and the commit id at which they were unlinked
+  std::map<oid_t, cid_t> unlinked_tile_groups_;
+
+  // compaction mutex
+  std::mutex compaction_mutex_;
+
   static oid_t invalid_tile_group_id;
 };
 
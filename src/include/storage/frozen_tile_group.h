@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// frozen_tile_group.h
+//
+// Identification: src/include/storage/frozen_tile_group.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/types.h"
+#include "common/value.h"
+
+namespace peloton {
+
+class VarlenPool;
+
+namespace storage {
+
+class TileGroup;
+
+//===--------------------------------------------------------------------===//
+// Frozen Tile Group
+//===--------------------------------------------------------------------===//
+
+/**
+ * Read-only compressed columnar copy of the tuple slots of a tile group.
+ *
+ * Every column uses the smallest of the encodings that apply to its type:
+ * bit-packed offsets from the column minimum for integer types, bit-packed
+ * dictionary codes, runs of equal values, or plain values for the other
+ * inlined types. Varlen values are copied into a pool owned by the frozen
+ * tile group, so the tiles it was built from can be released.
+ */
+class FrozenTileGroup {
+  FrozenTileGroup() = delete;
+  FrozenTileGroup(FrozenTileGroup const &) = delete;
+
+ public:
+  // Compress the first tuple_count slots of the tile group
+  FrozenTileGroup(TileGroup *tile_group, const oid_t &tuple_count);
+
+  ~FrozenTileGroup();
+
+  Value GetValue(const oid_t &tuple_id, const oid_t &column_id) const;
+
+  oid_t GetTupleCount() const { return tuple_count; }
+
+  oid_t GetColumnCount() const { return columns.size(); }
+
+  ColumnEncodingType GetColumnEncoding(const oid_t &column_id) const;
+
+  // Number of bytes used by the encoded columns
+  size_t GetMemoryFootprint() const;
+
+ private:
+  struct FrozenColumn {
+    ValueType value_type;
+
+    ColumnEncodingType encoding;
+
+    // BIT_PACKED : value - base, DICTIONARY : index into values
+    int64_t base;
+    oid_t bit_width;
+    std::vector<uint64_t> packed;
+
+    // DICTIONARY : distinct values, RUN_LENGTH : value of each run
+    std::vector<Value> values;
+
+    // RUN_LENGTH : end (exclusive) of each run
+    std::vector<oid_t> run_ends;
+
+    // PLAIN : values in tuple storage format
+    std::vector<char> plain_data;
+
+    // null flag of every slot, empty if the column has no nulls
+    std::vector<bool> nulls;
+
+    // bytes of varlen data referenced by values
+    size_t varlen_size;
+  };
+
+  void EncodeColumn(FrozenColumn &column, const std::vector<Value> &values);
+
+  Value CopyValue(const Value &value);
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+
+  oid_t tuple_count;
+
+  std::vector<FrozenColumn> columns;
+
+  // backing storage of the varlen values
+  std::unique_ptr<VarlenPool> pool;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -23,6 +23,7 @@
 #include "common/types.h"
 #include "common/abstract_tuple.h"
 #include "common/macros.h"
+#include "common/pool.h"
 
 namespace peloton {
 
@@ -62,11 +63,12 @@ class RollbackSegmentPool {
     * - The first 8 byte field is a pointer to the next rollback segment on the
     *  singly linked rollback segment list
     * - The next 8 byte field is the timestamp of a rollback segment. This is
-    *  the *END* timestamp of the rollback segment, meaning that any transaction
-    *  that has a smaller timestamp may be able to read it. The begin timestamp
-    *  of a rollback segment is JUST the end timestamp of next rollback segment
-    *  on the rollback segment chain. Everytime the timestamp of a rollback
-    *  segment is copied from the coressponding tuple
+    *  the *BEGIN* timestamp of the before-image on the rollback segment, it is
+    *  copied from the corresponding tuple when the segment is created. The
+    *  end timestamp of a rollback segment is JUST the begin timestamp of the
+    *  newer version, which is either the tuple itself or the previous rollback
+    *  segment on the newest-to-oldest rollback segment chain. Segments of
+    *  later updates by the same transaction have a MAX_CID timestamp
     * - The next 8 byte field is the number of columns in the rollback segment
     * - The next column_count * 16 bytes is a serious of pairs, the pairs map
     *  column id of the original tuple to the offset of value in the data area
@@ -81,9 +83,8 @@ class RollbackSegmentPool {
   RollbackSegmentPool(BackendType backend_type)
       : pool_(backend_type), tombstone_(false), timestamp_(MAX_CID) {}
 
-  RollbackSegmentPool(BackendType backend_type, uint64_t allocation_size,
-                      uint64_t max_chunk_count)
-      : pool_(backend_type, allocation_size, max_chunk_count),
+  RollbackSegmentPool(BackendType backend_type, uint64_t allocation_size)
+      : pool_(backend_type, allocation_size),
         tombstone_(false),
         timestamp_(MAX_CID) {}
 
@@ -98,9 +99,9 @@ class RollbackSegmentPool {
   }
 
   // The semantics of timestamp on rollback segment:
-  //    The timestamp of a rollback segment stands for its "end timestamp".
-  //    The "start timestamp" of a rollback segment should be discovered from
-  //    the next rollback segment
+  //    The timestamp of a rollback segment stands for its "begin timestamp".
+  //    The "end timestamp" of a rollback segment should be discovered from
+  //    the newer version on the chain
   inline static cid_t GetTimeStamp(char *rb_seg) {
     return *(reinterpret_cast<cid_t *>(rb_seg + timestamp_offset_));
   }
@@ -133,6 +134,11 @@ class RollbackSegmentPool {
   // within this rollback segment
   static Value GetValue(char *rb_seg, const catalog::Schema *schema, int idx);
 
+  // Overwrite the columns on the rollback segment of a tuple copy, to get
+  // the before-image of the tuple
+  static void ApplyToTuple(char *rb_seg, const catalog::Schema *schema,
+                           Tuple *tuple, VarlenPool *pool);
+
   /////////////////////
   // Public setters
   /////////////////////
@@ -13,7 +13,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
+#include <unordered_map>
 
 #include "common/types.h"
 #include "common/platform.h"
@@ -46,10 +48,27 @@ class StorageManager {
 
   size_t GetAllocationCount() const { return allocation_count; }
 
+  size_t GetMappedAllocationCount() const { return mapped_allocation_count; }
+
+  size_t GetHugePageAllocationCount() const {
+    return huge_page_allocation_count;
+  }
+
  private:
+  // Allocate in-memory data, mapping large blocks directly
+  void *AllocateMemory(size_t size);
+
+  void ReleaseMemory(void *address);
+
   // data file address
   void *data_file_address;
 
+  // lengths of the mapped in-memory blocks
+  std::unordered_map<void *, size_t> mapped_memory_sizes;
+
+  // mapped blocks lock
+  Spinlock mapped_memory_spinlock;
+
   // data file lock
   Spinlock data_file_spinlock;
 
@@ -65,6 +84,10 @@ class StorageManager {
   size_t clflush_count = 0;
 
   size_t allocation_count = 0;
+
+  std::atomic<size_t> mapped_allocation_count;
+
+  std::atomic<size_t> huge_page_allocation_count;
 };
 
 }  // End storage namespace
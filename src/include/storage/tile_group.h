@@ -24,6 +24,7 @@
 #include "planner/project_info.h"
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
+#include "storage/zone_map.h"
 
 namespace peloton {
 
@@ -50,6 +51,7 @@ class TileGroupHeader;
 class AbstractTable;
 class TileGroupIterator;
 class RollbackSegment;
+class FrozenTileGroup;
 
 typedef std::map<oid_t, std::pair<oid_t, oid_t>> column_map_type;
 
@@ -60,6 +62,10 @@ typedef std::map<oid_t, std::pair<oid_t, oid_t>> column_map_type;
  *
  * Look at TileGroupHeader for MVCC implementation.
  *
+ * A frozen tile group keeps its tuple slots in a compressed FrozenTileGroup
+ * instead of tiles. Reading values through GetValue decodes them directly,
+ * while the first write thaws the tile group back into tiles.
+ *
  * TileGroups are only instantiated via TileGroupFactory.
  */
 class TileGroup : public Printable {
@@ -88,6 +94,10 @@ class TileGroup : public Printable {
 
   void CopyTuple(const oid_t &tuple_slot_id, Tuple *tuple);
 
+  // write one column of a tuple in place.
+  void SetValue(const Value &value, const oid_t &tuple_slot_id,
+                const oid_t &column_id);
+
   // insert tuple at next available slot in tile if a slot exists
   oid_t InsertTuple(const Tuple *tuple);
 
@@ -126,11 +136,22 @@ class TileGroup : public Printable {
 
   TileGroupHeader *GetHeader() const { return tile_group_header; }
 
+  const ZoneMap &GetZoneMap() const { return zone_map; }
+
+  // Returns true if the values are only held in compressed form
+  bool IsFrozen() const { return frozen.load(); }
+
+  // Returns nullptr once the tile group is thawed
+  std::shared_ptr<const FrozenTileGroup> GetFrozenTileGroup() const {
+    return std::atomic_load(&frozen_tile_group);
+  }
+
   void SetHeader(TileGroupHeader *header) { tile_group_header = header; }
 
   unsigned int NumTiles() const { return tiles.size(); }
 
-  // Get the tile at given offset in the tile group
+  // Get the tile at given offset in the tile group.
+  // A frozen tile group has no tiles until it is thawed.
   inline Tile *GetTile(const oid_t tile_itr) const;
 
   // Get a reference to the tile at the given offset in the tile group
@@ -173,6 +194,17 @@ class TileGroup : public Printable {
   void Sync();
 
  protected:
+  // Frozen tile group constructor
+  TileGroup(BackendType backend_type, TileGroupHeader *tile_group_header,
+            AbstractTable *table, const std::vector<catalog::Schema> &schemas,
+            const column_map_type &column_map, int tuple_count,
+            FrozenTileGroup *frozen_tile_group);
+
+  void CreateTiles();
+
+  // Rebuild the tiles from the frozen tile group and release it
+  void Thaw();
+
   //===--------------------------------------------------------------------===//
   // Data members
   //===--------------------------------------------------------------------===//
@@ -188,7 +220,7 @@ class TileGroup : public Printable {
   // mapping to tile schemas
   std::vector<catalog::Schema> tile_schemas;
 
-  // set of tiles
+  // set of tiles, empty slots while the tile group is frozen
   std::vector<std::shared_ptr<Tile>> tiles;
 
   // associated tile group
@@ -208,11 +240,22 @@ class TileGroup : public Printable {
   // column to tile mapping :
   // <column offset> to <tile offset, tile column offset>
   column_map_type column_map;
+
+  // min/max of the values inserted into the tile group
+  ZoneMap zone_map;
+
+  // compressed values of a frozen tile group, only accessed atomically.
+  // Readers that decode from it keep it alive after a thaw.
+  std::shared_ptr<FrozenTileGroup> frozen_tile_group;
+
+  // cleared once the tiles of a frozen tile group are rebuilt
+  std::atomic<bool> frozen;
 };
 
 inline oid_t TileGroup::GetTileId(const oid_t tile_id) const {
-  PL_ASSERT(tiles[tile_id]);
-  return tiles[tile_id]->GetTileId();
+  Tile *tile = GetTile(tile_id);
+  PL_ASSERT(tile);
+  return tile->GetTileId();
 }
 
 inline peloton::VarlenPool *TileGroup::GetTilePool(const oid_t tile_id) const {
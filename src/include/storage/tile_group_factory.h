@@ -35,6 +35,9 @@ class TileGroupFactory {
                                  const std::vector<catalog::Schema> &schemas,
                                  const column_map_type &column_map,
                                  int tuple_count);
+
+  // Build a frozen copy of the tile group with the same ids and header
+  static TileGroup *GetFrozenTileGroup(TileGroup *tile_group);
 };
 
 }  // End storage namespace
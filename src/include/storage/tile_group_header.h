@@ -46,20 +46,35 @@ class TileGroup;
  *bytes) |
  *  | ReservedField (24 bytes) | InsertCommit (1 byte) | DeleteCommit (1 byte)
  *  -----------------------------------------------------------------------------
+ *
+ * With the column header layout, each field is instead stored in its own
+ * dense array, so that scans that only read the commit ids do not drag whole
+ * header entries through the cache :
+ *
+ *  | TxnID * N | BeginTimeStamp * N | EndTimeStamp * N | ... | DeleteCommit * N
  */
 
 #define TUPLE_HEADER_LOCATION data + (tuple_slot_id * header_entry_size)
 
+// location of the given header field of the tuple slot in either layout
+#define TUPLE_HEADER_FIELD(field)                                          \
+  (header_layout == LAYOUT_TYPE_COLUMN                                     \
+       ? data + (num_tuple_slots * field##_offset) +                       \
+             (tuple_slot_id * field##_size)                                \
+       : TUPLE_HEADER_LOCATION + field##_offset)
+
 class TileGroupHeader : public Printable {
   TileGroupHeader() = delete;
 
  public:
-  TileGroupHeader(const BackendType &backend_type, const int &tuple_count);
+  TileGroupHeader(const BackendType &backend_type, const int &tuple_count,
+                  const LayoutType &header_layout = LAYOUT_TYPE_ROW);
 
   TileGroupHeader &operator=(const peloton::storage::TileGroupHeader &other) {
     // check for self-assignment
     if (&other == this) return *this;
 
+    PL_ASSERT(header_layout == other.header_layout);
     header_size = other.header_size;
 
     // copy over all the data
@@ -69,6 +84,13 @@ class TileGroupHeader : public Printable {
     oid_t val = other.next_tuple_slot;
     next_tuple_slot = val;
 
+    oid_t owner_count_val = other.owner_count;
+    owner_count = owner_count_val;
+    cid_t end_cid_val = other.last_end_cid;
+    last_end_cid = end_cid_val;
+    cid_t full_cid_val = other.full_cid;
+    full_cid = full_cid_val;
+
     return *this;
   }
 
@@ -129,41 +151,41 @@ class TileGroupHeader : public Printable {
   inline txn_id_t GetTransactionId(const oid_t &tuple_slot_id) const {
     // txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION);
     // return __atomic_load_n(txn_id_ptr, __ATOMIC_RELAXED);
-    return *((txn_id_t *)(TUPLE_HEADER_LOCATION));
+    return *((txn_id_t *)(TUPLE_HEADER_FIELD(txn_id)));
   }
 
   inline cid_t GetBeginCommitId(const oid_t &tuple_slot_id) const {
-    return *((cid_t *)(TUPLE_HEADER_LOCATION + begin_cid_offset));
+    return *((cid_t *)(TUPLE_HEADER_FIELD(begin_cid)));
   }
 
   inline cid_t GetEndCommitId(const oid_t &tuple_slot_id) const {
-    return *((cid_t *)(TUPLE_HEADER_LOCATION + end_cid_offset));
+    return *((cid_t *)(TUPLE_HEADER_FIELD(end_cid)));
   }
 
   inline ItemPointer GetNextItemPointer(const oid_t &tuple_slot_id) const {
-    return *((ItemPointer *)(TUPLE_HEADER_LOCATION + next_pointer_offset));
+    return *((ItemPointer *)(TUPLE_HEADER_FIELD(next_pointer)));
   }
 
   inline ItemPointer GetPrevItemPointer(const oid_t &tuple_slot_id) const {
-    return *((ItemPointer *)(TUPLE_HEADER_LOCATION + prev_pointer_offset));
+    return *((ItemPointer *)(TUPLE_HEADER_FIELD(prev_pointer)));
   }
 
   // constraint: at most 24 bytes.
   inline char *GetReservedFieldRef(const oid_t &tuple_slot_id) const {
-    return (char *)(TUPLE_HEADER_LOCATION + reserved_field_offset);
+    return (char *)(TUPLE_HEADER_FIELD(reserved_field));
   }
 
   inline bool GetInsertCommit(const oid_t &tuple_slot_id) const {
-    return *((bool *)(TUPLE_HEADER_LOCATION + insert_commit_offset));
+    return *((bool *)(TUPLE_HEADER_FIELD(insert_commit)));
   }
 
   inline bool GetDeleteCommit(const oid_t &tuple_slot_id) const {
-    return *((bool *)(TUPLE_HEADER_LOCATION + delete_commit_offset));
+    return *((bool *)(TUPLE_HEADER_FIELD(delete_commit)));
   }
 
   // used only by occ_rb_txn_manager
   inline char *GetPrevItempointerField(const oid_t &tuple_slot_id) const {
-    return (char *)(TUPLE_HEADER_LOCATION + prev_pointer_offset);
+    return (char *)(TUPLE_HEADER_FIELD(prev_pointer));
   }
 
   // Setters
@@ -173,58 +195,92 @@ class TileGroupHeader : public Printable {
   }
   inline void SetTransactionId(const oid_t &tuple_slot_id,
                                const txn_id_t &transaction_id) {
-    *((txn_id_t *)(TUPLE_HEADER_LOCATION)) = transaction_id;
+    *((txn_id_t *)(TUPLE_HEADER_FIELD(txn_id))) = transaction_id;
   }
 
   inline void SetBeginCommitId(const oid_t &tuple_slot_id,
                                const cid_t &begin_cid) {
-    *((cid_t *)(TUPLE_HEADER_LOCATION + begin_cid_offset)) = begin_cid;
+    *((cid_t *)(TUPLE_HEADER_FIELD(begin_cid))) = begin_cid;
   }
 
   inline void SetEndCommitId(const oid_t &tuple_slot_id,
                              const cid_t &end_cid) const {
-    *((cid_t *)(TUPLE_HEADER_LOCATION + end_cid_offset)) = end_cid;
+    *((cid_t *)(TUPLE_HEADER_FIELD(end_cid))) = end_cid;
   }
 
   inline void SetNextItemPointer(const oid_t &tuple_slot_id,
                                  const ItemPointer &item) const {
-    *((ItemPointer *)(TUPLE_HEADER_LOCATION + next_pointer_offset)) = item;
+    *((ItemPointer *)(TUPLE_HEADER_FIELD(next_pointer))) = item;
   }
 
   inline void SetPrevItemPointer(const oid_t &tuple_slot_id,
                                  const ItemPointer &item) const {
-    *((ItemPointer *)(TUPLE_HEADER_LOCATION + prev_pointer_offset)) = item;
+    *((ItemPointer *)(TUPLE_HEADER_FIELD(prev_pointer))) = item;
   }
 
   inline void SetInsertCommit(const oid_t &tuple_slot_id,
                               const bool commit) const {
-    *((bool *)(TUPLE_HEADER_LOCATION + insert_commit_offset)) = commit;
+    *((bool *)(TUPLE_HEADER_FIELD(insert_commit))) = commit;
   }
 
   inline void SetDeleteCommit(const oid_t &tuple_slot_id,
                               const bool commit) const {
-    *((bool *)(TUPLE_HEADER_LOCATION + delete_commit_offset)) = commit;
+    *((bool *)(TUPLE_HEADER_FIELD(delete_commit))) = commit;
   }
 
   // Getters for addresses
   inline txn_id_t *GetTransactionIdLocation(const oid_t &tuple_slot_id) const {
-    return ((txn_id_t *)(TUPLE_HEADER_LOCATION));
+    return ((txn_id_t *)(TUPLE_HEADER_FIELD(txn_id)));
   }
 
   inline txn_id_t SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                          const txn_id_t &old_txn_id,
                                          const txn_id_t &new_txn_id) const {
-    txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION);
+    txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_FIELD(txn_id));
     return __sync_val_compare_and_swap(txn_id_ptr, old_txn_id, new_txn_id);
   }
 
   inline bool SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                      const txn_id_t &transaction_id) const {
-    txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION);
+    txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_FIELD(txn_id));
     return __sync_bool_compare_and_swap(txn_id_ptr, INITIAL_TXN_ID,
                                         transaction_id);
   }
 
+  //===--------------------------------------------------------------------===//
+  // Tile group write summary, used to validate a scan of the whole group
+  //===--------------------------------------------------------------------===//
+
+  // Called before trying to own a tuple slot, and after releasing it
+  inline void IncreaseOwnerCount() const { owner_count++; }
+
+  inline void DecreaseOwnerCount() const { owner_count--; }
+
+  // Number of tuple slots owned or about to be owned by a transaction
+  inline oid_t GetOwnerCount() const { return owner_count.load(); }
+
+  // Called when a committed transaction ends a version in this group
+  inline void SetLastEndCommitId(const cid_t &end_cid) const {
+    cid_t last = last_end_cid.load();
+    while (last < end_cid &&
+           last_end_cid.compare_exchange_weak(last, end_cid) == false)
+      ;
+  }
+
+  // Largest end commit id set by a committed transaction, 0 if none
+  inline cid_t GetLastEndCommitId() const { return last_end_cid.load(); }
+
+  // Called when the group is first seen full. Only transactions that began
+  // before the given commit id can still be writing its tuple slots.
+  inline cid_t SetFullCommitId(const cid_t &cid) const {
+    cid_t full = MAX_CID;
+    full_cid.compare_exchange_strong(full, cid);
+    return full_cid.load();
+  }
+
+  // Commit id at which the group was first seen full, MAX_CID if not yet
+  inline cid_t GetFullCommitId() const { return full_cid.load(); }
+
   void PrintVisibility(txn_id_t txn_id, cid_t at_cid);
 
   // Getter for spin lock
@@ -242,6 +298,24 @@ class TileGroupHeader : public Printable {
   const std::string GetInfo() const;
 
   static inline size_t GetReservedSize() { return reserverd_size; }
+
+  inline LayoutType GetHeaderLayout() const { return header_layout; }
+
+  // Dense field arrays of the column layout, for batch readers
+  inline const txn_id_t *GetTransactionIdColumn() const {
+    PL_ASSERT(header_layout == LAYOUT_TYPE_COLUMN);
+    return (const txn_id_t *)(data + num_tuple_slots * txn_id_offset);
+  }
+
+  inline const cid_t *GetBeginCommitIdColumn() const {
+    PL_ASSERT(header_layout == LAYOUT_TYPE_COLUMN);
+    return (const cid_t *)(data + num_tuple_slots * begin_cid_offset);
+  }
+
+  inline const cid_t *GetEndCommitIdColumn() const {
+    PL_ASSERT(header_layout == LAYOUT_TYPE_COLUMN);
+    return (const cid_t *)(data + num_tuple_slots * end_cid_offset);
+  }
   // *
   // -----------------------------------------------------------------------------
   // *  | TxnID (8 bytes)  | BeginTimeStamp (8 bytes) | EndTimeStamp (8 bytes) |
@@ -270,6 +344,16 @@ class TileGroupHeader : public Printable {
   static const size_t delete_commit_offset =
       insert_commit_offset + sizeof(bool);
 
+  // field sizes, used to locate the fields in the column layout
+  static const size_t txn_id_size = sizeof(txn_id_t);
+  static const size_t begin_cid_size = sizeof(cid_t);
+  static const size_t end_cid_size = sizeof(cid_t);
+  static const size_t next_pointer_size = sizeof(ItemPointer);
+  static const size_t prev_pointer_size = sizeof(ItemPointer);
+  static const size_t reserved_field_size = reserverd_size;
+  static const size_t insert_commit_size = sizeof(bool);
+  static const size_t delete_commit_size = sizeof(bool);
+
  private:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -278,6 +362,9 @@ class TileGroupHeader : public Printable {
   // Backend
   BackendType backend_type;
 
+  // Header layout (row or column)
+  LayoutType header_layout;
+
   // Associated tile_group
   TileGroup *tile_group;
 
@@ -294,6 +381,15 @@ class TileGroupHeader : public Printable {
   // IT MAY OUT OF BOUNDARY! ALWAYS CHECK IF IT EXCEEDS num_tuple_slots
   std::atomic<oid_t> next_tuple_slot;
 
+  // tuple slots owned by a transaction
+  mutable std::atomic<oid_t> owner_count;
+
+  // largest commit id at which a version of this group was ended
+  mutable std::atomic<cid_t> last_end_cid;
+
+  // commit id at which the group was first seen full
+  mutable std::atomic<cid_t> full_cid;
+
   Spinlock tile_header_lock;
 };
 
@@ -0,0 +1,106 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.h
+//
+// Identification: src/include/storage/zone_map.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "common/types.h"
+#include "common/value.h"
+
+namespace peloton {
+
+namespace expression {
+class AbstractExpression;
+}
+
+namespace storage {
+
+class Tuple;
+
+//===--------------------------------------------------------------------===//
+// Zone Map
+//===--------------------------------------------------------------------===//
+
+/**
+ * Per-column min/max and null count of the tuples stored in a tile group.
+ *
+ * The ranges only ever grow, so they stay a superset of the values of all
+ * versions in the tile group even after updates and deletes. Each bound is
+ * a word widened with compare-and-swap, so inserters do not serialize on the
+ * zone map. Columns whose values do not fit in a word (e.g. VARCHAR or
+ * DECIMAL) are not tracked.
+ */
+class ZoneMap {
+  ZoneMap() = delete;
+  ZoneMap(ZoneMap const &) = delete;
+
+ public:
+  ZoneMap(const std::vector<ValueType> &column_types);
+
+  // Copy the ranges of another zone map over the same columns
+  ZoneMap &operator=(const ZoneMap &other);
+
+  // Widen the ranges with the values of the tuple.
+  // If the tuple is stored in a newly allocated slot, count it as covered.
+  void Update(const Tuple *tuple, const bool &new_tuple_slot);
+
+  // Widen the range of one column with a value written in place
+  void UpdateColumn(const oid_t &column_id, const Value &value);
+
+  // Returns true if no tuple in the first tuple_count slots can satisfy
+  // the predicate, based on its conjunctive column-constant comparisons.
+  bool CanSkip(const expression::AbstractExpression *predicate,
+               const oid_t &tuple_count) const;
+
+  // Number of tuple slots whose values were added through Update
+  oid_t GetCoveredTupleCount() const { return covered_tuple_count; }
+
+  bool IsTracked(const oid_t &column_id) const;
+
+  Value GetMinValue(const oid_t &column_id) const;
+
+  Value GetMaxValue(const oid_t &column_id) const;
+
+  oid_t GetNullCount(const oid_t &column_id) const;
+
+ private:
+  bool CanSkipComparison(const expression::AbstractExpression *predicate) const;
+
+  // Bounds are kept as order-preserving keys of the values. The range is
+  // empty while the min key is larger than the max key.
+  struct ColumnRange {
+    ValueType column_type;
+    std::atomic<bool> tracked;
+    std::atomic<int64_t> min_key;
+    std::atomic<int64_t> max_key;
+    std::atomic<oid_t> null_count;
+  };
+
+  void WidenRange(ColumnRange &column_range, const Value &value);
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+
+  oid_t column_count;
+
+  std::unique_ptr<ColumnRange[]> column_ranges;
+
+  std::atomic<oid_t> covered_tuple_count;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
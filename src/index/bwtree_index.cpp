@@ -10,9 +10,12 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <numeric>
+
 #include "common/logger.h"
 #include "index/bwtree_index.h"
 #include "index/index_key.h"
+#include "index/index_util.h"
 #include "storage/tuple.h"
 
 namespace peloton {
@@ -112,6 +115,52 @@ BWTREE_INDEX_TYPE::CondInsertEntry(const storage::Tuple *key,
 }
 
 
+/*
+ * InsertTupleEntry() - Insert the entry keyed by the indexed columns of a
+ * table tuple
+ *
+ * The key is built on the stack from the tuple's columns, so no key tuple
+ * is allocated unless the key type could not be set this way
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool
+BWTREE_INDEX_TYPE::InsertTupleEntry(const AbstractTuple *tuple,
+                                    const ItemPointer &location) {
+  auto key_schema = metadata->GetKeySchema();
+
+  KeyType index_key;
+  if (index_key.SetFromTupleColumns(key_schema, tuple,
+                                    key_schema->GetIndexedColumns()) == false) {
+    return Index::InsertTupleEntry(tuple, location);
+  }
+
+  return container.Insert(index_key, location);
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+bool
+BWTREE_INDEX_TYPE::DeleteTupleEntry(const AbstractTuple *tuple,
+                                    const ItemPointer &location) {
+  auto key_schema = metadata->GetKeySchema();
+
+  KeyType index_key;
+  if (index_key.SetFromTupleColumns(key_schema, tuple,
+                                    key_schema->GetIndexedColumns()) == false) {
+    return Index::DeleteTupleEntry(tuple, location);
+  }
+
+  return container.Delete(index_key, location);
+}
+
+/*
+ * Scan() - Scan the range of keys that may satisfy the predicate
+ *
+ * The range [low, high] is derived from the predicate, so a forward scan
+ * seeks to the low key and stops after the high key, and a backward scan
+ * seeks to the high key and stops before the low key. Keys inside the range
+ * are checked against the predicate since the range is not tight, e.g.
+ * when there is no "==" on the leading column
+ */
 BWTREE_TEMPLATE_ARGUMENTS
 void
 BWTREE_INDEX_TYPE::Scan(const std::vector<Value> &values,
@@ -119,72 +168,78 @@ BWTREE_INDEX_TYPE::Scan(const std::vector<Value> &values,
                         const std::vector<ExpressionType> &expr_types,
                         const ScanDirectionType &scan_direction,
                         std::vector<ItemPointer> &result) {
-  KeyType index_key;
-
-  // Checkif we have leading (leftmost) column equality
-  // refer : http://www.postgresql.org/docs/8.2/static/indexes-multicolumn.html
-  oid_t leading_column_id = 0;
-  auto key_column_ids_itr = std::find(key_column_ids.begin(),
-                                      key_column_ids.end(), leading_column_id);
-
-  // SPECIAL CASE : leading column id is one of the key column ids
-  // and is involved in a equality constraint
-  bool special_case = false;
-  if (key_column_ids_itr != key_column_ids.end()) {
-    auto offset = std::distance(key_column_ids.begin(), key_column_ids_itr);
-    if (expr_types[offset] == EXPRESSION_TYPE_COMPARE_EQUAL) {
-      special_case = true;
-    }
+  // A point query is a single lookup of the key
+  std::vector<Value> point_key_values;
+  if (ConstructPointKeyValues(metadata->GetKeySchema(), values, key_column_ids,
+                              expr_types, point_key_values) == true) {
+    ScanKeyPoint(point_key_values, result);
+    return;
   }
 
-  LOG_TRACE("Special case : %d ", special_case);
-
-  // This is only a placeholder that cannot be moved but can be assigned to
-  auto scan_begin_itr = container.NullIterator();
+  std::vector<Value> low_key_values;
+  std::vector<Value> high_key_values;
 
-  std::unique_ptr<storage::Tuple> start_key;
-  bool all_constraints_are_equal = false;
-
-  // If it is a special case, we can figure out the range to scan in the index
-  if (special_case == true) {
-    start_key.reset(new storage::Tuple(metadata->GetKeySchema(), true));
-
-    // Construct the lower bound key tuple
-    all_constraints_are_equal = ConstructLowerBoundTuple(
-        start_key.get(), values, key_column_ids, expr_types);
+  // No key satisfies the predicate
+  if (ConstructKeyBounds(metadata->GetKeySchema(), values, key_column_ids,
+                         expr_types, low_key_values,
+                         high_key_values) == false) {
+    return;
+  }
 
-    LOG_TRACE("All constraints are equal : %d ", all_constraints_are_equal);
+  bool has_low_key = (low_key_values.empty() == false);
+  bool has_high_key = (high_key_values.empty() == false);
+
+  LOG_TRACE("Has low key : %d  Has high key : %d ", has_low_key,
+            has_high_key);
+
+  // The key tuples must outlive the index keys (e.g. TupleKey refers to them)
+  std::unique_ptr<storage::Tuple> low_key_tuple;
+  std::unique_ptr<storage::Tuple> high_key_tuple;
+  KeyType low_index_key;
+  KeyType high_index_key;
+
+  // Keys that could be set from the values directly need no key tuple
+  if (has_low_key == true &&
+      low_index_key.SetFromValues(metadata->GetKeySchema(),
+                                  low_key_values) == false) {
+    low_key_tuple.reset(new storage::Tuple(metadata->GetKeySchema(), true));
+    for (oid_t column_itr = 0; column_itr < low_key_values.size();
+         column_itr++) {
+      low_key_tuple->SetValue(column_itr, low_key_values[column_itr],
+                              GetPool());
+    }
 
-    index_key.SetFromKey(start_key.get());
-/*
-    // If it is point query then we just do a GetValue() since GetValue()
-    // is way more faster than scanning using iterator
-    if(all_constraints_are_equal == true) {
-      //printf("All constraints are equal\n");
-      
-      // This retrieves a list of ItemPointer
-      container.GetValue(index_key, result);
+    low_index_key.SetFromKey(low_key_tuple.get());
+  }
 
-      return;
+  if (has_high_key == true &&
+      high_index_key.SetFromValues(metadata->GetKeySchema(),
+                                   high_key_values) == false) {
+    high_key_tuple.reset(new storage::Tuple(metadata->GetKeySchema(), true));
+    for (oid_t column_itr = 0; column_itr < high_key_values.size();
+         column_itr++) {
+      high_key_tuple->SetValue(column_itr, high_key_values[column_itr],
+                               GetPool());
     }
-*/
-    //printf("Non special case\n");
 
-    // This returns an iterator pointing to index_key's values
-    scan_begin_itr = container.Begin(index_key);
-  } else {
-    scan_begin_itr = container.Begin();
+    high_index_key.SetFromKey(high_key_tuple.get());
   }
 
   switch (scan_direction) {
-    case SCAN_DIRECTION_TYPE_FORWARD:
-    case SCAN_DIRECTION_TYPE_BACKWARD: {
-      // Scan the index entries in forward direction
-      for (auto scan_itr = scan_begin_itr;
-           scan_itr.IsEnd() == false;
-           scan_itr++) {
+    case SCAN_DIRECTION_TYPE_FORWARD: {
+      auto scan_itr = (has_low_key == true) ? container.Begin(low_index_key)
+                                            : container.Begin();
+
+      // NOTE: Use prefix ++ since the postfix one copies the leaf node
+      for (; scan_itr.IsEnd() == false; ++scan_itr) {
         KeyType &scan_current_key = const_cast<KeyType &>(scan_itr->first);
-          
+
+        // We have passed the range
+        if (has_high_key == true &&
+            comparator(high_index_key, scan_current_key) == true) {
+          break;
+        }
+
         auto tuple =
             scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
 
@@ -193,11 +248,29 @@ BWTREE_INDEX_TYPE::Scan(const std::vector<Value> &values,
         // For instance, "5" EXPR_GREATER_THAN "2" is true
         if (Compare(tuple, key_column_ids, expr_types, values) == true) {
           result.push_back(scan_itr->second);
-        } else {
-          // We can stop scanning if we know that all constraints are equal
-          if (all_constraints_are_equal == true) {
-            break;
-          }
+        }
+      }
+
+    } break;
+
+    case SCAN_DIRECTION_TYPE_BACKWARD: {
+      auto scan_itr = (has_high_key == true) ? container.RBegin(high_index_key)
+                                             : container.RBegin();
+
+      // Items come in descending key order
+      for (; scan_itr.IsEnd() == false; ++scan_itr) {
+        KeyType &scan_current_key = const_cast<KeyType &>(scan_itr->first);
+
+        if (has_low_key == true &&
+            comparator(scan_current_key, low_index_key) == true) {
+          break;
+        }
+
+        auto tuple =
+            scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
+
+        if (Compare(tuple, key_column_ids, expr_types, values) == true) {
+          result.push_back(scan_itr->second);
         }
       }
 
@@ -239,6 +312,80 @@ BWTREE_INDEX_TYPE::ScanKey(const storage::Tuple *key,
   return;
 }
 
+/*
+ * ScanTupleKey() - Lookup of the key made of the indexed columns of a table
+ * tuple, without building a key tuple
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void
+BWTREE_INDEX_TYPE::ScanTupleKey(const AbstractTuple *tuple,
+                                std::vector<ItemPointer> &result) {
+  auto key_schema = metadata->GetKeySchema();
+
+  KeyType index_key;
+  if (index_key.SetFromTupleColumns(key_schema, tuple,
+                                    key_schema->GetIndexedColumns()) == false) {
+    Index::ScanTupleKey(tuple, result);
+    return;
+  }
+
+  container.GetValue(index_key, result);
+
+  return;
+}
+
+/*
+ * ScanKeyPoint() - Point lookup without building a key tuple
+ *
+ * Falls back to the key tuple if the key type could not be set from values
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void
+BWTREE_INDEX_TYPE::ScanKeyPoint(const std::vector<Value> &values,
+                                std::vector<ItemPointer> &result) {
+  KeyType index_key;
+  if (index_key.SetFromValues(metadata->GetKeySchema(), values) == false) {
+    Index::ScanKeyPoint(values, result);
+    return;
+  }
+
+  container.GetValue(index_key, result);
+
+  return;
+}
+
+/*
+ * ScanBatch() - Point lookups of a batch of keys
+ *
+ * The keys are looked up in key order inside one epoch, so neighbouring
+ * lookups share the nodes near the root in cache, and a key that appears
+ * more than once is looked up once
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void
+BWTREE_INDEX_TYPE::ScanBatch(const std::vector<std::vector<Value>> &keys,
+                             std::vector<std::vector<ItemPointer>> &results) {
+  std::vector<KeyType> index_keys(keys.size());
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    if (index_keys[key_itr].SetFromValues(metadata->GetKeySchema(),
+                                          keys[key_itr]) == false) {
+      Index::ScanBatch(keys, results);
+      return;
+    }
+  }
+
+  std::vector<size_t> search_order(keys.size());
+  std::iota(search_order.begin(), search_order.end(), 0);
+  std::sort(search_order.begin(), search_order.end(),
+            [this, &index_keys](const size_t lhs, const size_t rhs) {
+              return comparator(index_keys[lhs], index_keys[rhs]);
+            });
+
+  container.GetValueBatch(index_keys, search_order, results);
+
+  return;
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 std::string
 BWTREE_INDEX_TYPE::GetTypeName() const {
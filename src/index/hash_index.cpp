@@ -181,6 +181,30 @@ void HashIndex<KeyType, ValueType, KeyHasher, KeyComparator, KeyEqualityChecker>
 
 }
 
+/**
+ * @brief Return all locations related to each key of a batch.
+ *
+ * Probes of a hash table do not benefit from a key order, so the keys are
+ * looked up as given. One key tuple is reused for all the lookups.
+ */
+template <typename KeyType, typename ValueType, class KeyHasher,
+class KeyComparator, class KeyEqualityChecker>
+void HashIndex<KeyType, ValueType, KeyHasher, KeyComparator, KeyEqualityChecker>::ScanBatch(
+    const std::vector<std::vector<Value>> &keys,
+    std::vector<std::vector<ItemPointer>> &results) {
+  results.resize(keys.size());
+
+  storage::Tuple key(metadata->GetKeySchema(), true);
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    for (oid_t column_itr = 0; column_itr < keys[key_itr].size();
+         column_itr++) {
+      key.SetValue(column_itr, keys[key_itr][column_itr], GetPool());
+    }
+
+    ScanKey(&key, results[key_itr]);
+  }
+}
+
 template <typename KeyType, typename ValueType, class KeyHasher,
 class KeyComparator, class KeyEqualityChecker>
 std::string HashIndex<KeyType, ValueType, KeyHasher, KeyComparator,
@@ -289,6 +289,84 @@ bool Index::ConstructLowerBoundTuple(
   return all_constraints_equal;
 }
 
+/*
+ * SetKeyFromTuple() - Copy the indexed columns of a table tuple into a key
+ */
+static void SetKeyFromTuple(storage::Tuple &key, const AbstractTuple *tuple,
+                            VarlenPool *pool) {
+  const auto &indexed_columns = key.GetSchema()->GetIndexedColumns();
+
+  oid_t this_col_itr = 0;
+  for (auto col : indexed_columns) {
+    key.SetValue(this_col_itr, tuple->GetValue(col), pool);
+    this_col_itr++;
+  }
+}
+
+/*
+ * InsertTupleEntry() - Insert the entry keyed by the indexed columns of a
+ * table tuple
+ *
+ * Index types that could build their keys from the tuple directly override
+ * this and the following to skip the key tuple
+ */
+bool Index::InsertTupleEntry(const AbstractTuple *tuple,
+                             const ItemPointer &location) {
+  storage::Tuple key(metadata->GetKeySchema(), true);
+  SetKeyFromTuple(key, tuple, GetPool());
+
+  return InsertEntry(&key, location);
+}
+
+bool Index::DeleteTupleEntry(const AbstractTuple *tuple,
+                             const ItemPointer &location) {
+  storage::Tuple key(metadata->GetKeySchema(), true);
+  SetKeyFromTuple(key, tuple, GetPool());
+
+  return DeleteEntry(&key, location);
+}
+
+void Index::ScanTupleKey(const AbstractTuple *tuple,
+                         std::vector<ItemPointer> &result) {
+  storage::Tuple key(metadata->GetKeySchema(), true);
+  SetKeyFromTuple(key, tuple, GetPool());
+
+  ScanKey(&key, result);
+}
+
+/*
+ * ScanKeyPoint() - Point lookup given the values of all key columns
+ *
+ * Index types that could build their keys from values directly override
+ * this to skip the key tuple
+ */
+void Index::ScanKeyPoint(const std::vector<Value> &values,
+                         std::vector<ItemPointer> &result) {
+  auto schema = metadata->GetKeySchema();
+  PL_ASSERT(values.size() == schema->GetColumnCount());
+
+  storage::Tuple key(schema, true);
+  for (oid_t column_itr = 0; column_itr < values.size(); column_itr++) {
+    key.SetValue(column_itr, values[column_itr], GetPool());
+  }
+
+  ScanKey(&key, result);
+}
+
+/*
+ * ScanBatch() - Point lookups of a batch of keys
+ *
+ * Index types override this to share work across the keys of the batch
+ */
+void Index::ScanBatch(const std::vector<std::vector<Value>> &keys,
+                      std::vector<std::vector<ItemPointer>> &results) {
+  results.resize(keys.size());
+
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    ScanKeyPoint(keys[key_itr], results[key_itr]);
+  }
+}
+
 Index::Index(IndexMetadata *metadata) :
         metadata(metadata),
         indexed_tile_group_offset_(0) {
@@ -41,8 +41,12 @@ Index *IndexFactory::GetInstance(IndexMetadata *metadata) {
     ints_only = false;
   }
 
-  // TODO: Disable ints only for now
-  ints_only = false;
+  // Only the BwTree uses IntsKey. The other indexes still treat their keys
+  // as tuple storage, which the packed words of an IntsKey are not, so they
+  // keep using GenericKey
+  if (index_type != INDEX_TYPE_BWTREE) {
+    ints_only = false;
+  }
   LOG_TRACE("Ints Only : %d", ints_only);
 
   //===--------------------------------------------------------------------===//
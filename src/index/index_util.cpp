@@ -13,6 +13,7 @@
 #include <cassert>
 #include <map>
 
+#include "catalog/schema.h"
 #include "common/types.h"
 #include "common/logger.h"
 #include "common/value.h"
@@ -195,5 +196,150 @@ void FindMaxMinInColumns(oid_t leading_column_id,
   }
 };
 
+/*
+ * ConstructKeyBounds() - Derive the range [low, high] of index keys that
+ *                        may satisfy a predicate
+ *
+ * The predicate has the same specification as those in Scan(). Keys are
+ * ordered by their leading column first, so the range is fixed by the
+ * leading columns that have an "==" predicate, plus the bounds of the next
+ * column if it has any; the remaining columns are filled with the min value
+ * of their type in the low key and the max value in the high key. Keys in
+ * the range still need to be checked against the predicate.
+ *
+ * Either vector is left empty if the range is not bounded on that side.
+ * Since there is no max value of a varlen type that could be stored in a key,
+ * the high key is also left empty if it needs one.
+ *
+ * Returns false if no key could satisfy the predicate
+ */
+bool ConstructKeyBounds(const catalog::Schema *key_schema,
+                        const std::vector<Value> &values,
+                        const std::vector<oid_t> &key_column_ids,
+                        const std::vector<ExpressionType> &expr_types,
+                        std::vector<Value> &low_key_values,
+                        std::vector<Value> &high_key_values) {
+  auto col_count = key_schema->GetColumnCount();
+
+  low_key_values.clear();
+  high_key_values.clear();
+
+  // Whether all columns so far are fixed by an "=="
+  bool is_prefix = true;
+  bool has_low = false;
+  bool has_high = false;
+  bool high_is_storable = true;
+
+  for (oid_t column_itr = 0; column_itr < col_count; column_itr++) {
+    auto value_type = key_schema->GetType(column_itr);
+    Value low_value = Value::GetMinValue(value_type);
+    Value high_value;
+    bool column_has_low = false;
+    bool column_has_high = false;
+    bool column_is_equal = false;
+
+    for (size_t i = 0; is_prefix == true && i < key_column_ids.size(); i++) {
+      if (key_column_ids[i] != column_itr || column_is_equal == true) {
+        continue;
+      }
+
+      // Keep the tightest bound on each side, an "==" bounds both
+      if (expr_types[i] == EXPRESSION_TYPE_COMPARE_EQUAL) {
+        low_value = values[i];
+        high_value = values[i];
+        column_has_low = column_has_high = column_is_equal = true;
+      } else if (IfForwardExpression(expr_types[i])) {
+        if (column_has_low == false ||
+            low_value.Compare(values[i]) == VALUE_COMPARE_LESSTHAN) {
+          low_value = values[i];
+          column_has_low = true;
+        }
+      } else if (IfBackwardExpression(expr_types[i])) {
+        if (column_has_high == false ||
+            high_value.Compare(values[i]) == VALUE_COMPARE_GREATERTHAN) {
+          high_value = values[i];
+          column_has_high = true;
+        }
+      }
+    }
+
+    if (column_has_low == true && column_has_high == true &&
+        low_value.Compare(high_value) == VALUE_COMPARE_GREATERTHAN) {
+      return false;
+    }
+
+    if (column_itr == 0) {
+      has_low = column_has_low;
+      has_high = column_has_high;
+    }
+
+    // There is no max value of a varlen type that fits in a key
+    if (column_has_high == false) {
+      if (key_schema->IsInlined(column_itr) == true &&
+          value_type != VALUE_TYPE_VARCHAR &&
+          value_type != VALUE_TYPE_VARBINARY) {
+        high_value = Value::GetMaxValue(value_type);
+      } else {
+        high_is_storable = false;
+      }
+    }
+
+    low_key_values.push_back(low_value);
+    high_key_values.push_back(high_value);
+
+    is_prefix = column_is_equal;
+  }
+
+  if (has_low == false) {
+    low_key_values.clear();
+  }
+
+  if (has_high == false || high_is_storable == false) {
+    high_key_values.clear();
+  }
+
+  return true;
+}
+
+/*
+ * ConstructPointKeyValues() - Collect the key values of a point query
+ *
+ * The predicate is a point query if it only has "==" and each key column has
+ * exactly one. The values are put in key column order as taken by
+ * Index::ScanKeyPoint().
+ *
+ * Returns false if the predicate is not a point query
+ */
+bool ConstructPointKeyValues(const catalog::Schema *key_schema,
+                             const std::vector<Value> &values,
+                             const std::vector<oid_t> &key_column_ids,
+                             const std::vector<ExpressionType> &expr_types,
+                             std::vector<Value> &key_values) {
+  auto col_count = key_schema->GetColumnCount();
+
+  key_values.clear();
+
+  if (key_column_ids.size() != col_count) {
+    return false;
+  }
+
+  key_values.resize(col_count);
+  std::vector<bool> has_value(col_count, false);
+
+  for (size_t i = 0; i < key_column_ids.size(); i++) {
+    oid_t column_id = key_column_ids[i];
+    if (expr_types[i] != EXPRESSION_TYPE_COMPARE_EQUAL ||
+        column_id >= col_count || has_value[column_id] == true) {
+      key_values.clear();
+      return false;
+    }
+
+    key_values[column_id] = values[i];
+    has_value[column_id] = true;
+  }
+
+  return true;
+}
+
 }  // End index namespace
 }  // End peloton namespace
@@ -11,6 +11,8 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <numeric>
+
 #include "index/skip_list_index.h"
 #include "index/index_key.h"
 #include "index/index_util.h"
@@ -367,6 +369,53 @@ void SkipListIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::ScanK
 
 }
 
+/**
+ * @brief Return all locations related to each key of a batch.
+ *
+ * The keys are looked up in key order, so that neighbouring lookups find the
+ * upper levels of the skip list in cache, and a key that appears more than
+ * once is looked up once. One key tuple is reused for all the lookups.
+ */
+template <typename KeyType, typename ValueType, class KeyComparator,
+class KeyEqualityChecker>
+void SkipListIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::ScanBatch(
+    const std::vector<std::vector<Value>> &keys,
+    std::vector<std::vector<ItemPointer>> &results) {
+  results.resize(keys.size());
+
+  auto compare_keys = [&keys](const size_t lhs, const size_t rhs) {
+    return std::lexicographical_compare(
+        keys[lhs].begin(), keys[lhs].end(), keys[rhs].begin(), keys[rhs].end(),
+        [](const Value &lhs_value, const Value &rhs_value) {
+          return lhs_value.Compare(rhs_value) < 0;
+        });
+  };
+
+  std::vector<size_t> search_order(keys.size());
+  std::iota(search_order.begin(), search_order.end(), 0);
+  std::sort(search_order.begin(), search_order.end(), compare_keys);
+
+  storage::Tuple key(metadata->GetKeySchema(), true);
+  for (size_t search_itr = 0; search_itr < search_order.size(); search_itr++) {
+    auto key_itr = search_order[search_itr];
+
+    if (search_itr > 0) {
+      auto prev_key_itr = search_order[search_itr - 1];
+      if (compare_keys(prev_key_itr, key_itr) == false) {
+        results[key_itr] = results[prev_key_itr];
+        continue;
+      }
+    }
+
+    for (oid_t column_itr = 0; column_itr < keys[key_itr].size();
+         column_itr++) {
+      key.SetValue(column_itr, keys[key_itr][column_itr], GetPool());
+    }
+
+    ScanKey(&key, results[key_itr]);
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename KeyType, typename ValueType, class KeyComparator,
@@ -71,11 +71,19 @@ void SimpleCheckpoint::DoCheckpoint() {
     logger_.reset(BackendLogger::GetBackendLogger(LOGGING_TYPE_NVM_WAL));
   }
 
+  // the checkpoint reads the versions of start_commit_id_, rebuilding them
+  // from the rollback segments of the tuples updated in place since. its
+  // epoch keeps those segments from being reclaimed during the scan.
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  auto epoch_id = epoch_manager.EnterEpoch();
+
   start_commit_id_ = log_manager.GetGlobalMaxFlushedCommitId();
   if (start_commit_id_ == INVALID_CID) {
     auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
     start_commit_id_ = txn_manager.GetMaxCommittedCid();
   }
+  epoch_manager.SetBeginCid(epoch_id, start_commit_id_);
+  epoch_manager.WaitForCommits(start_commit_id_);
 
   LOG_TRACE("DoCheckpoint cid = %lu", start_commit_id_);
 
@@ -106,6 +114,8 @@ void SimpleCheckpoint::DoCheckpoint() {
     }
   }
 
+  epoch_manager.ExitEpoch(epoch_id);
+
   // Add txn commit record
   std::shared_ptr<LogRecord> commit_record(new TransactionRecord(
       LOGRECORD_TYPE_TRANSACTION_COMMIT, start_commit_id_));
@@ -234,6 +244,12 @@ void SimpleCheckpoint::Scan(storage::DataTable *target_table,
     // Retrieve a tile group
     auto tile_group = target_table->GetTileGroup(current_tile_group_offset);
 
+    // Skip the tile group if it was dropped by compaction
+    if (tile_group == nullptr) {
+      current_tile_group_offset++;
+      continue;
+    }
+
     // Retrieve a logical tile
     std::unique_ptr<executor::LogicalTile> logical_tile(
         scanner.Scan(tile_group, column_ids, start_commit_id_));
@@ -244,9 +260,7 @@ void SimpleCheckpoint::Scan(storage::DataTable *target_table,
       continue;
     }
 
-    auto tile_group_id = logical_tile->GetColumnInfo(0)
-                             .base_tile->GetTileGroup()
-                             ->GetTileGroupId();
+    auto tile_group_id = tile_group->GetTileGroupId();
 
     // Go over the logical tile
     for (oid_t tuple_id : *logical_tile) {
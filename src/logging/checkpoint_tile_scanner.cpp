@@ -11,9 +11,14 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <numeric>
+
 #include "common/macros.h"
 #include "logging/checkpoint_tile_scanner.h"
+#include "catalog/schema.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "storage/tile_group_header.h"
+#include "storage/data_table.h"
 #include "executor/logical_tile_factory.h"
 
 namespace peloton {
@@ -25,66 +30,56 @@ namespace logging {
 std::unique_ptr<executor::LogicalTile> CheckpointTileScanner::Scan(
     std::shared_ptr<storage::TileGroup> tile_group,
     const std::vector<oid_t> &column_ids, cid_t start_cid) {
-  // Retrieve next tile group.
-  auto tile_group_header = tile_group->GetHeader();
+  // The tile group was dropped by compaction
+  if (tile_group == nullptr) {
+    return nullptr;
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto table_schema = tile_group->GetAbstractTable()->GetSchema();
 
   oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
-  // Construct position list by looping through tile group
-  // and applying the predicate.
-  std::vector<oid_t> position_list;
+  // Every tuple slot keeps its offset in the logical tile, so that the
+  // callers can locate the tuples. The tuples may be updated in place after
+  // start_cid, so the versions of start_cid are copied into a temporary tile,
+  // rebuilt from the rollback segments where needed.
+  std::vector<oid_t> position_list(active_tuple_count);
+  std::iota(position_list.begin(), position_list.end(), 0);
+
+  std::unique_ptr<catalog::Schema> schema(
+      catalog::Schema::CopySchema(table_schema, column_ids));
+  std::shared_ptr<storage::Tile> tile(storage::TileFactory::GetTile(
+      BACKEND_TYPE_MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
+      nullptr, *schema, tile_group.get(), active_tuple_count));
+
+  std::unique_ptr<VarlenPool> pool(new VarlenPool(BACKEND_TYPE_MM));
+  storage::Tuple tuple(table_schema, true);
+  std::vector<oid_t> invisible_tuple_ids;
   for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-    // check transaction visibility
-    if (IsVisible(tile_group_header, tuple_id, start_cid)) {
-      position_list.push_back(tuple_id);
+    if (txn_manager.ReadCommittedVersion(tile_group.get(), tuple_id, start_cid,
+                                         &tuple, pool.get()) == false) {
+      invisible_tuple_ids.push_back(tuple_id);
+      continue;
+    }
+    for (oid_t col_itr = 0; col_itr < column_ids.size(); col_itr++) {
+      tile->SetValue(tuple.GetValue(column_ids[col_itr]), tuple_id, col_itr);
     }
   }
 
-  // Construct logical tile.
   std::unique_ptr<executor::LogicalTile> logical_tile(
       executor::LogicalTileFactory::GetTile());
-  logical_tile->AddColumns(tile_group, column_ids);
+  const int position_list_idx = 0;
+  for (oid_t col_itr = 0; col_itr < column_ids.size(); col_itr++) {
+    logical_tile->AddColumn(tile, col_itr, position_list_idx);
+  }
   logical_tile->AddPositionList(std::move(position_list));
 
-  return std::move(logical_tile);
-}
-
-// Same visibility check logic as optimistic concurrency control
-// where dirty read is not allowed
-bool CheckpointTileScanner::IsVisible(
-    const storage::TileGroupHeader *const tile_group_header,
-    const oid_t &tuple_id, cid_t start_cid) {
-  txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
-  cid_t tuple_begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
-  cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
-  if (tuple_txn_id == INVALID_TXN_ID) {
-    // the tuple is not available.
-    return false;
+  for (auto tuple_id : invisible_tuple_ids) {
+    logical_tile->RemoveVisibility(tuple_id);
   }
 
-  bool activated = (start_cid >= tuple_begin_cid);
-  bool invalidated = (start_cid >= tuple_end_cid);
-  if (tuple_txn_id != INITIAL_TXN_ID) {
-    // if the tuple is owned by other transactions.
-    if (tuple_begin_cid == MAX_CID) {
-      // never read an uncommitted version.
-      return false;
-    } else {
-      // the older version may be visible.
-      if (activated && !invalidated) {
-        return true;
-      } else {
-        return false;
-      }
-    }
-  } else {
-    // if the tuple is not owned by any transaction.
-    if (activated && !invalidated) {
-      return true;
-    } else {
-      return false;
-    }
-  }
+  return std::move(logical_tile);
 }
 
 }  // namespace logging
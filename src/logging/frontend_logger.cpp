@@ -174,12 +174,13 @@ void FrontendLogger::MainLoop(void) {
  * @brief Collect the log records from BackendLoggers
  */
 void FrontendLogger::CollectLogRecordsFromBackendLoggers() {
+  auto &log_manager = LogManager::GetInstance();
+
+  // collect early once a group of commits waits for a flush
   auto sleep_period = std::chrono::microseconds(wait_timeout);
-  std::this_thread::sleep_for(sleep_period);
+  log_manager.WaitForGroupCommit(sleep_period, max_flushed_commit_id);
   int debug_flag = 0;
 
-  auto &log_manager = LogManager::GetInstance();
-
   {
     cid_t max_committed_cid = 0;
     cid_t lower_bound = MAX_CID;
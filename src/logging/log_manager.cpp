@@ -32,7 +32,9 @@ namespace logging {
 // Each thread gets a backend logger
 thread_local static BackendLogger *backend_logger = nullptr;
 
-LogManager::LogManager() {
+LogManager::LogManager()
+    : pending_commit_count_(0),
+      group_commit_size_(std::max(peloton_group_commit_size, 1)) {
   Configure(peloton_logging_mode, false, DEFAULT_NUM_FRONTEND_LOGGERS,
             LOGGER_MAPPING_TYPE_ROUND_ROBIN);
 }
@@ -264,15 +266,24 @@ void LogManager::LogDelete(cid_t commit_id,
   }
 }
 
-void LogManager::LogCommitTransaction(cid_t commit_id) {
+void LogManager::LogCommitTransaction(
+    cid_t commit_id, const concurrency::CommitCallback &callback) {
   if (this->IsInLoggingMode()) {
     auto logger = this->GetBackendLogger();
+    // queue the commit so that the frontend loggers flush it with a group.
+    // it is queued before its record is logged, so the acknowledgement of
+    // the flush that covers it finds it in the queue.
+    if (syncronization_commit || callback) {
+      EnqueueCommit(commit_id, callback);
+    }
     TransactionRecord record(LOGRECORD_TYPE_TRANSACTION_COMMIT, commit_id);
     logger->Log(&record);
     if (syncronization_commit) {
       WaitForFlush(commit_id);
     }
     logger->GetVarlenPool()->Purge();
+  } else if (callback) {
+    callback(commit_id);
   }
 }
 
@@ -409,9 +420,8 @@ void LogManager::DoneRecovery() {
     auto table_count = database->GetTableCount();
     for (oid_t table_idx = 0; table_idx < table_count; table_idx++) {
       auto table = database->GetTable(table_idx);
-      if (table->GetTileGroupCount() == 0) {
-        table->AddDefaultTileGroup();
-      }
+      // refill the active tile groups dropped by PrepareRecovery
+      table->AddActiveTileGroups();
     }
   }
 }
@@ -467,7 +477,69 @@ cid_t LogManager::GetPersistentFlushedCommitId() {
   return persistent_flushed_commit_id;
 }
 
+/**
+ * @brief Queue a commit until the frontend loggers flush it.
+ *  Commits are flushed once a group of them is queued or the frontend
+ *  loggers time out, so a flush covers many transactions.
+ */
+void LogManager::EnqueueCommit(cid_t commit_id,
+                               const concurrency::CommitCallback &callback) {
+  {
+    std::lock_guard<std::mutex> lock(commit_queue_mutex_);
+    commit_queue_.emplace(commit_id, callback);
+    pending_commit_count_++;
+  }
+
+  // the commit was flushed before it was queued, so no later flush
+  // acknowledges it.
+  if (commit_id <= GetPersistentFlushedCommitId()) {
+    AcknowledgeCommits();
+    return;
+  }
+
+  if (IsGroupCommitFull()) {
+    commit_queue_cv_.notify_all();
+  }
+}
+
+void LogManager::AcknowledgeCommits() {
+  std::vector<std::pair<cid_t, concurrency::CommitCallback>> acknowledged;
+
+  {
+    std::lock_guard<std::mutex> lock(commit_queue_mutex_);
+    auto persistent_flushed_commit_id = GetPersistentFlushedCommitId();
+    auto end_itr = commit_queue_.upper_bound(persistent_flushed_commit_id);
+
+    for (auto itr = commit_queue_.begin(); itr != end_itr; ++itr) {
+      if (itr->second) {
+        acknowledged.emplace_back(itr->first, std::move(itr->second));
+      }
+      pending_commit_count_--;
+    }
+    commit_queue_.erase(commit_queue_.begin(), end_itr);
+  }
+
+  // run the callbacks without holding the queue
+  for (auto &commit : acknowledged) {
+    commit.second(commit.first);
+  }
+}
+
+// a frontend logger that flushed every queued commit has nothing to add to
+// the group, the commits wait for a lagging logger. it sleeps until the
+// timeout instead of flushing again.
+void LogManager::WaitForGroupCommit(std::chrono::microseconds timeout,
+                                    cid_t max_flushed_commit_id) {
+  std::unique_lock<std::mutex> wait_lock(commit_queue_mutex_);
+  commit_queue_cv_.wait_for(wait_lock, timeout, [this, max_flushed_commit_id] {
+    return IsGroupCommitFull() &&
+           commit_queue_.rbegin()->first > max_flushed_commit_id;
+  });
+}
+
 void LogManager::FrontendLoggerFlushed() {
+  AcknowledgeCommits();
+
   {
     std::unique_lock<std::mutex> wait_lock(flush_notify_mutex);
     flush_notify_cv.notify_all();
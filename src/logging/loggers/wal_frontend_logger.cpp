@@ -163,6 +163,14 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
 
   bool flushed = false;
 
+  // a full group of queued commits is flushed without waiting for the
+  // flush frequency, as is everything when logging terminates
+  auto &log_manager = LogManager::GetInstance();
+  bool should_flush =
+      log_manager.IsGroupCommitFull() ||
+      log_manager.GetLoggingStatus() != LOGGING_STATUS_TYPE_LOGGING ||
+      Clock::now() > last_flush + flush_frequency;
+
   if (max_collected_commit_id != max_flushed_commit_id) {
     if (!test_mode_) {
       PL_ASSERT(cur_file_handle.fd != -1);
@@ -176,7 +184,7 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
 
         // by moving the fflush and sync here, we ensure that this file will
         // have at least 1 delimiter
-        if (Clock::now() > last_flush + flush_frequency) {
+        if (should_flush) {
           if (!no_write_) {
             LoggingUtil::FFlushFsync(cur_file_handle);
           }
@@ -197,7 +205,7 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
         if (FileSwitchCondIsTrue()) should_create_new_file = true;
       }
     } else {
-      if (Clock::now() > last_flush + flush_frequency) {
+      if (should_flush) {
         last_flush = Clock::now();
         if (this->max_collected_commit_id > max_flushed_commit_id) {
           max_flushed_commit_id = this->max_collected_commit_id;
@@ -214,7 +222,7 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
 
   if (flushed) {
     // signal that we have flushed
-    LogManager::GetInstance().FrontendLoggerFlushed();
+    log_manager.FrontendLoggerFlushed();
   }
 }
 
@@ -427,6 +435,12 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
     // Retrieve a tile group
     auto tile_group = target_table->GetTileGroup(current_tile_group_offset);
 
+    // Skip the tile group if it was dropped by compaction
+    if (tile_group == nullptr) {
+      current_tile_group_offset++;
+      continue;
+    }
+
     // Retrieve a logical tile
     std::unique_ptr<executor::LogicalTile> logical_tile(
         scanner.Scan(tile_group, column_ids, start_cid));
@@ -437,9 +451,7 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
       continue;
     }
 
-    auto tile_group_id = logical_tile->GetColumnInfo(0)
-                             .base_tile->GetTileGroup()
-                             ->GetTileGroupId();
+    auto tile_group_id = tile_group->GetTileGroupId();
     LOG_TRACE("Retrieved tile group %u", tile_group_id);
 
     // Go over the logical tile
@@ -476,12 +488,7 @@ void WriteAheadFrontendLogger::InsertIndexEntry(storage::Tuple *tuple,
 
   for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
     auto index = table->GetIndex(index_itr);
-    auto index_schema = index->GetKeySchema();
-    auto indexed_columns = index_schema->GetIndexedColumns();
-    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-    key->SetFromTuple(tuple, indexed_columns, index->GetPool());
-
-    index->InsertEntry(key.get(), target_location);
+    index->InsertTupleEntry(tuple, target_location);
     // Increase the indexes' number of tuples by 1 as well
     index->IncreaseNumberOfTuplesBy(1);
   }
@@ -631,6 +638,12 @@ void UpdateTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
   InsertTupleHelper(max_tg, commit_id, db_id, table_id, insert_loc, tuple,
                     false);
 
+  // an update in place overwrote the version, which stays the latest one.
+  if (remove_loc.block == insert_loc.block &&
+      remove_loc.offset == insert_loc.offset) {
+    return;
+  }
+
   tile_group->UpdateTupleFromRecovery(commit_id, remove_loc.offset, insert_loc);
 }
 
@@ -32,12 +32,14 @@ void Usage() {
       "   -f --index_usage_type              :  Types of indexes used\n"
       "   -g --tuples_per_tg                 :  # of tuples per tilegroup\n"
       "   -h --help                          :  Print help message\n"
+      "   -j --compact_tile_groups           :  Compact sparse tile groups\n"
       "   -k --scale-factor                  :  # of tile groups\n"
       "   -l --layout                        :  Layout\n"
       "   -m --max_tile_groups_indexed       :  Max tile groups indexed\n"
       "   -o --convergence                   :  Convergence\n"
       "   -p --projectivity                  :  Projectivity\n"
       "   -q --total_ops                     :  # of operations\n"
+      "   -r --freeze_tile_groups            :  Freeze cold tile groups\n"
       "   -s --selectivity                   :  Selectivity\n"
       "   -t --phase_length                  :  Length of a phase\n"
       "   -u --write_complexity_type         :  Complexity of write\n"
@@ -57,12 +59,14 @@ static struct option opts[] = {
     {"sample_count_threshold", optional_argument, NULL, 'e'},
     {"index_usage_type", optional_argument, NULL, 'f'},
     {"tuples_per_tg", optional_argument, NULL, 'g'},
+    {"compact_tile_groups", optional_argument, NULL, 'j'},
     {"scale-factor", optional_argument, NULL, 'k'},
     {"layout", optional_argument, NULL, 'l'},
     {"max_tile_groups_indexed", optional_argument, NULL, 'm'},
     {"convergence", optional_argument, NULL, 'o'},
     {"projectivity", optional_argument, NULL, 'p'},
     {"total_ops", optional_argument, NULL, 'q'},
+    {"freeze_tile_groups", optional_argument, NULL, 'r'},
     {"selectivity", optional_argument, NULL, 's'},
     {"phase_length", optional_argument, NULL, 't'},
     {"write_complexity_type", optional_argument, NULL, 'u'},
@@ -281,6 +285,18 @@ static void ValidateConvergence(const configuration &state) {
   }
 }
 
+static void ValidateFreezeTileGroups(const configuration &state) {
+  if (state.freeze_tile_groups == true) {
+    LOG_INFO("%s : %s", "freeze_tile_groups", "true");
+  }
+}
+
+static void ValidateCompactTileGroups(const configuration &state) {
+  if (state.compact_tile_groups == true) {
+    LOG_INFO("%s : %s", "compact_tile_groups", "true");
+  }
+}
+
 static void ValidateQueryConvergenceThreshold(const configuration &state) {
   if (state.convergence_query_threshold <= 0) {
     LOG_ERROR("Invalid convergence_query_threshold :: %u",
@@ -375,16 +391,20 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.index_count_threshold = 10;
   state.write_ratio_threshold = 0.75;
 
+  // Background maintenance
+  state.freeze_tile_groups = false;
+  state.compact_tile_groups = false;
+
   // Parse args
   while (1) {
     int idx = 0;
     int c = getopt_long(
-        argc, argv, "a:b:c:d:e:f:g:hk:l:m:o:p:q:s:t:u:v:w:x:y:z:", opts, &idx);
+        argc, argv, "a:b:c:d:e:f:g:hj:k:l:m:o:p:q:r:s:t:u:v:w:x:y:z:", opts, &idx);
 
     if (c == -1) break;
 
     switch (c) {
-      // AVAILABLE FLAGS: ijnrABCDEFGHIJKLMNOPQRSTUVWXYZ
+      // AVAILABLE FLAGS: inABCDEFGHIJKLMNOPQRSTUVWXYZ
       case 'a':
         state.attribute_count = atoi(optarg);
         break;
@@ -409,6 +429,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'h':
         Usage();
         break;
+      case 'j':
+        state.compact_tile_groups = atoi(optarg);
+        break;
 
       case 'k':
         state.scale_factor = atoi(optarg);
@@ -429,6 +452,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'q':
         state.total_ops = atol(optarg);
         break;
+      case 'r':
+        state.freeze_tile_groups = atoi(optarg);
+        break;
 
       case 's':
         state.selectivity = atof(optarg);
@@ -497,6 +523,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateConvergence(state);
   ValidateQueryConvergenceThreshold(state);
   ValidateVariabilityThreshold(state);
+  ValidateFreezeTileGroups(state);
+  ValidateCompactTileGroups(state);
 }
 
 }  // namespace sdbench
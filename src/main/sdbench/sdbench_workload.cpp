@@ -22,6 +22,8 @@
 
 #include "brain/index_tuner.h"
 #include "brain/layout_tuner.h"
+#include "brain/tile_group_compactor.h"
+#include "brain/tile_group_freezer.h"
 #include "brain/sample.h"
 
 #include "benchmark/sdbench/sdbench_loader.h"
@@ -104,6 +106,14 @@ brain::IndexTuner &index_tuner = brain::IndexTuner::GetInstance();
 // Layout tuner
 brain::LayoutTuner &layout_tuner = brain::LayoutTuner::GetInstance();
 
+// Tile group freezer
+brain::TileGroupFreezer &tile_group_freezer =
+    brain::TileGroupFreezer::GetInstance();
+
+// Tile group compactor
+brain::TileGroupCompactor &tile_group_compactor =
+    brain::TileGroupCompactor::GetInstance();
+
 static int GetLowerBound() {
   int tuple_count = state.scale_factor * state.tuples_per_tilegroup;
   int predicate_offset = 0.1 * tuple_count;
@@ -1385,6 +1395,20 @@ void RunSDBenchTest() {
     layout_tuner.Start();
   }
 
+  // Start tile group freezer
+  if (state.freeze_tile_groups == true) {
+    tile_group_freezer.AddTable(sdbench_table.get());
+
+    tile_group_freezer.Start();
+  }
+
+  // Start tile group compactor
+  if (state.compact_tile_groups == true) {
+    tile_group_compactor.AddTable(sdbench_table.get());
+
+    tile_group_compactor.Start();
+  }
+
   // seed generator
   srand(generator_seed);
 
@@ -1420,6 +1444,16 @@ void RunSDBenchTest() {
     layout_tuner.ClearTables();
   }
 
+  if (state.freeze_tile_groups == true) {
+    tile_group_freezer.Stop();
+    tile_group_freezer.ClearTables();
+  }
+
+  if (state.compact_tile_groups == true) {
+    tile_group_compactor.Stop();
+    tile_group_compactor.ClearTables();
+  }
+
   // Drop Indexes
   DropIndexes();
 
@@ -20,6 +20,10 @@
 #include "benchmark/tpcc/tpcc_workload.h"
 
 #include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+
+// Longest time (in us) a writer waits for the owner of a version
+extern int peloton_ownership_wait_us;
 
 namespace peloton {
 namespace benchmark {
@@ -29,18 +33,32 @@ configuration state;
 
 std::ofstream out("outputfile.summary");
 
+// Wait for owners (in us) of the protocol that runs
+static int protocol_ownership_wait_us = 0;
+
 static void WriteOutput(double stat) {
   LOG_INFO("----------------------------------------------------------");
-  LOG_INFO("%d %d :: %lf", state.scale_factor, state.backend_count, stat);
+  LOG_INFO("%s %d %d %d :: %lf %lf",
+           ConcurrencyTypeToString(state.protocol).c_str(),
+           protocol_ownership_wait_us, state.scale_factor, state.backend_count,
+           stat, state.abort_rate);
 
+  out << ConcurrencyTypeToString(state.protocol) << " ";
+  out << protocol_ownership_wait_us << " ";
   out << state.backend_count << " ";
-  out << stat << "\n";
+  out << stat << " ";
+  out << state.abort_rate << "\n";
   out.flush();
-  out.close();
 }
 
-// Main Entry Point
-void RunBenchmark() {
+static void RunProtocol(ConcurrencyType protocol) {
+  state.protocol = protocol;
+  concurrency::TransactionManagerFactory::Configure(protocol);
+
+  // The wait for owners this protocol runs with
+  protocol_ownership_wait_us =
+      concurrency::TransactionManagerFactory::GetInstance().GetOwnershipWait();
+
   // Create the database
   CreateTPCCDatabase();
 
@@ -50,10 +68,24 @@ void RunBenchmark() {
   // Run the workload
   RunWorkload();
 
-  // Emit throughput
+  // Emit throughput and abort rate
   WriteOutput(state.throughput);
 }
 
+// Main Entry Point
+void RunBenchmark() {
+  peloton_ownership_wait_us = state.ownership_wait_us;
+
+  if (state.compare_protocols == false) {
+    RunProtocol(state.protocol);
+    return;
+  }
+
+  // Run the same workload with each protocol
+  RunProtocol(CONCURRENCY_TYPE_TO);
+  RunProtocol(CONCURRENCY_TYPE_OPTIMISTIC);
+}
+
 }  // namespace tpcc
 }  // namespace benchmark
 }  // namespace peloton
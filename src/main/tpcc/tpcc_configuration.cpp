@@ -30,6 +30,9 @@ void Usage(FILE *out) {
           "   -k --warehouse_count   :  warehouse count \n"
           "   -t --transaction-count :  # of transactions \n"
           "   -i --index             :  index type \n"
+          "   -p --protocol          :  concurrency control protocol \n"
+          "   -m --compare           :  run with each protocol \n"
+          "   -w --wait              :  max wait for owners (in us), -1 for the protocol default \n"
   );
 }
 
@@ -39,6 +42,9 @@ static struct option opts[] = {
     { "warehouse_count", optional_argument, NULL, 'k' },
     { "transaction_count", optional_argument, NULL, 't'},
     { "index", optional_argument, NULL, 'i'},
+    { "protocol", optional_argument, NULL, 'p'},
+    { "compare", no_argument, NULL, 'm'},
+    { "wait", optional_argument, NULL, 'w'},
     { NULL, 0, NULL, 0}
 };
 
@@ -89,6 +95,28 @@ void ValidateIndexType(const configuration &state) {
   LOG_INFO("%s : %s", "index type", IndexTypeToString(state.index_type).c_str());
 }
 
+void ValidateProtocol(const configuration &state) {
+  if (state.protocol != CONCURRENCY_TYPE_TO &&
+      state.protocol != CONCURRENCY_TYPE_OPTIMISTIC) {
+    LOG_ERROR("Invalid protocol : %s",
+              ConcurrencyTypeToString(state.protocol).c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %s", "protocol",
+           ConcurrencyTypeToString(state.protocol).c_str());
+  LOG_INFO("%s : %d", "compare_protocols", state.compare_protocols);
+}
+
+void ValidateOwnershipWait(const configuration &state) {
+  if (state.ownership_wait_us < -1) {
+    LOG_ERROR("Invalid ownership_wait_us :: %d", state.ownership_wait_us);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %d", "ownership_wait_us", state.ownership_wait_us);
+}
+
 void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.duration = 1000;
@@ -96,11 +124,14 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.warehouse_count = 2;  // 10
   state.transaction_count = 0;
   state.index_type = INDEX_TYPE_HASH;
+  state.protocol = CONCURRENCY_TYPE_TO;
+  state.compare_protocols = false;
+  state.ownership_wait_us = -1;
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "ah:b:d:k:t:i:", opts, &idx);
+    int c = getopt_long(argc, argv, "ah:b:d:k:t:i:p:mw:", opts, &idx);
 
     if (c == -1) break;
 
@@ -120,6 +151,15 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'i':
         state.index_type = (peloton::IndexType) atoi(optarg);
         break;
+      case 'p':
+        state.protocol = (peloton::ConcurrencyType) atoi(optarg);
+        break;
+      case 'm':
+        state.compare_protocols = true;
+        break;
+      case 'w':
+        state.ownership_wait_us = atoi(optarg);
+        break;
 
       case 'h':
         Usage(stderr);
@@ -145,6 +185,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateDuration(state);
   ValidateTransactionCount(state);
   ValidateIndexType(state);
+  ValidateProtocol(state);
+  ValidateOwnershipWait(state);
 
 }
 
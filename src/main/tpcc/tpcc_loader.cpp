@@ -934,8 +934,15 @@ void CreateOrderLineTable() {
 }
 
 void CreateTPCCDatabase() {
-  // Clean up
-  delete tpcc_database;
+  // Give each backend its own active tile group for inserts
+  peloton_active_tile_group_count = state.backend_count;
+
+  auto &manager = catalog::Manager::GetInstance();
+
+  // Clean up the database of a previous run
+  if (tpcc_database != nullptr) {
+    manager.DropDatabaseWithOid(tpcc_database_oid);
+  }
   tpcc_database = nullptr;
   warehouse_table = nullptr;
   district_table = nullptr;
@@ -947,7 +954,6 @@ void CreateTPCCDatabase() {
   new_order_table = nullptr;
   order_line_table = nullptr;
 
-  auto &manager = catalog::Manager::GetInstance();
   tpcc_database = new storage::Database(tpcc_database_oid);
   manager.AddDatabase(tpcc_database);
 
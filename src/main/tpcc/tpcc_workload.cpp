@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <set>
 #include <unordered_map>
 #include <vector>
 #include <chrono>
@@ -38,6 +39,7 @@
 #include "common/timer.h"
 #include "common/generator.h"
 
+#include "concurrency/backoff.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
 
@@ -65,8 +67,6 @@
 #include "planner/insert_plan.h"
 #include "planner/update_plan.h"
 #include "planner/index_scan_plan.h"
-#include "planner/nested_loop_join_plan.h"
-#include "planner/aggregate_plan.h"
 #include "planner/order_by_plan.h"
 #include "planner/limit_plan.h"
 
@@ -101,15 +101,20 @@ volatile bool run_backends = true;
 // Committed transaction counts
 std::vector<double> transaction_counts;
 
+// Aborted transaction counts
+std::vector<double> abort_counts;
+
 std::vector<double> durations;
 
 void RunBackend(oid_t thread_id) {
   auto committed_transaction_count = 0;
+  auto aborted_transaction_count = 0;
   UniformGenerator generator;
 
   auto transaction_count_per_backend = state.transaction_count / state.backend_count;
   bool check_transaction_count = (transaction_count_per_backend != 0);
 
+  concurrency::Backoff backoff;
   Timer<> timer;
 
   // Start timer
@@ -152,9 +157,14 @@ void RunBackend(oid_t thread_id) {
     }
      */
 
-    // Update transaction count if it committed
+    // Update transaction count if it committed, back off before retrying
+    // after an abort
     if (transaction_status == true) {
       committed_transaction_count++;
+      backoff.Reset();
+    } else {
+      aborted_transaction_count++;
+      backoff.Wait();
     }
   }
 
@@ -163,6 +173,7 @@ void RunBackend(oid_t thread_id) {
 
   // Set committed_transaction_count
   transaction_counts[thread_id] = committed_transaction_count;
+  abort_counts[thread_id] = aborted_transaction_count;
 
   // Set duration
   durations[thread_id] = timer.GetDuration();
@@ -173,8 +184,12 @@ void RunWorkload() {
   std::vector<std::thread> thread_group;
   oid_t num_threads = state.backend_count;
   transaction_counts.resize(num_threads);
+  abort_counts.resize(num_threads);
   durations.resize(num_threads);
 
+  // Backends may have been stopped by a previous run
+  run_backends = true;
+
   // Launch a group of threads
   for (oid_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
     thread_group.push_back(std::move(std::thread(RunBackend, thread_itr)));
@@ -196,9 +211,31 @@ void RunWorkload() {
     sum_transaction_count += transaction_count;
   }
 
+  // Compute total aborted transactions
+  auto sum_abort_count = 0;
+  for (auto abort_count : abort_counts) {
+    sum_abort_count += abort_count;
+  }
+
+  if (sum_transaction_count + sum_abort_count > 0) {
+    state.abort_rate =
+        (double)sum_abort_count / (sum_transaction_count + sum_abort_count);
+  } else {
+    state.abort_rate = 0;
+  }
+
   // Compute average throughput and latency
   state.throughput = (sum_transaction_count * 1000) / state.duration;
   state.latency = state.backend_count / state.throughput;
+
+  // Report the contention on each table
+  for (auto table : {warehouse_table, district_table, customer_table,
+                     stock_table, orders_table, new_order_table,
+                     order_line_table}) {
+    LOG_INFO("%s conflicts : %lu ownership waits : %lu",
+             table->GetName().c_str(), table->GetConflictCount(),
+             table->GetOwnershipWaitCount());
+  }
 }
 
 /////////////////////////////////////////////////////////
@@ -2009,9 +2046,7 @@ bool RunStockLevel() {
 
   LOG_INFO("getStockCount: SELECT COUNT(DISTINCT(OL_I_ID)) FROM ORDER_LINE, STOCK  WHERE OL_W_ID = ? AND OL_D_ID = ? AND OL_O_ID < ? AND OL_O_ID >= ? AND S_W_ID = ? AND S_I_ID = OL_I_ID AND S_QUANTITY < ?");
 
-  //////////////////////////////////////////////////////////////////
-  ///////////// Construct left table index scan ////////////////////
-  //////////////////////////////////////////////////////////////////
+  // Construct index scan executor
   std::vector<oid_t> order_line_column_ids = {COL_IDX_OL_I_ID};
   std::vector<oid_t> order_line_key_column_ids = {COL_IDX_OL_W_ID, COL_IDX_OL_D_ID, COL_IDX_OL_O_ID, COL_IDX_OL_O_ID};
   std::vector<ExpressionType> order_line_expr_types;
@@ -2039,103 +2074,63 @@ bool RunStockLevel() {
 
   executor::IndexScanExecutor order_line_index_scan_executor(&order_line_index_scan_node, context.get());
 
-  //////////////////////////////////////////////////////////////////
-  ///////////// Construct right table index scan ///////////////////
-  //////////////////////////////////////////////////////////////////
-  std::vector<oid_t> stock_column_ids = {COL_IDX_S_I_ID};
+  auto order_lines = ExecuteReadTest(&order_line_index_scan_executor);
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    txn_manager.AbortTransaction();
+    return false;
+  }
 
-  std::vector<oid_t> stock_key_column_ids = {COL_IDX_S_W_ID};
-  std::vector<ExpressionType> stock_expr_types;
-  std::vector<Value> stock_key_values;
+  // COUNT(DISTINCT(OL_I_ID)) counts every item once
+  std::set<int> item_ids;
+  for (auto &order_line : order_lines) {
+    item_ids.insert(ValuePeeker::PeekInteger(order_line[0]));
+  }
 
-  stock_expr_types.push_back(
-      ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL);
-  stock_key_values.push_back(ValueFactory::GetIntegerValue(w_id));
+  if (item_ids.size() != 0) {
+    // Look up the stock of all items with one IN-list scan on the stock index
+    std::vector<oid_t> stock_column_ids = {COL_IDX_S_I_ID};
+    std::vector<oid_t> stock_key_column_ids = {0, 1};  // S_I_ID, S_W_ID
+    std::vector<ExpressionType> stock_expr_types;
+    std::vector<Value> stock_key_values;
 
-  auto stock_pkey_index = stock_table->GetIndexWithOid(
-      stock_table_pkey_index_oid);
+    auto stock_pkey_index = stock_table->GetIndexWithOid(
+        stock_table_pkey_index_oid);
 
-  planner::IndexScanPlan::IndexScanDesc stock_index_scan_desc(
-      stock_pkey_index, stock_key_column_ids, stock_expr_types,
-      stock_key_values, runtime_keys);
+    planner::IndexScanPlan::IndexScanDesc stock_index_scan_desc(
+        stock_pkey_index, stock_key_column_ids, stock_expr_types,
+        stock_key_values, runtime_keys);
 
-  // Add predicate S_QUANTITY < threshold
-  auto tuple_val_expr = expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, COL_IDX_S_QUANTITY);
-  auto constant_val_expr = expression::ExpressionUtil::ConstantValueFactory(
-      ValueFactory::GetIntegerValue(threshold));
-  predicate = expression::ExpressionUtil::ComparisonFactory(
-      EXPRESSION_TYPE_COMPARE_EQUAL, tuple_val_expr, constant_val_expr);
+    for (auto item_id : item_ids) {
+      stock_index_scan_desc.key_values_list.push_back(
+          {ValueFactory::GetIntegerValue(item_id),
+           ValueFactory::GetIntegerValue(w_id)});
+    }
 
-  planner::IndexScanPlan stock_index_scan_node(stock_table, predicate,
-                                               stock_column_ids,
-                                               stock_index_scan_desc);
+    // Add predicate S_QUANTITY < threshold
+    auto tuple_val_expr = expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, COL_IDX_S_QUANTITY);
+    auto constant_val_expr = expression::ExpressionUtil::ConstantValueFactory(
+        ValueFactory::GetIntegerValue(threshold));
+    std::unique_ptr<expression::AbstractExpression> stock_predicate(
+        expression::ExpressionUtil::ComparisonFactory(
+            EXPRESSION_TYPE_COMPARE_LESSTHAN, tuple_val_expr,
+            constant_val_expr));
 
-  executor::IndexScanExecutor stock_index_scan_executor(&stock_index_scan_node,
-                                                        context.get());
+    planner::IndexScanPlan stock_index_scan_node(stock_table,
+                                                 stock_predicate.get(),
+                                                 stock_column_ids,
+                                                 stock_index_scan_desc);
 
-  ////////////////////////////////////////////////
-  ////////////// Join ////////////////////////////
-  ////////////////////////////////////////////////
-  // Schema
-  auto order_line_table_schema = order_line_table->GetSchema();
-  std::shared_ptr<const catalog::Schema> join_schema(new catalog::Schema({
-    order_line_table_schema->GetColumn(COL_IDX_OL_I_ID)
-  }));
-  // Projection
-  TargetList target_list;
-  DirectMapList direct_map_list = {{0, {0, 0}}}; // ORDER_LINE.OL_I_ID
-  std::unique_ptr<const planner::ProjectInfo> projection(
-      new planner::ProjectInfo(std::move(target_list),
-                               std::move(direct_map_list)));
-  // Predicate left.0 == right.0
-  auto left_table_attr0 = expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0);
-  auto right_table_attr0 = expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 1, 0);
-  std::unique_ptr<const expression::AbstractExpression> join_predicate( expression::ExpressionUtil::ComparisonFactory(
-      EXPRESSION_TYPE_COMPARE_EQUAL, left_table_attr0, right_table_attr0));
-
-  // Join
-  planner::NestedLoopJoinPlan join_plan(JOIN_TYPE_INNER, std::move(join_predicate), std::move(projection), join_schema);
-  executor::NestedLoopJoinExecutor join_executor(&join_plan, context.get());
-  join_executor.AddChild(&order_line_index_scan_executor);
-
-  ////////////////////////////////////////////////
-  ////////////// Aggregator //////////////////////
-  ////////////////////////////////////////////////
-  std::vector<oid_t> group_by_columns;
-  DirectMapList aggregate_direct_map_list = {{0, {1, 0}}};
-  TargetList aggregate_target_list;
-
-  std::unique_ptr<const planner::ProjectInfo> aggregate_projection(
-      new planner::ProjectInfo(std::move(aggregate_target_list),
-                               std::move(aggregate_direct_map_list)));
-
-  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
-  bool distinct = true;
-  planner::AggregatePlan::AggTerm count_distinct(
-      EXPRESSION_TYPE_AGGREGATE_COUNT,
-      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
-      distinct);
-  agg_terms.push_back(count_distinct);
-
-  // The schema is the same as the join operator
-  std::shared_ptr<const catalog::Schema> aggregate_schema(new catalog::Schema({
-    order_line_table_schema->GetColumn(COL_IDX_OL_I_ID)
-  }));
-
-  planner::AggregatePlan count_distinct_node(
-      std::move(aggregate_projection), nullptr, std::move(agg_terms),
-      std::move(group_by_columns), aggregate_schema,
-      AGGREGATE_TYPE_PLAIN);
-
-  executor::AggregateExecutor count_distinct_executor(&count_distinct_node, context.get());
-  count_distinct_executor.AddChild(&join_executor);
-
-  auto count_result = ExecuteReadTest(&count_distinct_executor);
-  if (txn->GetResult() != Result::RESULT_SUCCESS) {
-    txn_manager.AbortTransaction();
-    return false;
+    executor::IndexScanExecutor stock_index_scan_executor(&stock_index_scan_node,
+                                                          context.get());
+
+    auto stocks = ExecuteReadTest(&stock_index_scan_executor);
+    if (txn->GetResult() != Result::RESULT_SUCCESS) {
+      txn_manager.AbortTransaction();
+      return false;
+    }
+
+    LOG_TRACE("Stock count: %lu", stocks.size());
   }
-  assert(count_result.size() == 1);
 
   assert(txn->GetResult() == Result::RESULT_SUCCESS);
 
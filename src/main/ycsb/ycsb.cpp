@@ -17,6 +17,10 @@
 #include "benchmark/ycsb/ycsb_configuration.h"
 #include "benchmark/ycsb/ycsb_loader.h"
 #include "benchmark/ycsb/ycsb_workload.h"
+#include "concurrency/transaction_manager_factory.h"
+
+// Longest time (in us) a writer waits for the owner of a version
+extern int peloton_ownership_wait_us;
 
 namespace peloton {
 namespace benchmark {
@@ -26,25 +30,40 @@ configuration state;
 
 std::ofstream out("outputfile.summary");
 
+// Wait for owners (in us) of the protocol that runs
+static int protocol_ownership_wait_us = 0;
+
 static void WriteOutput(double stat) {
   LOG_INFO("----------------------------------------------------------");
-  LOG_INFO("%lf %d %d %d :: %lf",
+  LOG_INFO("%s %d %lf %d %d %d :: %lf %lf",
+           ConcurrencyTypeToString(state.protocol).c_str(),
+           protocol_ownership_wait_us,
            state.update_ratio,
            state.scale_factor,
            state.backend_count,
            state.column_count,
-           stat);
+           stat,
+           state.abort_rate);
 
+  out << ConcurrencyTypeToString(state.protocol) << " ";
+  out << protocol_ownership_wait_us << " ";
   out << state.update_ratio << " ";
   out << state.scale_factor << " ";
   out << state.backend_count << " ";
   out << state.column_count << " ";
-  out << stat << "\n";
+  out << stat << " ";
+  out << state.abort_rate << "\n";
   out.flush();
 }
 
-// Main Entry Point
-void RunBenchmark() {
+static void RunProtocol(ConcurrencyType protocol) {
+  state.protocol = protocol;
+  concurrency::TransactionManagerFactory::Configure(protocol);
+
+  // The wait for owners this protocol runs with
+  protocol_ownership_wait_us =
+      concurrency::TransactionManagerFactory::GetInstance().GetOwnershipWait();
+
   // Create and load the user table
   CreateYCSBDatabase();
 
@@ -53,10 +72,24 @@ void RunBenchmark() {
   // Run the workload
   RunWorkload();
 
-  // Emit throughput
+  // Emit throughput and abort rate
   WriteOutput(state.throughput);
 }
 
+// Main Entry Point
+void RunBenchmark() {
+  peloton_ownership_wait_us = state.ownership_wait_us;
+
+  if (state.compare_protocols == false) {
+    RunProtocol(state.protocol);
+    return;
+  }
+
+  // Run the same workload with each protocol
+  RunProtocol(CONCURRENCY_TYPE_TO);
+  RunProtocol(CONCURRENCY_TYPE_OPTIMISTIC);
+}
+
 }  // namespace ycsb
 }  // namespace benchmark
 }  // namespace peloton
@@ -32,6 +32,9 @@ void Usage(FILE *out) {
           "   -u --update-ratio      :  Fraction of updates \n"
           "   -t --transaction-count :  # of transactions \n"
           "   -i --index             :  index type \n"
+          "   -p --protocol          :  concurrency control protocol \n"
+          "   -m --compare           :  run with each protocol \n"
+          "   -w --wait              :  max wait for owners (in us), -1 for the protocol default \n"
           );
 }
 
@@ -43,6 +46,9 @@ static struct option opts[] = {
     { "update-ratio", optional_argument, NULL, 'u'},
     { "transaction-count", optional_argument, NULL, 't'},
     { "index", optional_argument, NULL, 'i'},
+    { "protocol", optional_argument, NULL, 'p'},
+    { "compare", no_argument, NULL, 'm'},
+    { "wait", optional_argument, NULL, 'w'},
     { NULL, 0, NULL, 0}};
 
 void ValidateScaleFactor(const configuration &state) {
@@ -110,6 +116,28 @@ void ValidateIndexType(const configuration &state) {
   LOG_INFO("%s : %s", "index type", IndexTypeToString(state.index_type).c_str());
 }
 
+void ValidateProtocol(const configuration &state) {
+  if (state.protocol != CONCURRENCY_TYPE_TO &&
+      state.protocol != CONCURRENCY_TYPE_OPTIMISTIC) {
+    LOG_ERROR("Invalid protocol : %s",
+              ConcurrencyTypeToString(state.protocol).c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %s", "protocol",
+           ConcurrencyTypeToString(state.protocol).c_str());
+  LOG_INFO("%s : %d", "compare_protocols", state.compare_protocols);
+}
+
+void ValidateOwnershipWait(const configuration &state) {
+  if (state.ownership_wait_us < -1) {
+    LOG_ERROR("Invalid ownership_wait_us :: %d", state.ownership_wait_us);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %d", "ownership_wait_us", state.ownership_wait_us);
+}
+
 void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.scale_factor = 1;
@@ -120,11 +148,14 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.transaction_count = 0;
   state.ints_mode = true;
   state.index_type = INDEX_TYPE_HASH;
+  state.protocol = CONCURRENCY_TYPE_TO;
+  state.compare_protocols = false;
+  state.ownership_wait_us = -1;
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hb:c:d:k:t:u:i:", opts, &idx);
+    int c = getopt_long(argc, argv, "hb:c:d:k:t:u:i:p:mw:", opts, &idx);
 
     if (c == -1) break;
 
@@ -150,6 +181,15 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'i':
         state.index_type = (peloton::IndexType) atoi(optarg);
         break;
+      case 'p':
+        state.protocol = (peloton::ConcurrencyType) atoi(optarg);
+        break;
+      case 'm':
+        state.compare_protocols = true;
+        break;
+      case 'w':
+        state.ownership_wait_us = atoi(optarg);
+        break;
 
       case 'h':
         Usage(stderr);
@@ -172,6 +212,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateDuration(state);
   ValidateTransactionCount(state);
   ValidateIndexType(state);
+  ValidateProtocol(state);
+  ValidateOwnershipWait(state);
 
 }
 
@@ -56,12 +56,18 @@ void CreateYCSBDatabase() {
   // Create tables
   /////////////////////////////////////////////////////////
 
-  // Clean up
-  delete ycsb_database;
+  // Give each backend its own active tile group for inserts
+  peloton_active_tile_group_count = state.backend_count;
+
+  auto &manager = catalog::Manager::GetInstance();
+
+  // Clean up the database of a previous run
+  if (ycsb_database != nullptr) {
+    manager.DropDatabaseWithOid(ycsb_database_oid);
+  }
   ycsb_database = nullptr;
   user_table = nullptr;
 
-  auto &manager = catalog::Manager::GetInstance();
   ycsb_database = new storage::Database(ycsb_database_oid);
   manager.AddDatabase(ycsb_database);
 
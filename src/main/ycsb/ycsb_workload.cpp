@@ -39,6 +39,7 @@
 #include "common/generator.h"
 #include "common/platform.h"
 
+#include "concurrency/backoff.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
 
@@ -190,6 +191,9 @@ volatile bool run_backends = true;
 // Committed transaction counts
 std::vector<double> transaction_counts;
 
+// Aborted transaction counts
+std::vector<double> abort_counts;
+
 std::vector<double> durations;
 
 void RunBackend(oid_t thread_id) {
@@ -202,6 +206,7 @@ void RunBackend(oid_t thread_id) {
   ZipfDistribution zipf((state.scale_factor * DEFAULT_TUPLES_PER_TILEGROUP) - 1,
                         zipf_theta);
   auto committed_transaction_count = 0;
+  auto aborted_transaction_count = 0;
 
   // Partition the domain across backends
   auto insert_key_offset = state.scale_factor * DEFAULT_TUPLES_PER_TILEGROUP;
@@ -209,6 +214,7 @@ void RunBackend(oid_t thread_id) {
   auto transaction_count_per_backend = state.transaction_count / state.backend_count;
   bool check_transaction_count = (transaction_count_per_backend != 0);
 
+  concurrency::Backoff backoff;
   Timer<> timer;
 
   // Start timer
@@ -242,9 +248,14 @@ void RunBackend(oid_t thread_id) {
       transaction_status = RunRead(zipf);
     }
 
-    // Update transaction count if it committed
+    // Update transaction count if it committed, back off before retrying
+    // after an abort
     if (transaction_status == true) {
       committed_transaction_count++;
+      backoff.Reset();
+    } else {
+      aborted_transaction_count++;
+      backoff.Wait();
     }
   }
 
@@ -253,6 +264,7 @@ void RunBackend(oid_t thread_id) {
 
   // Set committed_transaction_count
   transaction_counts[thread_id] = committed_transaction_count;
+  abort_counts[thread_id] = aborted_transaction_count;
 
   // Set duration
   durations[thread_id] = timer.GetDuration();
@@ -263,9 +275,13 @@ void RunWorkload() {
   std::vector<std::thread> thread_group;
   oid_t num_threads = state.backend_count;
   transaction_counts.resize(num_threads);
+  abort_counts.resize(num_threads);
   durations.resize(num_threads);
   bool check_transaction_count = (state.transaction_count != 0);
 
+  // Backends may have been stopped by a previous run
+  run_backends = true;
+
   // Launch a group of threads
   for (oid_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
     thread_group.push_back(std::move(std::thread(RunBackend, thread_itr)));
@@ -291,9 +307,26 @@ void RunWorkload() {
     sum_transaction_count += transaction_count;
   }
 
+  // Compute total aborted transactions
+  auto sum_abort_count = 0;
+  for (auto abort_count : abort_counts) {
+    sum_abort_count += abort_count;
+  }
+
+  if (sum_transaction_count + sum_abort_count > 0) {
+    state.abort_rate =
+        (double)sum_abort_count / (sum_transaction_count + sum_abort_count);
+  } else {
+    state.abort_rate = 0;
+  }
+
   // Compute average throughput and latency
   state.throughput = (sum_transaction_count * 1000) / state.duration;
   state.latency = state.backend_count / state.throughput;
+
+  // Report the contention on the user table
+  LOG_INFO("user table conflicts : %lu ownership waits : %lu",
+           user_table->GetConflictCount(), user_table->GetOwnershipWaitCount());
 }
 
 /////////////////////////////////////////////////////////
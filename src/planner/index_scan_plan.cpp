@@ -28,7 +28,8 @@ IndexScanPlan::IndexScanPlan(storage::DataTable *table,
   key_column_ids_(std::move(index_scan_desc.key_column_ids)),
   expr_types_(std::move(index_scan_desc.expr_types)),
   values_(std::move(index_scan_desc.values)),
-  runtime_keys_(std::move(index_scan_desc.runtime_keys)) {
+  runtime_keys_(std::move(index_scan_desc.runtime_keys)),
+  key_values_list_(index_scan_desc.key_values_list) {
 
   LOG_TRACE("Creating an Index Scan Plan");
 
@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <utility>
 
@@ -20,6 +22,7 @@
 #include "common/logger.h"
 #include "common/platform.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "expression/container_tuple.h"
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
 #include "logging/log_manager.h"
@@ -59,8 +62,15 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
   for (oid_t col_itr = 0; col_itr < col_count; col_itr++) {
     default_partition_[col_itr] = std::make_pair(0, col_itr);
   }
-  // Create a tile group.
-  AddDefaultTileGroup();
+
+  // Clamp the number of active tile groups
+  active_tile_group_count_ = std::max(peloton_active_tile_group_count, 1);
+  if (active_tile_group_count_ > ACTIVE_TILE_GROUP_COUNT) {
+    active_tile_group_count_ = ACTIVE_TILE_GROUP_COUNT;
+  }
+
+  // Create the active tile groups.
+  AddActiveTileGroups();
 }
 
 DataTable::~DataTable() {
@@ -109,12 +119,24 @@ bool DataTable::CheckConstraints(const storage::Tuple *tuple) const {
   return true;
 }
 
+// Map the calling thread to one of the active tile groups.
+// Threads are numbered round-robin on first use, so that concurrent
+// inserters spread over distinct tile groups.
+static size_t GetActiveTileGroupSlot() {
+  static std::atomic<size_t> next_thread_slot(0);
+  thread_local size_t thread_slot =
+      next_thread_slot.fetch_add(1, std::memory_order_relaxed);
+  return thread_slot;
+}
+
 // this function is called when update/delete/insert is performed.
-// this function first checks whether there's available slot.
+// this function first checks whether there's available slot in the active
+// tile group the current thread is mapped to.
 // if yes, then directly return the available slot.
-// in particular, if this is the last slot, a new tile group is created.
-// if there's no available slot, then some other threads must be allocating a
-// new tile group.
+// in particular, if this is the last slot, a new tile group is created
+// and it replaces the full one in the active set.
+// if there's no available slot, then some other thread must be allocating a
+// new tile group for the same active slot.
 // we just wait until a new tuple slot in the newly allocated tile group is
 // available.
 ItemPointer DataTable::GetEmptyTupleSlot(
@@ -130,29 +152,41 @@ ItemPointer DataTable::GetEmptyTupleSlot(
   oid_t tuple_slot = INVALID_OID;
   oid_t tile_group_id = INVALID_OID;
 
+  size_t active_tile_group_id =
+      GetActiveTileGroupSlot() % active_tile_group_count_;
+
   // get valid tuple.
   while (true) {
-    // get the last tile group.
-    auto tile_group_count = GetTileGroupCount();
-    tile_group = GetTileGroup(tile_group_count - 1);
+    // get the active tile group.
+    tile_group = std::atomic_load(&active_tile_groups_[active_tile_group_id]);
 
-    tuple_slot = tile_group->InsertTuple(tuple);
+    if (tile_group != nullptr) {
+      tuple_slot = tile_group->InsertTuple(tuple);
 
-    // now we have already obtained a new tuple slot.
-    if (tuple_slot != INVALID_OID) {
-      tile_group_id = tile_group->GetTileGroupId();
-      break;
+      // now we have already obtained a new tuple slot.
+      if (tuple_slot != INVALID_OID) {
+        tile_group_id = tile_group->GetTileGroupId();
+        break;
+      }
     }
+
+    // the tile group is full or missing and no tile group could replace it
+    if (GetTileGroupCount() >= APPEND_ONLY_ARRAY_MAX_SIZE) {
+      LOG_ERROR("Table %u has no room for more tile groups", table_oid);
+      return INVALID_ITEMPOINTER;
+    }
+
+    _mm_pause();
   }
 
   // if this is the last tuple slot we can get
   // then create a new tile group
   if (tuple_slot == tile_group->GetAllocatedTupleCount() - 1) {
-    AddDefaultTileGroup();
+    AddDefaultTileGroup(active_tile_group_id);
   }
 
-  LOG_TRACE("tile group count: %lu, tile group id: %u, address: %p",
-            tile_group_count_.load(), tile_group->GetTileGroupId(),
+  LOG_TRACE("active tile group: %lu, tile group id: %u, address: %p",
+            active_tile_group_id, tile_group->GetTileGroupId(),
             tile_group.get());
 
   // Set tuple location
@@ -244,17 +278,7 @@ bool DataTable::DeleteInIndex(oid_t index_offset, const AbstractTuple *tuple,
     return true;
   }
 
-  auto index_schema = index->GetKeySchema();
-  auto indexed_columns = index_schema->GetIndexedColumns();
-  std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-
-  oid_t this_col_itr = 0;
-  for (auto col : indexed_columns) {
-    key->SetValue(this_col_itr, tuple->GetValue(col), index->GetPool());
-    this_col_itr++;
-  }
-
-  index->DeleteEntry(key.get(), location);
+  index->DeleteTupleEntry(tuple, location);
 
   return true;
 }
@@ -290,23 +314,18 @@ bool DataTable::InsertInIndex(oid_t index_offset, const storage::Tuple *tuple,
     return true;
   }
 
-  auto index_schema = index->GetKeySchema();
-  auto indexed_columns = index_schema->GetIndexedColumns();
-  std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-  key->SetFromTuple(tuple, indexed_columns, index->GetPool());
-
   switch (index->GetIndexType()) {
     case INDEX_CONSTRAINT_TYPE_PRIMARY_KEY:
     case INDEX_CONSTRAINT_TYPE_UNIQUE: {
       // TODO: get unique tuple from primary index.
       // if in this index there has been a visible or uncommitted
       // <key, location> pair, this constraint is violated
-      index->InsertEntry(key.get(), location);
+      index->InsertTupleEntry(tuple, location);
     } break;
 
     case INDEX_CONSTRAINT_TYPE_DEFAULT:
     default:
-      index->InsertEntry(key.get(), location);
+      index->InsertTupleEntry(tuple, location);
       break;
   }
   LOG_TRACE("Index constraint check on %s passed.", index->GetName().c_str());
@@ -349,23 +368,18 @@ bool DataTable::InsertInSecondaryIndexes(const storage::Tuple *tuple,
       continue;
     }
 
-    auto index_schema = index->GetKeySchema();
-    auto indexed_columns = index_schema->GetIndexedColumns();
-    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-    key->SetFromTuple(tuple, indexed_columns, index->GetPool());
-
     switch (index->GetIndexType()) {
       case INDEX_CONSTRAINT_TYPE_PRIMARY_KEY:
         break;
       case INDEX_CONSTRAINT_TYPE_UNIQUE: {
         // if in this index there has been a visible or uncommitted
         // <key, location> pair, this constraint is violated
-        index->InsertEntry(key.get(), location);
+        index->InsertTupleEntry(tuple, location);
       } break;
 
       case INDEX_CONSTRAINT_TYPE_DEFAULT:
       default:
-        index->InsertEntry(key.get(), location);
+        index->InsertTupleEntry(tuple, location);
         break;
     }
   }
@@ -477,6 +491,14 @@ bool DataTable::IsDirty() const { return dirty_; }
  */
 void DataTable::ResetDirty() { dirty_ = false; }
 
+/**
+ * @brief Reset the write conflict and ownership wait counts
+ */
+void DataTable::ResetContentionStats() {
+  conflict_count_ = 0;
+  ownership_wait_count_ = 0;
+}
+
 //===--------------------------------------------------------------------===//
 // TILE GROUP
 //===--------------------------------------------------------------------===//
@@ -541,10 +563,12 @@ column_map_type DataTable::GetTileGroupLayout(LayoutType layout_type) {
   return column_map;
 }
 
-oid_t DataTable::AddDefaultTileGroup() {
+oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
   column_map_type column_map;
   oid_t tile_group_id = INVALID_OID;
 
+  PL_ASSERT(active_tile_group_id < active_tile_group_count_);
+
   // Figure out the partitioning for given tilegroup layout
   column_map = GetTileGroupLayout((LayoutType)peloton_layout_mode);
 
@@ -560,10 +584,16 @@ oid_t DataTable::AddDefaultTileGroup() {
     // add tile group metadata in locator
     catalog::Manager::GetInstance().AddTileGroup(tile_group_id, tile_group);
 
-    // add tile group to set of all tile groups
-    tile_group_lock_.WriteLock();
-    tile_groups_.push_back(tile_group_id);
-    tile_group_lock_.Unlock();
+    // add tile group to set of all tile groups, or leave the full tile
+    // group in place if there is no room for another one. Inserts into
+    // this slot fail from then on
+    if (tile_groups_.Append(tile_group_id) == false) {
+      catalog::Manager::GetInstance().DropTileGroup(tile_group_id);
+      return INVALID_OID;
+    }
+
+    // publish the tile group to the inserting threads
+    std::atomic_store(&active_tile_groups_[active_tile_group_id], tile_group);
 
     LOG_TRACE("Recording tile group : %u ", tile_group_id);
   }
@@ -571,6 +601,17 @@ oid_t DataTable::AddDefaultTileGroup() {
   return tile_group_id;
 }
 
+void DataTable::AddActiveTileGroups() {
+  for (size_t active_tile_group_id = 0;
+       active_tile_group_id < active_tile_group_count_;
+       active_tile_group_id++) {
+    if (std::atomic_load(&active_tile_groups_[active_tile_group_id]) ==
+        nullptr) {
+      AddDefaultTileGroup(active_tile_group_id);
+    }
+  }
+}
+
 void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
   PL_ASSERT(tile_group_id);
 
@@ -588,23 +629,19 @@ void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
       database_oid, table_oid, tile_group_id, this, schemas, column_map,
       tuples_per_tilegroup_));
 
-  tile_group_lock_.ReadLock();
-  bool tile_groups_exists = false;
-  auto location =
-      std::find(tile_groups_.begin(), tile_groups_.end(), tile_group_id);
-  if (location != tile_groups_.end()) {
-    tile_groups_exists = true;
-  }
-  tile_group_lock_.Unlock();
+  bool tile_groups_exists = tile_groups_.Contains(tile_group_id);
 
   if (tile_groups_exists == false) {
     // add tile group metadata in locator
     catalog::Manager::GetInstance().AddTileGroup(tile_group_id, tile_group);
 
     // add tile group to set of all tile groups
-    tile_group_lock_.WriteLock();
-    tile_groups_.push_back(tile_group_id);
-    tile_group_lock_.Unlock();
+    if (tile_groups_.Append(tile_group_id) == false) {
+      catalog::Manager::GetInstance().DropTileGroup(tile_group_id);
+      throw Exception("Table " + std::to_string(table_oid) +
+                      " has no room for tile group " +
+                      std::to_string(tile_group_id));
+    }
 
     LOG_TRACE("Added a tile group ");
 
@@ -615,33 +652,26 @@ void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
 void DataTable::AddTileGroup(const std::shared_ptr<TileGroup> &tile_group) {
   oid_t tile_group_id = tile_group->GetTileGroupId();
 
-  tile_group_lock_.WriteLock();
-  tile_groups_.push_back(tile_group_id);
-  tile_group_lock_.Unlock();
-
-  // add tile group in catalog
+  // add tile group in catalog before publishing it to scans
   catalog::Manager::GetInstance().AddTileGroup(tile_group_id, tile_group);
 
+  if (tile_groups_.Append(tile_group_id) == false) {
+    catalog::Manager::GetInstance().DropTileGroup(tile_group_id);
+    throw Exception("Table " + std::to_string(table_oid) +
+                    " has no room for tile group " +
+                    std::to_string(tile_group_id));
+  }
+
   LOG_TRACE("Recording tile group : %u ", tile_group_id);
 }
 
-size_t DataTable::GetTileGroupCount() const {
-  size_t tile_group_count_ = 0;
-
-  tile_group_lock_.ReadLock();
-  tile_group_count_ = tile_groups_.size();
-  tile_group_lock_.Unlock();
-
-  return tile_group_count_;
-}
+size_t DataTable::GetTileGroupCount() const { return tile_groups_.GetSize(); }
 
 std::shared_ptr<storage::TileGroup> DataTable::GetTileGroup(
     const std::size_t &tile_group_offset) const {
   PL_ASSERT(tile_group_offset < GetTileGroupCount());
 
-  tile_group_lock_.ReadLock();
-  auto tile_group_id = tile_groups_.at(tile_group_offset);
-  tile_group_lock_.Unlock();
+  auto tile_group_id = tile_groups_.Find(tile_group_offset);
 
   return GetTileGroupById(tile_group_id);
 }
@@ -651,8 +681,9 @@ std::shared_ptr<storage::TileGroup> DataTable::GetTileGroupById(
   auto &manager = catalog::Manager::GetInstance();
   auto tile_group = manager.GetTileGroup(tile_group_id);
 
+  // The tile group may have been dropped by compaction
   if (tile_group == nullptr) {
-    LOG_INFO("GetTileGroupById: %u", tile_group_id);
+    LOG_TRACE("GetTileGroupById: %u", tile_group_id);
   }
 
   return tile_group;
@@ -663,20 +694,24 @@ void DataTable::DropTileGroups() {
   auto tile_group_count = GetTileGroupCount();
   std::size_t tile_groups_itr;
 
-  tile_group_lock_.ReadLock();
   for (tile_groups_itr = 0; tile_groups_itr < tile_group_count;
        tile_groups_itr++) {
-    auto tile_group_id = tile_groups_[tile_groups_itr];
+    auto tile_group_id = tile_groups_.Find(tile_groups_itr);
 
     // drop tile group in catalog
     catalog_manager.DropTileGroup(tile_group_id);
   }
-  tile_group_lock_.Unlock();
 
   // Clear tile groups
-  tile_group_lock_.WriteLock();
-  tile_groups_.clear();
-  tile_group_lock_.Unlock();
+  tile_groups_.Clear();
+
+  // Clear active tile groups
+  for (size_t active_tile_group_id = 0;
+       active_tile_group_id < active_tile_group_count_;
+       active_tile_group_id++) {
+    std::atomic_store(&active_tile_groups_[active_tile_group_id],
+                      std::shared_ptr<storage::TileGroup>());
+  }
 }
 
 const std::string DataTable::GetInfo() const {
@@ -693,6 +728,8 @@ const std::string DataTable::GetInfo() const {
   for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
        tile_group_itr++) {
     auto tile_group = GetTileGroup(tile_group_itr);
+    if (tile_group == nullptr) continue;
+
     table_id = tile_group->GetTableId();
     auto tile_tuple_count = tile_group->GetNextTupleSlot();
 
@@ -912,9 +949,20 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
     new_tile_group->LocateTileAndColumn(column_itr, new_tile_offset,
                                         new_tile_column_offset);
 
-    auto orig_tile = orig_tile_group->GetTile(orig_tile_offset);
     auto new_tile = new_tile_group->GetTile(new_tile_offset);
 
+    // A frozen tile group has no tiles, so its values are decoded
+    if (orig_tile_group->IsFrozen()) {
+      auto frozen_tuple_count = orig_tile_group->GetNextTupleSlot();
+      for (oid_t tuple_itr = 0; tuple_itr < frozen_tuple_count; tuple_itr++) {
+        auto val = orig_tile_group->GetValue(tuple_itr, column_itr);
+        new_tile->SetValue(val, tuple_itr, new_tile_column_offset);
+      }
+      continue;
+    }
+
+    auto orig_tile = orig_tile_group->GetTile(orig_tile_offset);
+
     // Copy the column over to the new tile group
     for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
       auto val = orig_tile->GetValue(tuple_itr, orig_tile_column_offset);
@@ -937,13 +985,15 @@ storage::TileGroup *DataTable::TransformTileGroup(
     return nullptr;
   }
 
-  tile_group_lock_.ReadLock();
-  auto tile_group_id = tile_groups_[tile_group_offset];
-  tile_group_lock_.Unlock();
+  auto tile_group_id = tile_groups_.Find(tile_group_offset);
 
   // Get orig tile group from catalog
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto tile_group = catalog_manager.GetTileGroup(tile_group_id);
+  if (tile_group == nullptr) {
+    return nullptr;
+  }
+
   auto diff = tile_group->GetSchemaDifference(default_partition_);
 
   // Check threshold for transformation
@@ -975,6 +1025,385 @@ storage::TileGroup *DataTable::TransformTileGroup(
   return new_tile_group.get();
 }
 
+// Owner of the versions of a tile group while it is frozen
+static const txn_id_t FREEZER_TXN_ID = MAX_TXN_ID;
+
+// No version of the tile group was created or ended by a transaction that
+// might still be running
+static bool HasOnlyDeadCommits(storage::TileGroupHeader *header,
+                               const cid_t &max_dead_cid) {
+  auto tuple_count = header->GetCurrentNextTupleSlot();
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    auto begin_cid = header->GetBeginCommitId(tuple_id);
+    auto end_cid = header->GetEndCommitId(tuple_id);
+    if (begin_cid != MAX_CID && begin_cid > max_dead_cid) return false;
+    if (end_cid != MAX_CID && end_cid > max_dead_cid) return false;
+  }
+
+  return true;
+}
+
+// A tile group is cold once it is full, every transaction that began before
+// it was full is gone, and no transaction that might still be running has
+// created or owns any of its versions
+static bool IsColdTileGroup(storage::TileGroup *tile_group,
+                            const cid_t &max_dead_cid) {
+  auto header = tile_group->GetHeader();
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+  if (header->GetCurrentNextTupleSlot() < tuple_count) return false;
+
+  // Writers that took a slot before the group was full may not have set
+  // its transaction id yet
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  if (header->SetFullCommitId(txn_manager.GetCurrentCommitId()) >
+      max_dead_cid) {
+    return false;
+  }
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    auto txn_id = header->GetTransactionId(tuple_id);
+    if (txn_id != INITIAL_TXN_ID && txn_id != INVALID_TXN_ID) return false;
+  }
+
+  return HasOnlyDeadCommits(header, max_dead_cid);
+}
+
+// Own the committed versions of the tile group so that no writer changes
+// them while it is frozen. Returns false if a version is owned already.
+static bool OwnTileGroup(storage::TileGroupHeader *header,
+                         std::vector<oid_t> &owned_tuple_ids) {
+  header->IncreaseOwnerCount();
+
+  auto tuple_count = header->GetCurrentNextTupleSlot();
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    if (header->SetAtomicTransactionId(tuple_id, FREEZER_TXN_ID) == true) {
+      owned_tuple_ids.push_back(tuple_id);
+    } else if (header->GetTransactionId(tuple_id) != INVALID_TXN_ID) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void ReleaseTileGroup(storage::TileGroupHeader *header,
+                             const std::vector<oid_t> &owned_tuple_ids) {
+  for (auto tuple_id : owned_tuple_ids) {
+    header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+  }
+  header->DecreaseOwnerCount();
+}
+
+storage::TileGroup *DataTable::FreezeTileGroup(const oid_t &tile_group_offset,
+                                               const cid_t &max_dead_cid) {
+  // First, check if the tile group is in this table
+  auto tile_groups_size = GetTileGroupCount();
+  if (tile_group_offset >= tile_groups_size) {
+    LOG_ERROR("Tile group offset not found in table : %u ", tile_group_offset);
+    return nullptr;
+  }
+
+  auto tile_group_id = tile_groups_.Find(tile_group_offset);
+
+  // Get orig tile group from catalog
+  auto &catalog_manager = catalog::Manager::GetInstance();
+  auto tile_group = catalog_manager.GetTileGroup(tile_group_id);
+
+  if (tile_group == nullptr || tile_group->IsFrozen() ||
+      IsColdTileGroup(tile_group.get(), max_dead_cid) == false) {
+    return nullptr;
+  }
+
+  // A writer may have changed a version before it was owned
+  auto header = tile_group->GetHeader();
+  std::vector<oid_t> owned_tuple_ids;
+  if (OwnTileGroup(header, owned_tuple_ids) == false ||
+      HasOnlyDeadCommits(header, max_dead_cid) == false) {
+    ReleaseTileGroup(header, owned_tuple_ids);
+    return nullptr;
+  }
+
+  LOG_TRACE("Freezing tile group : %u", tile_group_offset);
+
+  std::shared_ptr<storage::TileGroup> new_tile_group(
+      TileGroupFactory::GetFrozenTileGroup(tile_group.get()));
+  ReleaseTileGroup(new_tile_group->GetHeader(), owned_tuple_ids);
+
+  // Set the location of the new tile group and clean up the orig tile group.
+  // Its versions stay owned, so a writer that still reaches it fails to own
+  // them instead of changing a stale copy.
+  catalog_manager.AddTileGroup(tile_group_id, new_tile_group);
+
+  return new_tile_group.get();
+}
+
+// A version is live if it is committed and not yet deleted or updated
+static bool IsLiveVersion(storage::TileGroupHeader *header,
+                          const oid_t &tuple_id) {
+  return header->GetTransactionId(tuple_id) == INITIAL_TXN_ID &&
+         header->GetBeginCommitId(tuple_id) != MAX_CID &&
+         header->GetEndCommitId(tuple_id) == MAX_CID;
+}
+
+// Skip the versions of a chain that are stored in the given tile group
+static ItemPointer GetVersionOutside(storage::TileGroup *tile_group,
+                                     ItemPointer location) {
+  auto header = tile_group->GetHeader();
+  while (location.block == tile_group->GetTileGroupId()) {
+    location = header->GetNextItemPointer(location.offset);
+  }
+  return location;
+}
+
+bool DataTable::CompactTileGroup(const oid_t &tile_group_offset,
+                                 const double &threshold,
+                                 const cid_t &max_dead_cid) {
+  // First, check if the tile group is in this table
+  auto tile_groups_size = GetTileGroupCount();
+  if (tile_group_offset >= tile_groups_size) {
+    LOG_ERROR("Tile group offset not found in table : %u ", tile_group_offset);
+    return false;
+  }
+
+  auto tile_group_id = tile_groups_.Find(tile_group_offset);
+
+  auto &catalog_manager = catalog::Manager::GetInstance();
+  auto tile_group = catalog_manager.GetTileGroup(tile_group_id);
+
+  // Already dropped
+  if (tile_group == nullptr) {
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(compaction_mutex_);
+    auto unlinked_itr = unlinked_tile_groups_.find(tile_group_id);
+    if (unlinked_itr != unlinked_tile_groups_.end()) {
+      // Transactions that started before the tile group was unlinked
+      // may still follow a stale pointer into it
+      if (unlinked_itr->second > max_dead_cid) {
+        return false;
+      }
+
+      LOG_TRACE("Dropping compacted tile group : %u", tile_group_offset);
+      unlinked_tile_groups_.erase(unlinked_itr);
+      catalog_manager.DropTileGroup(tile_group_id);
+      return true;
+    }
+  }
+
+  if (IsColdTileGroup(tile_group.get(), max_dead_cid) == false) {
+    return false;
+  }
+
+  auto header = tile_group->GetHeader();
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+  oid_t live_tuple_count = 0;
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    if (IsLiveVersion(header, tuple_id)) live_tuple_count++;
+  }
+
+  // Move the live versions out. Their old versions become dead once
+  // the transactions that can still see them have finished.
+  if (live_tuple_count > 0) {
+    if (live_tuple_count > threshold * tuple_count) {
+      return false;
+    }
+
+    LOG_TRACE("Relocating %u tuples of tile group : %u", live_tuple_count,
+              tile_group_offset);
+    RelocateLiveVersions(tile_group.get());
+    return false;
+  }
+
+  LOG_TRACE("Unlinking tile group : %u", tile_group_offset);
+  if (UnlinkTileGroup(tile_group.get()) == false) {
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(compaction_mutex_);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    // transactions that begin from now on begin at or after this commit id
+    unlinked_tile_groups_[tile_group_id] = txn_manager.GetNextCommitId();
+  }
+
+  return false;
+}
+
+bool DataTable::RelocateLiveVersions(storage::TileGroup *tile_group) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto header = tile_group->GetHeader();
+  auto tile_group_id = tile_group->GetTileGroupId();
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+
+  txn_manager.BeginTransaction();
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    if (IsLiveVersion(header, tuple_id) == false) continue;
+
+    ItemPointer old_location(tile_group_id, tuple_id);
+    txn_manager.PerformRead(old_location);
+
+    // Like an update, the new version conflicts with concurrent writers
+    if (txn_manager.IsOwnable(header, tuple_id) == false ||
+        txn_manager.AcquireOwnership(header, tile_group_id, tuple_id) ==
+            false) {
+      LOG_TRACE("Fail to relocate tuple. Set txn failure.");
+      txn_manager.SetTransactionResult(Result::RESULT_FAILURE);
+      txn_manager.AbortTransaction();
+      return false;
+    }
+
+    std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+    tile_group->CopyTuple(tuple_id, tuple.get());
+
+    ItemPointer new_location = InsertVersion(tuple.get());
+    if (new_location.IsNull() == true) {
+      LOG_TRACE("Fail to insert new tuple. Set txn failure.");
+      txn_manager.SetTransactionResult(Result::RESULT_FAILURE);
+      txn_manager.AbortTransaction();
+      return false;
+    }
+
+    txn_manager.PerformUpdate(old_location, new_location);
+  }
+
+  return txn_manager.CommitTransaction() == Result::RESULT_SUCCESS;
+}
+
+// Own a version whose item pointers are rewritten, so that no writer
+// changes them meanwhile. Returns false if the version is owned already.
+static bool OwnVersion(const ItemPointer &location, const txn_id_t &txn_id) {
+  auto header = catalog::Manager::GetInstance()
+                    .GetTileGroupUnsafe(location.block)
+                    ->GetHeader();
+  header->IncreaseOwnerCount();
+  if (header->SetAtomicTransactionId(location.offset, txn_id) == true) {
+    return true;
+  }
+  header->DecreaseOwnerCount();
+
+  // Writers never own the versions left behind by deletes
+  return header->GetTransactionId(location.offset) == INVALID_TXN_ID;
+}
+
+static void ReleaseVersion(const ItemPointer &location,
+                           const txn_id_t &txn_id) {
+  auto header = catalog::Manager::GetInstance()
+                    .GetTileGroupUnsafe(location.block)
+                    ->GetHeader();
+  if (header->GetTransactionId(location.offset) == txn_id) {
+    header->SetTransactionId(location.offset, INITIAL_TXN_ID);
+    header->DecreaseOwnerCount();
+  }
+}
+
+bool DataTable::UnlinkTileGroup(storage::TileGroup *tile_group) {
+  auto &catalog_manager = catalog::Manager::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto header = tile_group->GetHeader();
+  auto tile_group_id = tile_group->GetTileGroupId();
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+
+  // The transaction keeps the tile groups of the chains from being
+  // reclaimed, and owns the versions whose item pointers are rewritten.
+  // Unlinking stops when a writer owns one of them and is retried later.
+  auto txn_id = txn_manager.BeginTransaction()->GetTransactionId();
+  bool unlinked = true;
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count && unlinked; tuple_id++) {
+    // Empty slot
+    if (header->GetBeginCommitId(tuple_id) == MAX_CID) continue;
+
+    expression::ContainerTuple<storage::TileGroup> tuple(tile_group, tuple_id);
+    ItemPointer location(tile_group_id, tuple_id);
+
+    auto index_count = GetIndexCount();
+    for (oid_t index_itr = 0; index_itr < index_count && unlinked;
+         index_itr++) {
+      auto index = GetIndex(index_itr);
+      if (index == nullptr) continue;
+
+      // Secondary indexes have an entry for every version
+      if (index->GetIndexType() != INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
+        DeleteInIndex(index_itr, &tuple, location);
+        continue;
+      }
+
+      // The primary index only points to the oldest version of a chain,
+      // so the chains of this key may lead into the tile group
+      std::vector<ItemPointer> chain_heads;
+      index->ScanTupleKey(&tuple, chain_heads);
+
+      for (auto chain_head : chain_heads) {
+        if (chain_head.block == tile_group_id) {
+          // Start the chain at the first version behind the tile group
+          auto next_location = GetVersionOutside(tile_group, chain_head);
+          if (next_location.IsNull() == false) {
+            if (OwnVersion(next_location, txn_id) == false) {
+              unlinked = false;
+              break;
+            }
+            catalog_manager.GetTileGroupUnsafe(next_location.block)
+                ->GetHeader()
+                ->SetPrevItemPointer(next_location.offset,
+                                     INVALID_ITEMPOINTER);
+            ReleaseVersion(next_location, txn_id);
+            index->InsertTupleEntry(&tuple, next_location);
+          }
+          index->DeleteTupleEntry(&tuple, chain_head);
+          continue;
+        }
+
+        // Bypass the versions stored in the tile group
+        auto chain_location = chain_head;
+        while (chain_location.IsNull() == false) {
+          auto chain_tile_group =
+              catalog_manager.GetTileGroupUnsafe(chain_location.block);
+          if (chain_tile_group == nullptr) break;
+
+          auto chain_header = chain_tile_group->GetHeader();
+          auto next_location =
+              chain_header->GetNextItemPointer(chain_location.offset);
+
+          if (next_location.block == tile_group_id) {
+            next_location = GetVersionOutside(tile_group, next_location);
+            if (OwnVersion(chain_location, txn_id) == false) {
+              unlinked = false;
+              break;
+            }
+            if (next_location.IsNull() == false &&
+                OwnVersion(next_location, txn_id) == false) {
+              ReleaseVersion(chain_location, txn_id);
+              unlinked = false;
+              break;
+            }
+
+            chain_header->SetNextItemPointer(chain_location.offset,
+                                             next_location);
+            ReleaseVersion(chain_location, txn_id);
+            if (next_location.IsNull() == false) {
+              catalog_manager.GetTileGroupUnsafe(next_location.block)
+                  ->GetHeader()
+                  ->SetPrevItemPointer(next_location.offset, chain_location);
+              ReleaseVersion(next_location, txn_id);
+            }
+          }
+
+          chain_location = next_location;
+        }
+
+        if (unlinked == false) break;
+      }
+    }
+  }
+
+  txn_manager.CommitTransaction();
+
+  return unlinked;
+}
+
 void DataTable::RecordLayoutSample(const brain::Sample &sample) {
   // Add layout sample
   {
@@ -0,0 +1,391 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// frozen_tile_group.cpp
+//
+// Identification: src/storage/frozen_tile_group.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "storage/frozen_tile_group.h"
+
+#include <algorithm>
+#include <map>
+
+#include "catalog/schema.h"
+#include "common/logger.h"
+#include "common/macros.h"
+#include "common/pool.h"
+#include "common/value_factory.h"
+#include "common/value_peeker.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace storage {
+
+static bool IsIntegerType(const ValueType &type) {
+  switch (type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_DATE:
+    case VALUE_TYPE_TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bool IsVarlenType(const ValueType &type) {
+  return (type == VALUE_TYPE_VARCHAR || type == VALUE_TYPE_VARBINARY);
+}
+
+static Value GetIntegerTypeValue(const ValueType &type, const int64_t &raw) {
+  switch (type) {
+    case VALUE_TYPE_TINYINT:
+      return ValueFactory::GetTinyIntValue(static_cast<int8_t>(raw));
+    case VALUE_TYPE_SMALLINT:
+      return ValueFactory::GetSmallIntValue(static_cast<int16_t>(raw));
+    case VALUE_TYPE_INTEGER:
+      return ValueFactory::GetIntegerValue(static_cast<int32_t>(raw));
+    case VALUE_TYPE_BIGINT:
+      return ValueFactory::GetBigIntValue(raw);
+    case VALUE_TYPE_DATE:
+      return ValueFactory::GetDateValue(raw);
+    case VALUE_TYPE_TIMESTAMP:
+      return ValueFactory::GetTimestampValue(raw);
+    default:
+      PL_ASSERT(false);
+      return Value::GetNullValue(type);
+  }
+}
+
+// Number of bits needed to store the value
+static oid_t GetBitWidth(uint64_t value) {
+  oid_t bit_width = 0;
+  while (value != 0) {
+    bit_width++;
+    value >>= 1;
+  }
+  return bit_width;
+}
+
+static size_t GetPackedWordCount(const oid_t &count, const oid_t &bit_width) {
+  return (static_cast<size_t>(count) * bit_width + 63) / 64;
+}
+
+static void PackBits(std::vector<uint64_t> &packed, const oid_t &bit_width,
+                     const oid_t &index, const uint64_t &value) {
+  if (bit_width == 0) return;
+  size_t bit_offset = static_cast<size_t>(index) * bit_width;
+  size_t word = bit_offset / 64;
+  size_t shift = bit_offset % 64;
+
+  packed[word] |= value << shift;
+  if (shift + bit_width > 64) {
+    packed[word + 1] |= value >> (64 - shift);
+  }
+}
+
+static uint64_t UnpackBits(const std::vector<uint64_t> &packed,
+                           const oid_t &bit_width, const oid_t &index) {
+  if (bit_width == 0) return 0;
+  size_t bit_offset = static_cast<size_t>(index) * bit_width;
+  size_t word = bit_offset / 64;
+  size_t shift = bit_offset % 64;
+
+  uint64_t value = packed[word] >> shift;
+  if (shift + bit_width > 64) {
+    value |= packed[word + 1] << (64 - shift);
+  }
+  if (bit_width < 64) {
+    value &= (1ULL << bit_width) - 1;
+  }
+  return value;
+}
+
+struct ValueLess {
+  bool operator()(const Value &lhs, const Value &rhs) const {
+    return lhs.Compare(rhs) < 0;
+  }
+};
+
+FrozenTileGroup::FrozenTileGroup(TileGroup *tile_group,
+                                 const oid_t &tuple_count)
+    : tuple_count(tuple_count) {
+  auto &schemas = tile_group->GetTileSchemas();
+
+  for (auto column_map_entry : tile_group->GetColumnMap()) {
+    auto column_id = column_map_entry.first;
+    auto &schema = schemas[column_map_entry.second.first];
+
+    FrozenColumn column;
+    column.value_type = schema.GetType(column_map_entry.second.second);
+
+    std::vector<Value> values;
+    values.reserve(tuple_count);
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      values.push_back(tile_group->GetValue(tuple_itr, column_id));
+    }
+
+    EncodeColumn(column, values);
+    columns.push_back(std::move(column));
+  }
+}
+
+FrozenTileGroup::~FrozenTileGroup() {
+  // Values referencing the pool are dropped with the columns
+}
+
+void FrozenTileGroup::EncodeColumn(FrozenColumn &column,
+                                   const std::vector<Value> &values) {
+  auto value_type = column.value_type;
+  column.base = 0;
+  column.bit_width = 0;
+  column.varlen_size = 0;
+
+  // Fill nulls with the previous value so that they extend runs and
+  // do not widen the ranges; the null flags override them when reading
+  const Value *filler = nullptr;
+  for (auto &value : values) {
+    if (value.IsNull() == false) {
+      filler = &value;
+      break;
+    }
+  }
+
+  // All values are null
+  if (filler == nullptr) {
+    column.encoding = COLUMN_ENCODING_TYPE_DICTIONARY;
+    column.nulls.assign(tuple_count, true);
+    return;
+  }
+
+  std::vector<const Value *> dense_values;
+  dense_values.reserve(tuple_count);
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    if (values[tuple_itr].IsNull()) {
+      if (column.nulls.empty()) column.nulls.assign(tuple_count, false);
+      column.nulls[tuple_itr] = true;
+    } else {
+      filler = &values[tuple_itr];
+    }
+    dense_values.push_back(filler);
+  }
+
+  // Collect the distinct values and the runs
+  std::map<Value, oid_t, ValueLess> dictionary;
+  size_t dictionary_varlen_size = 0;
+  size_t run_count = 0;
+  size_t run_varlen_size = 0;
+  int64_t min_value = 0, max_value = 0;
+  bool integer_type = IsIntegerType(value_type);
+  bool varlen_type = IsVarlenType(value_type);
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    auto &value = *dense_values[tuple_itr];
+    size_t varlen_size =
+        varlen_type ? ValuePeeker::PeekObjectLengthWithoutNull(value) : 0;
+
+    if (dictionary.emplace(value, 0).second) {
+      dictionary_varlen_size += varlen_size;
+    }
+
+    if (tuple_itr == 0 ||
+        value.Compare(*dense_values[tuple_itr - 1]) != 0) {
+      run_count++;
+      run_varlen_size += varlen_size;
+    }
+
+    if (integer_type) {
+      int64_t raw = ValuePeeker::PeekAsRawInt64(value);
+      if (tuple_itr == 0 || raw < min_value) min_value = raw;
+      if (tuple_itr == 0 || raw > max_value) max_value = raw;
+    }
+  }
+
+  // Pick the smallest encoding
+  oid_t offset_bit_width = GetBitWidth(static_cast<uint64_t>(max_value) -
+                                       static_cast<uint64_t>(min_value));
+  oid_t code_bit_width = GetBitWidth(dictionary.size() - 1);
+
+  size_t dictionary_size =
+      dictionary.size() * sizeof(Value) + dictionary_varlen_size +
+      GetPackedWordCount(tuple_count, code_bit_width) * sizeof(uint64_t);
+  size_t run_length_size =
+      run_count * (sizeof(Value) + sizeof(oid_t)) + run_varlen_size;
+
+  column.encoding = COLUMN_ENCODING_TYPE_DICTIONARY;
+  size_t encoded_size = dictionary_size;
+
+  if (run_length_size < encoded_size) {
+    column.encoding = COLUMN_ENCODING_TYPE_RUN_LENGTH;
+    encoded_size = run_length_size;
+  }
+
+  if (integer_type) {
+    size_t bit_packed_size =
+        GetPackedWordCount(tuple_count, offset_bit_width) * sizeof(uint64_t);
+    if (bit_packed_size <= encoded_size) {
+      column.encoding = COLUMN_ENCODING_TYPE_BIT_PACKED;
+      encoded_size = bit_packed_size;
+    }
+  } else if (varlen_type == false) {
+    size_t plain_size =
+        static_cast<size_t>(tuple_count) * Value::GetTupleStorageSize(value_type);
+    if (plain_size <= encoded_size) {
+      column.encoding = COLUMN_ENCODING_TYPE_PLAIN;
+      encoded_size = plain_size;
+    }
+  }
+
+  switch (column.encoding) {
+    case COLUMN_ENCODING_TYPE_BIT_PACKED: {
+      column.base = min_value;
+      column.bit_width = offset_bit_width;
+      column.packed.assign(GetPackedWordCount(tuple_count, offset_bit_width),
+                           0);
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        int64_t raw = ValuePeeker::PeekAsRawInt64(*dense_values[tuple_itr]);
+        PackBits(column.packed, column.bit_width, tuple_itr,
+                 static_cast<uint64_t>(raw) - static_cast<uint64_t>(min_value));
+      }
+    } break;
+
+    case COLUMN_ENCODING_TYPE_DICTIONARY: {
+      // Codes follow the value order, so code comparisons match value ones
+      for (auto &dictionary_entry : dictionary) {
+        dictionary_entry.second = column.values.size();
+        column.values.push_back(CopyValue(dictionary_entry.first));
+      }
+      column.varlen_size = dictionary_varlen_size;
+      column.bit_width = code_bit_width;
+      column.packed.assign(GetPackedWordCount(tuple_count, code_bit_width), 0);
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        PackBits(column.packed, column.bit_width, tuple_itr,
+                 dictionary.at(*dense_values[tuple_itr]));
+      }
+    } break;
+
+    case COLUMN_ENCODING_TYPE_RUN_LENGTH: {
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        auto &value = *dense_values[tuple_itr];
+        if (tuple_itr == 0 ||
+            value.Compare(*dense_values[tuple_itr - 1]) != 0) {
+          column.values.push_back(CopyValue(value));
+          column.run_ends.push_back(tuple_itr + 1);
+        } else {
+          column.run_ends.back() = tuple_itr + 1;
+        }
+      }
+      column.varlen_size = run_varlen_size;
+    } break;
+
+    case COLUMN_ENCODING_TYPE_PLAIN: {
+      auto value_size = Value::GetTupleStorageSize(value_type);
+      column.plain_data.resize(static_cast<size_t>(tuple_count) * value_size);
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        dense_values[tuple_itr]->SerializeToTupleStorage(
+            &column.plain_data[static_cast<size_t>(tuple_itr) * value_size],
+            true, value_size, true);
+      }
+    } break;
+
+    default:
+      PL_ASSERT(false);
+      break;
+  }
+
+  LOG_TRACE("Froze column of type %s with encoding %d into %lu bytes",
+            ValueTypeToString(value_type).c_str(), column.encoding,
+            encoded_size);
+}
+
+// Copy varlen values into the pool of the frozen tile group
+Value FrozenTileGroup::CopyValue(const Value &value) {
+  auto value_type = value.GetValueType();
+  if (IsVarlenType(value_type) == false) return value;
+
+  if (pool == nullptr) {
+    pool.reset(new VarlenPool(BACKEND_TYPE_MM));
+  }
+
+  auto data = reinterpret_cast<const char *>(
+      ValuePeeker::PeekObjectValueWithoutNull(value));
+  auto length = ValuePeeker::PeekObjectLengthWithoutNull(value);
+
+  if (value_type == VALUE_TYPE_VARCHAR) {
+    return ValueFactory::GetStringValue(std::string(data, length), pool.get());
+  }
+
+  return ValueFactory::GetBinaryValue(
+      reinterpret_cast<const unsigned char *>(data), length, pool.get());
+}
+
+Value FrozenTileGroup::GetValue(const oid_t &tuple_id,
+                                const oid_t &column_id) const {
+  PL_ASSERT(tuple_id < tuple_count);
+  PL_ASSERT(column_id < columns.size());
+  auto &column = columns[column_id];
+
+  if (column.nulls.empty() == false && column.nulls[tuple_id]) {
+    return Value::GetNullValue(column.value_type);
+  }
+
+  switch (column.encoding) {
+    case COLUMN_ENCODING_TYPE_BIT_PACKED: {
+      uint64_t offset = UnpackBits(column.packed, column.bit_width, tuple_id);
+      return GetIntegerTypeValue(
+          column.value_type,
+          static_cast<int64_t>(static_cast<uint64_t>(column.base) + offset));
+    }
+
+    case COLUMN_ENCODING_TYPE_DICTIONARY:
+      return column.values[UnpackBits(column.packed, column.bit_width,
+                                      tuple_id)];
+
+    case COLUMN_ENCODING_TYPE_RUN_LENGTH: {
+      auto run_itr = std::upper_bound(column.run_ends.begin(),
+                                      column.run_ends.end(), tuple_id);
+      return column.values[run_itr - column.run_ends.begin()];
+    }
+
+    case COLUMN_ENCODING_TYPE_PLAIN: {
+      auto value_size = Value::GetTupleStorageSize(column.value_type);
+      return Value::InitFromTupleStorage(
+          &column.plain_data[static_cast<size_t>(tuple_id) * value_size],
+          column.value_type, true);
+    }
+
+    default:
+      PL_ASSERT(false);
+      return Value::GetNullValue(column.value_type);
+  }
+}
+
+ColumnEncodingType FrozenTileGroup::GetColumnEncoding(
+    const oid_t &column_id) const {
+  PL_ASSERT(column_id < columns.size());
+  return columns[column_id].encoding;
+}
+
+size_t FrozenTileGroup::GetMemoryFootprint() const {
+  size_t footprint = 0;
+  for (auto &column : columns) {
+    footprint += column.packed.size() * sizeof(uint64_t);
+    footprint += column.values.size() * sizeof(Value);
+    footprint += column.run_ends.size() * sizeof(oid_t);
+    footprint += column.plain_data.size();
+    footprint += column.nulls.size() / 8;
+    footprint += column.varlen_size;
+  }
+  return footprint;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
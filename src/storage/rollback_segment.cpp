@@ -14,6 +14,7 @@
 #include "storage/rollback_segment.h"
 #include "logging/log_manager.h"
 #include "planner/project_info.h"
+#include "storage/tuple.h"
 
 namespace peloton {
 namespace storage {
@@ -35,7 +36,6 @@ RBSegType RollbackSegmentPool::CreateSegmentFromTuple(
     const catalog::Schema *schema, const TargetList &target_list,
     const AbstractTuple *tuple) {
   PL_ASSERT(schema);
-  PL_ASSERT(target_list.size() != 0);
 
   size_t col_count = target_list.size();
   size_t header_size = pairs_start_offset + col_count * sizeof(ColIdOffsetPair);
@@ -102,5 +102,20 @@ Value RollbackSegmentPool::GetValue(RBSegType rb_seg,
   return Value::InitFromTupleStorage(data_ptr, column_type, is_inlined);
 }
 
+/**
+ * @brief Overwrite the recorded columns of a tuple with the values on the
+ * rollback segment
+ */
+void RollbackSegmentPool::ApplyToTuple(RBSegType rb_seg,
+                                       const catalog::Schema *schema,
+                                       Tuple *tuple, VarlenPool *pool) {
+  auto seg_col_count = GetColCount(rb_seg);
+
+  for (size_t idx = 0; idx < seg_col_count; ++idx) {
+    auto col_id = GetIdOffsetPair(rb_seg, idx)->col_id;
+    tuple->SetValue(col_id, GetValue(rb_seg, schema, idx), pool);
+  }
+}
+
 }  // End storage namespace
 }  // End peloton namespace
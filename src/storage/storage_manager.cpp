@@ -20,8 +20,10 @@
 #include <unistd.h>
 #include <string.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <cpuid.h>
 
+#include <climits>
 #include <string>
 #include <iostream>
 
@@ -47,6 +49,12 @@ extern int peloton_pcommit_latency;
 // PMEM file size
 size_t peloton_data_file_size = 0;
 
+// Huge pages for in-memory data
+extern bool peloton_huge_page_allocation;
+
+// NUMA-local placement of in-memory data
+extern bool peloton_numa_aware_allocation;
+
 namespace peloton {
 namespace storage {
 
@@ -304,6 +312,83 @@ static void drain_pcommit(void) {
  */
 static void (*Func_drain)(void) = drain_no_pcommit;
 
+//===--------------------------------------------------------------------===//
+// MEMORY MAPPING
+//===--------------------------------------------------------------------===//
+
+// Smaller in-memory blocks are left to the heap allocator
+#define LARGE_ALLOCATION_SIZE (256 * 1024)  // 256 KB
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)  // 2 MB
+
+// Memory policy that prefers the given nodes (see mbind(2))
+#define MPOL_PREFERRED_MODE 1
+
+// Number of NUMA nodes supported by the node mask
+#define MAX_NUMA_NODE_COUNT 1024
+
+static size_t RoundUp(size_t size, size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+// Prefer the NUMA node of the calling thread for the pages of the mapping.
+// The policy is set before the pages are touched, so it also applies when
+// another thread touches them first.
+static void BindToLocalNode(void *address, size_t length) {
+  unsigned int cpu = 0, node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return;
+  if (node >= MAX_NUMA_NODE_COUNT) return;
+
+  const size_t bits_per_word = sizeof(unsigned long) * CHAR_BIT;
+  unsigned long node_mask[MAX_NUMA_NODE_COUNT / bits_per_word] = {0};
+  node_mask[node / bits_per_word] |= 1UL << (node % bits_per_word);
+
+  if (syscall(SYS_mbind, address, length, MPOL_PREFERRED_MODE, node_mask,
+              MAX_NUMA_NODE_COUNT, 0) != 0) {
+    LOG_TRACE("mbind failed : %s", strerror(errno));
+  }
+}
+
+// Map anonymous memory, preferring huge pages if requested
+static void *MapMemory(size_t size, size_t &mapped_size, bool &huge_pages) {
+  void *address = MAP_FAILED;
+  mapped_size = RoundUp(size, sysconf(_SC_PAGESIZE));
+  huge_pages = false;
+
+  if (peloton_huge_page_allocation == true) {
+    // Use reserved huge pages if rounding up wastes little memory
+    size_t huge_mapped_size = RoundUp(size, HUGE_PAGE_SIZE);
+    if (huge_mapped_size - size <= size / 8) {
+      address = mmap(nullptr, huge_mapped_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (address != MAP_FAILED) {
+        mapped_size = huge_mapped_size;
+        huge_pages = true;
+      }
+    }
+  }
+
+  if (address == MAP_FAILED) {
+    address = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (address == MAP_FAILED) {
+      throw Exception("could not map memory : " + std::to_string(size) +
+                      " bytes : " + std::string(strerror(errno)));
+    }
+
+    // Fall back to transparent huge pages
+    if (peloton_huge_page_allocation == true) {
+      madvise(address, mapped_size, MADV_HUGEPAGE);
+    }
+  }
+
+  if (peloton_numa_aware_allocation == true) {
+    BindToLocalNode(address, mapped_size);
+  }
+
+  return address;
+}
+
 //===--------------------------------------------------------------------===//
 // STORAGE MANAGER
 //===--------------------------------------------------------------------===//
@@ -318,7 +403,11 @@ StorageManager &StorageManager::GetInstance(void) {
 }
 
 StorageManager::StorageManager()
-    : data_file_address(nullptr), data_file_len(0), data_file_offset(0) {
+    : data_file_address(nullptr),
+      data_file_len(0),
+      data_file_offset(0),
+      mapped_allocation_count(0),
+      huge_page_allocation_count(0) {
   // Check if we need a data pool
   if (IsBasedOnWriteAheadLogging(peloton_logging_mode) == true ||
       peloton_logging_mode == LOGGING_TYPE_INVALID) {
@@ -452,7 +541,10 @@ void *StorageManager::Allocate(BackendType type, size_t size) {
   allocation_count++;
 
   switch (type) {
-    case BACKEND_TYPE_MM:
+    case BACKEND_TYPE_MM: {
+      return AllocateMemory(size);
+    } break;
+
     case BACKEND_TYPE_NVM: {
       return ::operator new(size);
     } break;
@@ -499,7 +591,10 @@ void *StorageManager::Allocate(BackendType type, size_t size) {
 
 void StorageManager::Release(BackendType type, void *address) {
   switch (type) {
-    case BACKEND_TYPE_MM:
+    case BACKEND_TYPE_MM: {
+      ReleaseMemory(address);
+    } break;
+
     case BACKEND_TYPE_NVM: {
       ::operator delete(address);
     } break;
@@ -517,6 +612,58 @@ void StorageManager::Release(BackendType type, void *address) {
   }
 }
 
+/**
+ * Large blocks get their own mapping, so they can use huge pages and be
+ * placed on the NUMA node of the allocating thread. The length of every
+ * mapping is kept in a side table rather than in front of the block, so a
+ * power-of-two block fills its huge pages exactly and starts on a page
+ * boundary. Release looks the address up there, so changing the
+ * configuration at runtime is safe.
+ */
+void *StorageManager::AllocateMemory(size_t size) {
+  bool map_memory = (peloton_huge_page_allocation == true ||
+                     peloton_numa_aware_allocation == true) &&
+                    size >= LARGE_ALLOCATION_SIZE;
+
+  if (map_memory == false) {
+    return ::operator new(size);
+  }
+
+  size_t mapped_size = 0;
+  bool huge_pages = false;
+  void *address = MapMemory(size, mapped_size, huge_pages);
+
+  mapped_memory_spinlock.Lock();
+  mapped_memory_sizes[address] = mapped_size;
+  mapped_memory_spinlock.Unlock();
+
+  mapped_allocation_count++;
+  if (huge_pages == true) {
+    huge_page_allocation_count++;
+  }
+
+  return address;
+}
+
+void StorageManager::ReleaseMemory(void *address) {
+  if (address == nullptr) return;
+
+  size_t mapped_size = 0;
+  mapped_memory_spinlock.Lock();
+  auto mapped_memory_itr = mapped_memory_sizes.find(address);
+  if (mapped_memory_itr != mapped_memory_sizes.end()) {
+    mapped_size = mapped_memory_itr->second;
+    mapped_memory_sizes.erase(mapped_memory_itr);
+  }
+  mapped_memory_spinlock.Unlock();
+
+  if (mapped_size == 0) {
+    ::operator delete(address);
+  } else if (munmap(address, mapped_size) != 0) {
+    perror("munmap");
+  }
+}
+
 void StorageManager::Sync(BackendType type, void *address, size_t length) {
   switch (type) {
     case BACKEND_TYPE_MM: {
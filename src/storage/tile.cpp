@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <algorithm>
 #include <cstdio>
 #include <sstream>
 
@@ -31,6 +32,23 @@
 namespace peloton {
 namespace storage {
 
+// Expected size of an uninlined value
+static const size_t POOL_BYTES_PER_UNINLINED_VALUE = 32;
+
+// Bounds of the size of the chunks of the tile pools
+static const size_t MIN_POOL_CHUNK_SIZE = 4 * 1024;         // 4 KB
+static const size_t MAX_POOL_CHUNK_SIZE = 4 * 1024 * 1024;  // 4 MB
+
+// Size the pool chunks so that a full tile needs only a few of them
+static size_t GetPoolChunkSize(const catalog::Schema &schema,
+                               const int &tuple_count) {
+  size_t chunk_size = nexthigher(static_cast<size_t>(tuple_count) *
+                                 schema.GetUninlinedColumnCount() *
+                                 POOL_BYTES_PER_UNINLINED_VALUE);
+  chunk_size = std::max(chunk_size, MIN_POOL_CHUNK_SIZE);
+  return std::min(chunk_size, MAX_POOL_CHUNK_SIZE);
+}
+
 Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
            const catalog::Schema &tuple_schema, TileGroup *tile_group,
            int tuple_count)
@@ -65,7 +83,7 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
 
   // allocate pool for blob storage if schema not inlined
   if (schema.IsInlined() == false) {
-    pool = new VarlenPool(backend_type);
+    pool = new VarlenPool(backend_type, GetPoolChunkSize(schema, tuple_count));
   }
 }
 
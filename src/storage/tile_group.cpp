@@ -20,6 +20,7 @@
 #include "common/logger.h"
 #include "common/types.h"
 #include "storage/abstract_table.h"
+#include "storage/frozen_tile_group.h"
 #include "storage/tile.h"
 #include "storage/tuple.h"
 #include "storage/tile_group_header.h"
@@ -28,10 +29,31 @@
 namespace peloton {
 namespace storage {
 
+// Types of the columns in the tile group, in column offset order
+static std::vector<ValueType> GetColumnTypes(
+    const std::vector<catalog::Schema> &schemas,
+    const column_map_type &column_map) {
+  std::vector<ValueType> column_types;
+  for (auto column_map_entry : column_map) {
+    auto tile_offset = column_map_entry.second.first;
+    auto tile_column_offset = column_map_entry.second.second;
+    column_types.push_back(schemas[tile_offset].GetType(tile_column_offset));
+  }
+  return column_types;
+}
+
 TileGroup::TileGroup(BackendType backend_type,
                      TileGroupHeader *tile_group_header, AbstractTable *table,
                      const std::vector<catalog::Schema> &schemas,
                      const column_map_type &column_map, int tuple_count)
+    : TileGroup(backend_type, tile_group_header, table, schemas, column_map,
+                tuple_count, nullptr) {}
+
+TileGroup::TileGroup(BackendType backend_type,
+                     TileGroupHeader *tile_group_header, AbstractTable *table,
+                     const std::vector<catalog::Schema> &schemas,
+                     const column_map_type &column_map, int tuple_count,
+                     FrozenTileGroup *frozen_tile_group)
     : database_id(INVALID_OID),
       table_id(INVALID_OID),
       tile_group_id(INVALID_OID),
@@ -40,22 +62,61 @@ TileGroup::TileGroup(BackendType backend_type,
       tile_group_header(tile_group_header),
       table(table),
       num_tuple_slots(tuple_count),
-      column_map(column_map) {
+      column_map(column_map),
+      zone_map(GetColumnTypes(schemas, column_map)),
+      frozen_tile_group(frozen_tile_group),
+      frozen(frozen_tile_group != nullptr) {
   tile_count = tile_schemas.size();
+  tiles.resize(tile_count);
 
+  // The tiles of a frozen tile group are only created when it is thawed
+  if (frozen_tile_group == nullptr) {
+    CreateTiles();
+  }
+}
+
+void TileGroup::CreateTiles() {
   for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
     auto &manager = catalog::Manager::GetInstance();
     oid_t tile_id = manager.GetNextOid();
 
     std::shared_ptr<Tile> tile(storage::TileFactory::GetTile(
         backend_type, database_id, table_id, tile_group_id, tile_id,
-        tile_group_header, tile_schemas[tile_itr], this, tuple_count));
+        tile_group_header, tile_schemas[tile_itr], this, num_tuple_slots));
 
     // Add a reference to the tile in the tile group
-    tiles.push_back(tile);
+    tiles[tile_itr] = tile;
   }
 }
 
+/**
+ * Decompress the frozen tile group into tiles, then release it.
+ * Readers that already decode from it hold their own reference.
+ */
+void TileGroup::Thaw() {
+  std::lock_guard<std::mutex> lock(tile_group_mutex);
+  if (frozen.load() == false) return;
+
+  LOG_TRACE("Thawing tile group %u", tile_group_id);
+
+  CreateTiles();
+
+  auto tuple_count = frozen_tile_group->GetTupleCount();
+  for (auto column_map_entry : column_map) {
+    auto column_id = column_map_entry.first;
+    auto tile = tiles[column_map_entry.second.first].get();
+    auto tile_column_id = column_map_entry.second.second;
+
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      tile->SetValue(frozen_tile_group->GetValue(tuple_itr, column_id),
+                     tuple_itr, tile_column_id);
+    }
+  }
+
+  frozen.store(false);
+  std::atomic_store(&frozen_tile_group, std::shared_ptr<FrozenTileGroup>());
+}
+
 TileGroup::~TileGroup() {
   // Drop references on all tiles
 
@@ -71,6 +132,8 @@ TileGroup::~TileGroup() {
  * Apply the column delta on the rollback segment to the given tuple
  */
 void TileGroup::ApplyRollbackSegment(char *rb_seg, const oid_t &tuple_slot_id) {
+  if (IsFrozen()) Thaw();
+
   auto seg_col_count = storage::RollbackSegmentPool::GetColCount(rb_seg);
   auto table_schema = GetAbstractTable()->GetSchema();
 
@@ -106,6 +169,8 @@ void TileGroup::ApplyRollbackSegment(char *rb_seg, const oid_t &tuple_slot_id) {
  * Returns slot where inserted (INVALID_ID if not inserted)
  */
 void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
+  if (IsFrozen()) Thaw();
+
   LOG_TRACE("Tile Group Id :: %u status :: %u out of %u slots ", tile_group_id,
             tuple_slot_id, num_tuple_slots);
 
@@ -131,6 +196,8 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
       column_itr++;
     }
   }
+
+  zone_map.Update(tuple, false);
 }
 
 // This is commented out before merge
@@ -146,6 +213,18 @@ void TileGroup::CopyTuple(const oid_t &tuple_slot_id, Tuple *tuple) {
   }
 }
 
+void TileGroup::SetValue(const Value &value, const oid_t &tuple_slot_id,
+                         const oid_t &column_id) {
+  if (IsFrozen()) Thaw();
+
+  oid_t tile_column_id, tile_offset;
+  LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+
+  GetTile(tile_offset)->SetValue(value, tuple_slot_id, tile_column_id);
+
+  zone_map.UpdateColumn(column_id, value);
+}
+
 /**
  * Grab next slot (thread-safe) and fill in the tuple
  *
@@ -163,6 +242,8 @@ oid_t TileGroup::InsertTuple(const Tuple *tuple) {
     return INVALID_OID;
   }
 
+  if (IsFrozen()) Thaw();
+
   oid_t tile_column_count;
   oid_t column_itr = 0;
 
@@ -186,6 +267,8 @@ oid_t TileGroup::InsertTuple(const Tuple *tuple) {
     }
   }
 
+  zone_map.Update(tuple, true);
+
   // Set MVCC info
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot_id) ==
             INVALID_TXN_ID);
@@ -207,6 +290,8 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
   // No more slots
   if (status == false) return INVALID_OID;
 
+  if (IsFrozen()) Thaw();
+
   tile_group_header->GetHeaderLock().Lock();
 
   cid_t current_begin_cid = tile_group_header->GetBeginCommitId(tuple_slot_id);
@@ -241,6 +326,8 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
     }
   }
 
+  zone_map.Update(tuple, false);
+
   // Set MVCC info
   tile_group_header->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
@@ -321,6 +408,8 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
   // No more slots
   if (status == false) return INVALID_OID;
 
+  if (IsFrozen()) Thaw();
+
   LOG_TRACE("Tile Group Id :: %u status :: %u out of %u slots ", tile_group_id,
             tuple_slot_id, num_tuple_slots);
 
@@ -347,6 +436,8 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
     }
   }
 
+  zone_map.Update(tuple, false);
+
   // Set MVCC info
   tile_group_header->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
@@ -384,6 +475,14 @@ oid_t TileGroup::GetTileColumnId(oid_t column_id) {
 
 Value TileGroup::GetValue(oid_t tuple_id, oid_t column_id) {
   PL_ASSERT(tuple_id < GetNextTupleSlot());
+  if (IsFrozen()) {
+    auto frozen_values = std::atomic_load(&frozen_tile_group);
+    // the tiles are complete once a thaw releases the frozen tile group
+    if (frozen_values != nullptr) {
+      return frozen_values->GetValue(tuple_id, column_id);
+    }
+  }
+
   oid_t tile_column_id, tile_offset;
   LocateTileAndColumn(column_id, tile_offset, tile_column_id);
   return GetTile(tile_offset)->GetValue(tuple_id, tile_column_id);
@@ -412,7 +511,8 @@ double TileGroup::GetSchemaDifference(
 void TileGroup::Sync() {
   // Sync the tile group data by syncing all the underlying tiles
   for (auto tile : tiles) {
-    tile->Sync();
+    // frozen tile groups have no tiles to sync
+    if (tile != nullptr) tile->Sync();
   }
 }
 
@@ -432,9 +532,14 @@ const std::string TileGroup::GetInfo() const {
 
   os << " TILE GROUP HEADER :: " << tile_group_header;
 
-  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
-    Tile *tile = GetTile(tile_itr);
-    if (tile != nullptr) os << (*tile);
+  auto frozen_values = GetFrozenTileGroup();
+  if (frozen_values != nullptr) {
+    os << " FROZEN :: " << frozen_values->GetMemoryFootprint() << " bytes\n";
+  } else {
+    for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+      Tile *tile = GetTile(tile_itr);
+      if (tile != nullptr) os << (*tile);
+    }
   }
 
   auto header = GetHeader();
@@ -12,6 +12,7 @@
 
 
 #include "storage/tile_group_factory.h"
+#include "storage/frozen_tile_group.h"
 #include "storage/tile_group_header.h"
 
 //===--------------------------------------------------------------------===//
@@ -21,6 +22,9 @@
 // Logging mode
 extern LoggingType peloton_logging_mode;
 
+// Header layout mode
+extern LayoutType peloton_header_layout_mode;
+
 namespace peloton {
 namespace storage {
 
@@ -31,7 +35,8 @@ TileGroup *TileGroupFactory::GetTileGroup(
   // Allocate the data on appropriate backend
   BackendType backend_type = GetBackendType(peloton_logging_mode);
 
-  TileGroupHeader *tile_header = new TileGroupHeader(backend_type, tuple_count);
+  TileGroupHeader *tile_header = new TileGroupHeader(
+      backend_type, tuple_count, peloton_header_layout_mode);
   TileGroup *tile_group = new TileGroup(backend_type, tile_header, table,
                                         schemas, column_map, tuple_count);
 
@@ -44,5 +49,34 @@ TileGroup *TileGroupFactory::GetTileGroup(
   return tile_group;
 }
 
+TileGroup *TileGroupFactory::GetFrozenTileGroup(TileGroup *tile_group) {
+  auto backend_type = tile_group->backend_type;
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+  auto header = tile_group->GetHeader();
+
+  // Compress the values of all the allocated slots
+  FrozenTileGroup *frozen_tile_group =
+      new FrozenTileGroup(tile_group, header->GetCurrentNextTupleSlot());
+
+  TileGroupHeader *tile_header =
+      new TileGroupHeader(backend_type, tuple_count, header->GetHeaderLayout());
+  TileGroup *new_tile_group = new TileGroup(
+      backend_type, tile_header, tile_group->GetAbstractTable(),
+      tile_group->GetTileSchemas(), tile_group->GetColumnMap(), tuple_count,
+      frozen_tile_group);
+
+  tile_header->SetTileGroup(new_tile_group);
+
+  new_tile_group->database_id = tile_group->GetDatabaseId();
+  new_tile_group->tile_group_id = tile_group->GetTileGroupId();
+  new_tile_group->table_id = tile_group->GetTableId();
+
+  // Copy over the MVCC info and the ranges of the values
+  *tile_header = *header;
+  new_tile_group->zone_map = tile_group->GetZoneMap();
+
+  return new_tile_group;
+}
+
 }  // End storage namespace
 }  // End peloton namespace
@@ -30,11 +30,16 @@ namespace peloton {
 namespace storage {
 
 TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
-                                 const int &tuple_count)
+                                 const int &tuple_count,
+                                 const LayoutType &header_layout)
     : backend_type(backend_type),
+      header_layout(header_layout),
       data(nullptr),
       num_tuple_slots(tuple_count),
       next_tuple_slot(0),
+      owner_count(0),
+      last_end_cid(0),
+      full_cid(MAX_CID),
       tile_header_lock() {
   header_size = num_tuple_slots * header_entry_size;
 
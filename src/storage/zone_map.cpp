@@ -0,0 +1,378 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.cpp
+//
+// Identification: src/storage/zone_map.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "storage/zone_map.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "common/logger.h"
+#include "common/macros.h"
+#include "common/value_factory.h"
+#include "common/value_peeker.h"
+#include "expression/abstract_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace storage {
+
+// Types whose values fit in a word and can be ordered with Value::Compare
+static bool IsZoneMapType(const ValueType &type) {
+  switch (type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_DOUBLE:
+    case VALUE_TYPE_DATE:
+    case VALUE_TYPE_TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Key of a non-null value of the column type, ordered as the values are.
+// Returns false if the value has another type or is not a number.
+static bool GetKey(const Value &value, const ValueType &column_type,
+                   int64_t &key) {
+  if (value.GetValueType() != column_type) return false;
+
+  switch (column_type) {
+    case VALUE_TYPE_TINYINT:
+      key = ValuePeeker::PeekTinyInt(value);
+      return true;
+    case VALUE_TYPE_SMALLINT:
+      key = ValuePeeker::PeekSmallInt(value);
+      return true;
+    case VALUE_TYPE_INTEGER:
+      key = ValuePeeker::PeekInteger(value);
+      return true;
+    case VALUE_TYPE_BIGINT:
+      key = ValuePeeker::PeekBigInt(value);
+      return true;
+    case VALUE_TYPE_DATE:
+      key = ValuePeeker::PeekDate(value);
+      return true;
+    case VALUE_TYPE_TIMESTAMP:
+      key = ValuePeeker::PeekTimestamp(value);
+      return true;
+    case VALUE_TYPE_DOUBLE: {
+      double double_value = ValuePeeker::PeekDouble(value);
+      if (std::isnan(double_value)) return false;
+      // -0 and 0 get the same key
+      if (double_value == 0) double_value = 0;
+      std::memcpy(&key, &double_value, sizeof(key));
+      // the bits of negative doubles grow with their magnitude
+      if (key < 0) key ^= INT64_MAX;
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// The value of a key returned by GetKey
+static Value GetKeyValue(int64_t key, const ValueType &column_type) {
+  switch (column_type) {
+    case VALUE_TYPE_TINYINT:
+      return ValueFactory::GetTinyIntValue(static_cast<int8_t>(key));
+    case VALUE_TYPE_SMALLINT:
+      return ValueFactory::GetSmallIntValue(static_cast<int16_t>(key));
+    case VALUE_TYPE_INTEGER:
+      return ValueFactory::GetIntegerValue(static_cast<int32_t>(key));
+    case VALUE_TYPE_BIGINT:
+      return ValueFactory::GetBigIntValue(key);
+    case VALUE_TYPE_DATE:
+      return ValueFactory::GetDateValue(key);
+    case VALUE_TYPE_TIMESTAMP:
+      return ValueFactory::GetTimestampValue(key);
+    case VALUE_TYPE_DOUBLE: {
+      if (key < 0) key ^= INT64_MAX;
+      double double_value;
+      std::memcpy(&double_value, &key, sizeof(key));
+      return ValueFactory::GetDoubleValue(double_value);
+    }
+    default:
+      return Value();
+  }
+}
+
+// Types that Value::Compare can compare with each other
+static bool IsComparable(const ValueType &column_type,
+                         const ValueType &constant_type) {
+  if (column_type == constant_type) return true;
+
+  switch (column_type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_DOUBLE:
+    case VALUE_TYPE_DECIMAL:
+      break;
+    default:
+      return false;
+  }
+
+  switch (constant_type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_DOUBLE:
+    case VALUE_TYPE_DECIMAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Mirror the comparison so that the column is on the left side
+static ExpressionType FlipComparison(const ExpressionType &type) {
+  switch (type) {
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      return EXPRESSION_TYPE_COMPARE_GREATERTHAN;
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      return EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      return EXPRESSION_TYPE_COMPARE_LESSTHAN;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO;
+    default:
+      return type;
+  }
+}
+
+ZoneMap::ZoneMap(const std::vector<ValueType> &column_types)
+    : column_count(column_types.size()),
+      column_ranges(new ColumnRange[column_types.size()]),
+      covered_tuple_count(0) {
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    auto &column_range = column_ranges[column_itr];
+    column_range.column_type = column_types[column_itr];
+    column_range.tracked = IsZoneMapType(column_types[column_itr]);
+    column_range.min_key = INT64_MAX;
+    column_range.max_key = INT64_MIN;
+    column_range.null_count = 0;
+  }
+}
+
+ZoneMap &ZoneMap::operator=(const ZoneMap &other) {
+  // check for self-assignment
+  if (&other == this) return *this;
+
+  PL_ASSERT(column_count == other.column_count);
+
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    auto &column_range = column_ranges[column_itr];
+    auto &other_column_range = other.column_ranges[column_itr];
+    column_range.tracked = other_column_range.tracked.load();
+    column_range.min_key = other_column_range.min_key.load();
+    column_range.max_key = other_column_range.max_key.load();
+    column_range.null_count = other_column_range.null_count.load();
+  }
+  covered_tuple_count = other.covered_tuple_count.load();
+
+  return *this;
+}
+
+void ZoneMap::Update(const Tuple *tuple, const bool &new_tuple_slot) {
+  oid_t tuple_column_count = column_count;
+  if (tuple->GetColumnCount() < tuple_column_count) {
+    tuple_column_count = tuple->GetColumnCount();
+  }
+
+  for (oid_t column_itr = 0; column_itr < tuple_column_count; column_itr++) {
+    auto &column_range = column_ranges[column_itr];
+    if (column_range.tracked == false) continue;
+
+    WidenRange(column_range, tuple->GetValue(column_itr));
+  }
+
+  // the slot is counted only after its values are in the ranges
+  if (new_tuple_slot) {
+    covered_tuple_count++;
+  }
+}
+
+void ZoneMap::UpdateColumn(const oid_t &column_id, const Value &value) {
+  if (column_id >= column_count) return;
+
+  auto &column_range = column_ranges[column_id];
+  if (column_range.tracked == true) {
+    WidenRange(column_range, value);
+  }
+}
+
+void ZoneMap::WidenRange(ColumnRange &column_range, const Value &value) {
+  if (value.IsNull()) {
+    column_range.null_count++;
+    return;
+  }
+
+  int64_t key;
+  if (GetKey(value, column_range.column_type, key) == false) {
+    // the tuple does not match the tile group schema
+    column_range.tracked = false;
+    return;
+  }
+
+  auto min_key = column_range.min_key.load();
+  while (key < min_key &&
+         column_range.min_key.compare_exchange_weak(min_key, key) == false)
+    ;
+
+  auto max_key = column_range.max_key.load();
+  while (key > max_key &&
+         column_range.max_key.compare_exchange_weak(max_key, key) == false)
+    ;
+}
+
+bool ZoneMap::CanSkip(const expression::AbstractExpression *predicate,
+                      const oid_t &tuple_count) const {
+  if (predicate == nullptr) return false;
+
+  // some slots were filled without going through the zone map
+  if (covered_tuple_count.load() < tuple_count) return false;
+
+  if (predicate->GetExpressionType() == EXPRESSION_TYPE_CONJUNCTION_AND) {
+    return CanSkip(predicate->GetLeft(), tuple_count) ||
+           CanSkip(predicate->GetRight(), tuple_count);
+  }
+
+  return CanSkipComparison(predicate);
+}
+
+bool ZoneMap::CanSkipComparison(
+    const expression::AbstractExpression *predicate) const {
+  auto comparison_type = predicate->GetExpressionType();
+  switch (comparison_type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      break;
+    default:
+      return false;
+  }
+
+  auto left = predicate->GetLeft();
+  auto right = predicate->GetRight();
+  if (left == nullptr || right == nullptr) return false;
+
+  // only handle comparisons between a column and a constant
+  const expression::AbstractExpression *column_expr = left;
+  const expression::AbstractExpression *constant_expr = right;
+  if (left->GetExpressionType() == EXPRESSION_TYPE_VALUE_CONSTANT &&
+      right->GetExpressionType() == EXPRESSION_TYPE_VALUE_TUPLE) {
+    column_expr = right;
+    constant_expr = left;
+    comparison_type = FlipComparison(comparison_type);
+  }
+
+  if (column_expr->GetExpressionType() != EXPRESSION_TYPE_VALUE_TUPLE ||
+      constant_expr->GetExpressionType() != EXPRESSION_TYPE_VALUE_CONSTANT) {
+    return false;
+  }
+
+  auto tuple_value_expr =
+      static_cast<const expression::TupleValueExpression *>(column_expr);
+  if (tuple_value_expr->GetTupleIdx() != 0) return false;
+
+  oid_t column_id = tuple_value_expr->GetColumnId();
+  if (column_id >= column_count) return false;
+
+  auto &constant =
+      static_cast<const expression::ConstantValueExpression *>(constant_expr)
+          ->getValue();
+  if (constant.IsNull()) return false;
+
+  auto &column_range = column_ranges[column_id];
+  if (column_range.tracked == false) return false;
+
+  // the covered tuples widened both bounds before they were counted
+  int64_t min_key = column_range.min_key.load();
+  int64_t max_key = column_range.max_key.load();
+
+  // no tuple has a non-null value, so no comparison can be true
+  if (min_key > max_key) return true;
+
+  if (IsComparable(column_range.column_type, constant.GetValueType()) ==
+      false) {
+    return false;
+  }
+
+  Value min_value = GetKeyValue(min_key, column_range.column_type);
+  Value max_value = GetKeyValue(max_key, column_range.column_type);
+  int min_compare = min_value.Compare(constant);
+  int max_compare = max_value.Compare(constant);
+
+  bool skip = false;
+  switch (comparison_type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+      skip = (min_compare > 0 || max_compare < 0);
+      break;
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      skip = (min_compare >= 0);
+      break;
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      skip = (min_compare > 0);
+      break;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      skip = (max_compare <= 0);
+      break;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      skip = (max_compare < 0);
+      break;
+    default:
+      break;
+  }
+
+  LOG_TRACE("Zone map on column %u %s the predicate", column_id,
+            skip ? "excludes" : "may satisfy");
+
+  return skip;
+}
+
+bool ZoneMap::IsTracked(const oid_t &column_id) const {
+  PL_ASSERT(column_id < column_count);
+  return column_ranges[column_id].tracked;
+}
+
+Value ZoneMap::GetMinValue(const oid_t &column_id) const {
+  PL_ASSERT(column_id < column_count);
+  auto &column_range = column_ranges[column_id];
+  int64_t min_key = column_range.min_key.load();
+  if (min_key > column_range.max_key.load()) return Value();
+  return GetKeyValue(min_key, column_range.column_type);
+}
+
+Value ZoneMap::GetMaxValue(const oid_t &column_id) const {
+  PL_ASSERT(column_id < column_count);
+  auto &column_range = column_ranges[column_id];
+  int64_t max_key = column_range.max_key.load();
+  if (column_range.min_key.load() > max_key) return Value();
+  return GetKeyValue(max_key, column_range.column_type);
+}
+
+oid_t ZoneMap::GetNullCount(const oid_t &column_id) const {
+  PL_ASSERT(column_id < column_count);
+  return column_ranges[column_id].null_count;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_freezer_test.cpp
+//
+// Identification: test/brain/tile_group_freezer_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include <chrono>
+#include <thread>
+
+#include "common/harness.h"
+
+#include "brain/tile_group_freezer.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Freezer Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupFreezerTests : public PelotonTest {};
+
+TEST_F(TileGroupFreezerTests, BasicTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+
+  // The first two tile groups are full
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count * 2, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  auto &tile_group_freezer = brain::TileGroupFreezer::GetInstance();
+  tile_group_freezer.AddTable(table.get());
+  tile_group_freezer.Start();
+
+  // The max dead cid passes the tile groups as transactions finish
+  auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while ((table->GetTileGroup(0)->IsFrozen() == false ||
+          table->GetTileGroup(1)->IsFrozen() == false) &&
+         std::chrono::steady_clock::now() < timeout) {
+    txn_manager.BeginTransaction();
+    txn_manager.CommitTransaction();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  tile_group_freezer.Stop();
+  tile_group_freezer.ClearTables();
+
+  EXPECT_TRUE(table->GetTileGroup(0)->IsFrozen());
+  EXPECT_TRUE(table->GetTileGroup(1)->IsFrozen());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -16,6 +16,7 @@
 #include "common/macros.h"
 #include "catalog/manager.h"
 #include "catalog/schema.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_factory.h"
 
@@ -70,5 +71,107 @@ TEST_F(ManagerTests, TransactionTest) {
   // EXPECT_EQ(catalog::Manager::GetInstance().GetCurrentOid(), 800);
 }
 
+TEST_F(ManagerTests, RetireTileGroupTest) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  std::vector<catalog::Column> columns;
+  catalog::Column column1(VALUE_TYPE_INTEGER, GetTypeSize(VALUE_TYPE_INTEGER),
+                          "A", true);
+  columns.push_back(column1);
+
+  std::vector<catalog::Schema> schemas;
+  schemas.push_back(catalog::Schema(columns));
+
+  std::map<oid_t, std::pair<oid_t, oid_t>> column_map;
+  column_map[0] = std::make_pair(0, 0);
+
+  oid_t tile_group_id = manager.GetNextOid();
+  std::shared_ptr<storage::TileGroup> tile_group(
+      storage::TileGroupFactory::GetTileGroup(INVALID_OID, INVALID_OID,
+                                              tile_group_id, nullptr, schemas,
+                                              column_map, 3));
+  std::weak_ptr<storage::TileGroup> tile_group_ref(tile_group);
+
+  manager.AddTileGroup(tile_group_id, tile_group);
+  EXPECT_EQ(tile_group.get(), manager.GetTileGroupUnsafe(tile_group_id));
+  tile_group.reset();
+
+  // A running transaction keeps the dropped tile group alive
+  txn_manager.BeginTransaction();
+  manager.DropTileGroup(tile_group_id);
+
+  EXPECT_EQ(nullptr, manager.GetTileGroupUnsafe(tile_group_id));
+  EXPECT_EQ(nullptr, manager.GetTileGroup(tile_group_id));
+  EXPECT_FALSE(tile_group_ref.expired());
+
+  txn_manager.CommitTransaction();
+
+  // The tile group is reclaimed once the epoch has passed
+  for (int attempt = 0; attempt < 100 && !tile_group_ref.expired();
+       attempt++) {
+    txn_manager.BeginTransaction();
+    txn_manager.CommitTransaction();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+    manager.ReclaimTileGroups(txn_manager.GetMaxCommittedCid());
+  }
+
+  EXPECT_TRUE(tile_group_ref.expired());
+}
+
+void ReplaceTileGroup(const oid_t tile_group_id,
+                      std::vector<std::weak_ptr<storage::TileGroup>> *refs,
+                      uint64_t thread_id) {
+  auto &manager = catalog::Manager::GetInstance();
+
+  std::vector<catalog::Column> columns;
+  catalog::Column column1(VALUE_TYPE_INTEGER, GetTypeSize(VALUE_TYPE_INTEGER),
+                          "A", true);
+  columns.push_back(column1);
+
+  std::vector<catalog::Schema> schemas;
+  schemas.push_back(catalog::Schema(columns));
+
+  std::map<oid_t, std::pair<oid_t, oid_t>> column_map;
+  column_map[0] = std::make_pair(0, 0);
+
+  for (auto &ref : refs[thread_id]) {
+    std::shared_ptr<storage::TileGroup> tile_group(
+        storage::TileGroupFactory::GetTileGroup(INVALID_OID, INVALID_OID,
+                                                tile_group_id, nullptr,
+                                                schemas, column_map, 3));
+    ref = tile_group;
+    manager.AddTileGroup(tile_group_id, tile_group);
+  }
+}
+
+TEST_F(ManagerTests, ConcurrentReplaceTileGroupTest) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  const uint64_t thread_count = 4;
+  const size_t replace_count = 100;
+  std::vector<std::weak_ptr<storage::TileGroup>> refs[thread_count];
+  for (auto &thread_refs : refs) thread_refs.resize(replace_count);
+
+  // A running transaction keeps every replaced tile group alive, so none
+  // of them may be released by a racing replacement
+  txn_manager.BeginTransaction();
+
+  oid_t tile_group_id = manager.GetNextOid();
+  LaunchParallelTest(thread_count, ReplaceTileGroup, tile_group_id, refs);
+
+  for (auto &thread_refs : refs) {
+    for (auto &ref : thread_refs) {
+      EXPECT_FALSE(ref.expired());
+    }
+  }
+
+  txn_manager.CommitTransaction();
+
+  manager.DropTileGroup(tile_group_id);
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// pool_test.cpp
+//
+// Identification: test/common/pool_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "common/harness.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "common/pool.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Varlen Pool Tests
+//===--------------------------------------------------------------------===//
+
+class PoolTests : public PelotonTest {};
+
+const size_t allocation_count = 1000;
+
+// Fill every allocation with the thread id
+void AllocateAndFill(VarlenPool *pool, std::vector<std::vector<char *>> *blocks,
+                     uint64_t thread_itr) {
+  for (size_t allocation_itr = 0; allocation_itr < allocation_count;
+       allocation_itr++) {
+    // Mix small, region-sized and oversize allocations
+    size_t size = 1 + (allocation_itr * 7) % 100;
+    if (allocation_itr % 100 == 0) size = 64 * 1024;
+
+    char *block = reinterpret_cast<char *>(pool->Allocate(size));
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(block) % 8);
+    std::memset(block, static_cast<int>(thread_itr), size);
+    (*blocks)[thread_itr].push_back(block);
+  }
+}
+
+TEST_F(PoolTests, ConcurrentAllocateTest) {
+  const uint64_t thread_count = 4;
+  VarlenPool pool(BACKEND_TYPE_MM, 16 * 1024);
+  std::vector<std::vector<char *>> blocks(thread_count);
+
+  LaunchParallelTest(thread_count, AllocateAndFill, &pool, &blocks);
+
+  // No allocation was overwritten by another thread
+  for (uint64_t thread_itr = 0; thread_itr < thread_count; thread_itr++) {
+    EXPECT_EQ(allocation_count, blocks[thread_itr].size());
+    for (size_t allocation_itr = 0; allocation_itr < allocation_count;
+         allocation_itr++) {
+      size_t size = 1 + (allocation_itr * 7) % 100;
+      if (allocation_itr % 100 == 0) size = 64 * 1024;
+
+      char *block = blocks[thread_itr][allocation_itr];
+      for (size_t byte_itr = 0; byte_itr < size; byte_itr++) {
+        if (block[byte_itr] != static_cast<char>(thread_itr)) {
+          ADD_FAILURE() << "Allocation " << allocation_itr << " of thread "
+                        << thread_itr << " was overwritten";
+          return;
+        }
+      }
+    }
+  }
+
+  // Purge keeps only the current chunk
+  EXPECT_GT(pool.GetAllocatedMemory(), 16 * 1024);
+  pool.Purge();
+  EXPECT_EQ(16 * 1024, pool.GetAllocatedMemory());
+
+  // The pool is usable after the purge
+  char *block = reinterpret_cast<char *>(pool.Allocate(10));
+  std::memset(block, 0, 10);
+}
+
+TEST_F(PoolTests, AlternatePoolsTest) {
+  const int64_t chunk_size = 64 * 1024;
+
+  // Pools created in a row have consecutive ids, so the first and the last
+  // of five map to the same slot of a direct-mapped region cache
+  std::vector<std::unique_ptr<VarlenPool>> pools;
+  for (int pool_itr = 0; pool_itr < 5; pool_itr++) {
+    pools.emplace_back(new VarlenPool(BACKEND_TYPE_MM, chunk_size));
+  }
+  auto &first_pool = pools.front();
+  auto &last_pool = pools.back();
+
+  // Small allocations from both pools in turn keep using a region of each
+  for (size_t allocation_itr = 0; allocation_itr < allocation_count;
+       allocation_itr++) {
+    std::memset(first_pool->Allocate(16), 0, 16);
+    std::memset(last_pool->Allocate(16), 0, 16);
+  }
+
+  // 16 KB of allocations fit in the first chunk of each pool
+  EXPECT_EQ(chunk_size, first_pool->GetAllocatedMemory());
+  EXPECT_EQ(chunk_size, last_pool->GetAllocatedMemory());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// epoch_manager_test.cpp
+//
+// Identification: test/concurrency/epoch_manager_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "common/harness.h"
+
+#include "concurrency/epoch_manager.h"
+#include "concurrency/transaction_manager_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Epoch Manager Tests
+//===--------------------------------------------------------------------===//
+
+class EpochManagerTests : public PelotonTest {};
+
+// Begin and commit transactions that write
+void CommitTransactions(uint64_t thread_itr UNUSED_ATTRIBUTE) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  for (size_t txn_itr = 0; txn_itr < 100; txn_itr++) {
+    txn_manager.BeginTransaction();
+    txn_manager.GetNextCommitId();
+    txn_manager.CommitTransaction();
+  }
+}
+
+TEST_F(EpochManagerTests, MaxDeadTxnCidTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  // The max dead txn cid stays behind a running transaction
+  auto txn = txn_manager.BeginTransaction();
+  auto begin_cid = txn->GetBeginCommitId();
+  LaunchParallelTest(4, CommitTransactions);
+  EXPECT_LE(epoch_manager.RefreshMaxDeadTxnCid(), begin_cid);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_LE(epoch_manager.GetMaxDeadTxnCid(), begin_cid);
+
+  // Nested transactions on the thread keep the oldest begin cid
+  auto nested_txn = txn_manager.BeginTransaction();
+  EXPECT_GT(nested_txn->GetBeginCommitId(), begin_cid);
+  concurrency::current_txn = nested_txn;
+  txn_manager.CommitTransaction();
+  EXPECT_LE(epoch_manager.RefreshMaxDeadTxnCid(), begin_cid);
+
+  concurrency::current_txn = txn;
+  txn_manager.CommitTransaction();
+
+  // It passes the transaction once it is dead
+  txn = txn_manager.BeginTransaction();
+  auto last_begin_cid = txn->GetBeginCommitId();
+  txn_manager.CommitTransaction();
+  EXPECT_GE(epoch_manager.RefreshMaxDeadTxnCid(), last_begin_cid);
+  EXPECT_GT(epoch_manager.GetMaxDeadTxnCid(), begin_cid);
+}
+
+TEST_F(EpochManagerTests, WaitForCommitsTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  // A transaction that is installing its writes
+  std::atomic<bool> installed(false);
+  std::atomic<cid_t> commit_cid(INVALID_CID);
+  std::thread committer([&] {
+    auto txn = txn_manager.BeginTransaction();
+    epoch_manager.EnterCommit(txn->GetEpochId());
+    commit_cid = txn_manager.GetNextCommitId();
+    epoch_manager.SetCommitCid(txn->GetEpochId(), commit_cid);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    installed = true;
+    epoch_manager.ExitCommit(txn->GetEpochId());
+    txn_manager.CommitTransaction();
+  });
+  while (commit_cid == INVALID_CID) {
+    std::this_thread::yield();
+  }
+
+  // Commits after the cid are not waited for
+  epoch_manager.WaitForCommits(commit_cid - 1);
+  EXPECT_FALSE(installed);
+
+  // A snapshot read that begins after the commit id waits for the writes
+  auto txn = txn_manager.BeginTransaction(true);
+  EXPECT_GE(txn->GetBeginCommitId(), commit_cid);
+  EXPECT_TRUE(installed);
+  txn_manager.CommitTransaction();
+
+  committer.join();
+}
+
+}  // End test namespace
+}  // End peloton namespace
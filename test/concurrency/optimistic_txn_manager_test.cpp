@@ -0,0 +1,187 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_txn_manager_test.cpp
+//
+// Identification: test/concurrency/optimistic_txn_manager_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include <atomic>
+#include <thread>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/delete_executor.h"
+#include "executor/executor_context.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/delete_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+// Longest time (in us) a writer waits for the owner of a version
+extern int peloton_ownership_wait_us;
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Optimistic Transaction Manager Tests
+//===--------------------------------------------------------------------===//
+
+class OptimisticTxnManagerTests : public PelotonTest {};
+
+// Delete the tuples where column 0 is less than the value in the current
+// transaction, returns the transaction result
+Result DeleteTuples(storage::DataTable *table, int value) {
+  auto txn = concurrency::current_txn;
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  planner::DeletePlan delete_node(table, false);
+  executor::DeleteExecutor delete_executor(&delete_node, context.get());
+
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(value)));
+
+  std::vector<oid_t> column_ids({0});
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_node(
+      new planner::SeqScanPlan(table, predicate, column_ids));
+  executor::SeqScanExecutor seq_scan_executor(seq_scan_node.get(),
+                                              context.get());
+
+  delete_node.AddChild(std::move(seq_scan_node));
+  delete_executor.AddChild(&seq_scan_executor);
+
+  EXPECT_TRUE(delete_executor.Init());
+  delete_executor.Execute();
+
+  return txn->GetResult();
+}
+
+// Own the first tuple for hold_ms, then commit or abort
+void HoldFirstTuple(storage::DataTable *table, bool commit, int hold_ms,
+                    std::atomic<bool> *acquired) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  EXPECT_EQ(Result::RESULT_SUCCESS,
+            DeleteTuples(table, ExecutorTestsUtil::PopulatedValue(1, 0)));
+  *acquired = true;
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(hold_ms));
+  if (commit) {
+    EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+  } else {
+    EXPECT_EQ(Result::RESULT_ABORTED, txn_manager.AbortTransaction());
+  }
+}
+
+// Delete the first tuple while another transaction owns it
+Result DeleteOwnedTuple(storage::DataTable *table, bool commit, int hold_ms) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::atomic<bool> acquired(false);
+
+  txn_manager.BeginTransaction();
+  std::thread owner(HoldFirstTuple, table, commit, hold_ms, &acquired);
+  while (acquired == false) {
+    std::this_thread::yield();
+  }
+
+  auto result = DeleteTuples(table, ExecutorTestsUtil::PopulatedValue(1, 0));
+  if (result == Result::RESULT_SUCCESS) {
+    result = txn_manager.CommitTransaction();
+  } else {
+    txn_manager.AbortTransaction();
+  }
+
+  owner.join();
+  return result;
+}
+
+TEST_F(OptimisticTxnManagerTests, WriteConflictTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  const size_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  // The owner gives up the version, so the waiting writer gets it
+  EXPECT_EQ(Result::RESULT_SUCCESS, DeleteOwnedTuple(table.get(), false, 1));
+
+  // The owner commits first, so the waiting writer fails
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), 1, false, false, false);
+  txn_manager.CommitTransaction();
+  EXPECT_NE(Result::RESULT_SUCCESS, DeleteOwnedTuple(table.get(), true, 1));
+
+  // The wait is bounded
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), 1, false, false, false);
+  txn_manager.CommitTransaction();
+  EXPECT_NE(Result::RESULT_SUCCESS, DeleteOwnedTuple(table.get(), false, 200));
+
+  concurrency::TransactionManagerFactory::Configure(CONCURRENCY_TYPE_TO);
+}
+
+TEST_F(OptimisticTxnManagerTests, ConfigureTest) {
+  auto &to_txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto commit_id = to_txn_manager.GetNextCommitId();
+
+  // Commit ids keep increasing across managers
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  EXPECT_EQ(&concurrency::OptimisticTxnManager::GetInstance(), &txn_manager);
+  EXPECT_GT(txn_manager.GetCurrentCommitId(), commit_id);
+
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_GE(txn->GetBeginCommitId(), commit_id);
+  txn_manager.CommitTransaction();
+  commit_id = txn_manager.GetNextCommitId();
+
+  concurrency::TransactionManagerFactory::Configure(CONCURRENCY_TYPE_TO);
+  EXPECT_GT(to_txn_manager.GetCurrentCommitId(), commit_id);
+}
+
+TEST_F(OptimisticTxnManagerTests, OwnershipWaitTest) {
+  auto &optimistic_txn_manager =
+      concurrency::OptimisticTxnManager::GetInstance();
+  auto &to_txn_manager = concurrency::TsOrderTxnManager::GetInstance();
+
+  // Each protocol has its own default
+  EXPECT_EQ(-1, peloton_ownership_wait_us);
+  EXPECT_EQ(10000, optimistic_txn_manager.GetOwnershipWait());
+  EXPECT_EQ(0, to_txn_manager.GetOwnershipWait());
+
+  // A configured wait applies to both
+  peloton_ownership_wait_us = 500;
+  EXPECT_EQ(500, optimistic_txn_manager.GetOwnershipWait());
+  EXPECT_EQ(500, to_txn_manager.GetOwnershipWait());
+
+  peloton_ownership_wait_us = 0;
+  EXPECT_EQ(0, optimistic_txn_manager.GetOwnershipWait());
+  EXPECT_EQ(0, to_txn_manager.GetOwnershipWait());
+
+  peloton_ownership_wait_us = -1;
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set_test.cpp
+//
+// Identification: test/concurrency/read_write_set_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "common/harness.h"
+
+#include "concurrency/read_write_set.h"
+#include "concurrency/transaction.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Read Write Set Tests
+//===--------------------------------------------------------------------===//
+
+class ReadWriteSetTests : public PelotonTest {};
+
+TEST_F(ReadWriteSetTests, FindInsertTest) {
+  const oid_t tile_group_count = 10;
+  const oid_t tuple_count = 100;
+  concurrency::ReadWriteSet rw_set;
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+         tile_group_itr++) {
+      ItemPointer location(tile_group_itr, tuple_itr);
+      EXPECT_EQ(nullptr, rw_set.Find(location));
+      rw_set.Insert(location, concurrency::RW_TYPE_READ);
+    }
+  }
+  EXPECT_EQ(tile_group_count * tuple_count, rw_set.GetSize());
+
+  // Entries are kept in access order
+  oid_t entry_itr = 0;
+  for (auto &entry : rw_set) {
+    EXPECT_EQ(entry_itr % tile_group_count, entry.location.block);
+    EXPECT_EQ(entry_itr / tile_group_count, entry.location.offset);
+    EXPECT_EQ(concurrency::RW_TYPE_READ, entry.type);
+    entry_itr++;
+  }
+
+  auto type = rw_set.Find(ItemPointer(3, 42));
+  EXPECT_NE(nullptr, type);
+  *type = concurrency::RW_TYPE_UPDATE;
+  EXPECT_EQ(concurrency::RW_TYPE_UPDATE, *rw_set.Find(ItemPointer(3, 42)));
+
+  rw_set.Clear();
+  EXPECT_TRUE(rw_set.IsEmpty());
+  for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+       tile_group_itr++) {
+    EXPECT_EQ(nullptr, rw_set.Find(ItemPointer(tile_group_itr, 0)));
+  }
+
+  // A few entries in a large set
+  rw_set.Insert(ItemPointer(1, 1), concurrency::RW_TYPE_INSERT);
+  rw_set.Insert(ItemPointer(2, 2), concurrency::RW_TYPE_DELETE);
+  rw_set.Clear();
+  EXPECT_EQ(nullptr, rw_set.Find(ItemPointer(1, 1)));
+  EXPECT_EQ(nullptr, rw_set.Find(ItemPointer(2, 2)));
+}
+
+TEST_F(ReadWriteSetTests, TransactionTest) {
+  ItemPointer read_location(1, 1);
+  ItemPointer insert_location(1, 2);
+
+  {
+    concurrency::Transaction txn(1, 1);
+    txn.RecordRead(read_location);
+    txn.RecordRead(read_location);
+    txn.RecordInsert(insert_location);
+    EXPECT_FALSE(txn.IsReadOnly());
+    EXPECT_EQ(2U, txn.GetRWSet().GetSize());
+
+    txn.RecordUpdate(read_location);
+    EXPECT_TRUE(txn.RecordDelete(insert_location));
+    EXPECT_FALSE(txn.IsReadOnly());
+  }
+
+  // The next transaction on this thread gets a cleared set
+  concurrency::Transaction txn(2, 2);
+  EXPECT_TRUE(txn.GetRWSet().IsEmpty());
+  EXPECT_TRUE(txn.IsReadOnly());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,270 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// scan_validation_test.cpp
+//
+// Identification: test/concurrency/scan_validation_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/delete_executor.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/delete_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Scan Validation Tests
+//===--------------------------------------------------------------------===//
+
+class ScanValidationTests : public PelotonTest {};
+
+// Scan the table in the given transaction, returns the tuple count
+size_t ScanTable(storage::DataTable *table, concurrency::Transaction *txn) {
+  std::vector<oid_t> column_ids({0});
+  planner::SeqScanPlan node(table, nullptr, column_ids);
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  size_t result_tuple_count = 0;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    result_tuple_count += result_tile->GetTupleCount();
+  }
+
+  return result_tuple_count;
+}
+
+// Delete the tuples where column 0 is less than the value
+void DeleteLessThan(storage::DataTable *table, int value,
+                    UNUSED_ATTRIBUTE uint64_t thread_itr) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  planner::DeletePlan delete_node(table, false);
+  executor::DeleteExecutor delete_executor(&delete_node, context.get());
+
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(value)));
+
+  std::vector<oid_t> column_ids({0});
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_node(
+      new planner::SeqScanPlan(table, predicate, column_ids));
+  executor::SeqScanExecutor seq_scan_executor(seq_scan_node.get(),
+                                              context.get());
+
+  delete_node.AddChild(std::move(seq_scan_node));
+  delete_executor.AddChild(&seq_scan_executor);
+
+  EXPECT_TRUE(delete_executor.Init());
+  EXPECT_TRUE(delete_executor.Execute());
+
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+}
+
+TEST_F(ScanValidationTests, ScanSetTest) {
+  const size_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count * 3, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  // A full scan records one range per tile group
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(tuple_count * 3, ScanTable(table.get(), txn));
+  EXPECT_TRUE(txn->GetRWSet().IsEmpty());
+  EXPECT_EQ(3U, txn->GetRWSet().GetScans().size());
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+
+  // Scanning again extends the same ranges
+  txn = txn_manager.BeginTransaction();
+  ScanTable(table.get(), txn);
+  ScanTable(table.get(), txn);
+  EXPECT_EQ(3U, txn->GetRWSet().GetScans().size());
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+}
+
+TEST_F(ScanValidationTests, ConflictTest) {
+  const size_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count * 2, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  // A read-only scan stays valid after a concurrent delete
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(tuple_count * 2, ScanTable(table.get(), txn));
+  LaunchParallelTest(1, DeleteLessThan, table.get(),
+                     ExecutorTestsUtil::PopulatedValue(1, 0));
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+
+  // An update transaction does not commit after a version it scanned
+  // was deleted
+  txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(tuple_count * 2 - 1, ScanTable(table.get(), txn));
+  LaunchParallelTest(1, DeleteLessThan, table.get(),
+                     ExecutorTestsUtil::PopulatedValue(2, 0));
+  ExecutorTestsUtil::PopulateTable(table.get(), 1, false, false, false);
+  EXPECT_EQ(Result::RESULT_ABORTED, txn_manager.CommitTransaction());
+
+  // Writes to other tile groups do not affect the scan
+  std::vector<oid_t> column_ids({0});
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(
+              ExecutorTestsUtil::PopulatedValue(tuple_count, 0))));
+  planner::SeqScanPlan node(table.get(), predicate, column_ids);
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+  size_t result_tuple_count = 0;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    result_tuple_count += result_tile->GetTupleCount();
+  }
+  EXPECT_EQ(tuple_count, result_tuple_count);
+
+  LaunchParallelTest(1, DeleteLessThan, table.get(),
+                     ExecutorTestsUtil::PopulatedValue(3, 0));
+  ExecutorTestsUtil::PopulateTable(table.get(), 1, false, false, false);
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+}
+
+TEST_F(ScanValidationTests, OwnedTileGroupTest) {
+  const size_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  // A writer deletes a tuple of the tile group
+  auto writer_txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(writer_txn));
+  planner::DeletePlan delete_node(table.get(), false);
+  executor::DeleteExecutor delete_executor(&delete_node, context.get());
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(
+              ExecutorTestsUtil::PopulatedValue(1, 0))));
+  std::vector<oid_t> column_ids({0});
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_node(
+      new planner::SeqScanPlan(table.get(), predicate, column_ids));
+  executor::SeqScanExecutor seq_scan_executor(seq_scan_node.get(),
+                                              context.get());
+  delete_node.AddChild(std::move(seq_scan_node));
+  delete_executor.AddChild(&seq_scan_executor);
+  EXPECT_TRUE(delete_executor.Init());
+  EXPECT_TRUE(delete_executor.Execute());
+  txn_manager.GetNextCommitId();
+  txn_manager.GetNextCommitId();
+
+  // A scan checks visibility while the writer owns the tuple
+  auto txn = txn_manager.BeginTransaction();
+  auto tile_group = table->GetTileGroup(0);
+  auto tile_group_header = tile_group->GetHeader();
+  bool owned = (tile_group_header->GetOwnerCount() > 0);
+  EXPECT_TRUE(owned);
+  std::vector<oid_t> visible_tuple_ids;
+  txn_manager.IsVisibleBatch(tile_group_header, 0,
+                             tile_group->GetNextTupleSlot(),
+                             visible_tuple_ids);
+  EXPECT_EQ(tuple_count, visible_tuple_ids.size());
+
+  // The writer took a commit id before the scan began and commits before
+  // the scan records its reads
+  auto next_cid = txn_manager.GetCurrentCommitId();
+  txn_manager.SetNextCid(txn->GetBeginCommitId() - 1);
+  concurrency::current_txn = writer_txn;
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+  txn_manager.SetNextCid(next_cid);
+  EXPECT_EQ(0U, tile_group_header->GetOwnerCount());
+  EXPECT_LE(tile_group_header->GetLastEndCommitId(), txn->GetBeginCommitId());
+
+  // The tuples are read one by one, and the deleted one fails validation
+  concurrency::current_txn = txn;
+  EXPECT_TRUE(txn_manager.PerformScan(tile_group->GetTileGroupId(),
+                                      visible_tuple_ids, owned));
+  EXPECT_TRUE(txn->GetRWSet().GetScans().empty());
+  EXPECT_EQ(Result::RESULT_ABORTED, txn_manager.CommitTransaction());
+}
+
+TEST_F(ScanValidationTests, SnapshotReadTest) {
+  const size_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count * 2, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  // A snapshot read sees the commits before it, records nothing and is not
+  // validated
+  auto txn = txn_manager.BeginTransaction(true);
+  EXPECT_TRUE(txn->IsSnapshotRead());
+  EXPECT_EQ(txn_manager.GetLastCommitId(), txn->GetBeginCommitId());
+  EXPECT_EQ(tuple_count * 2, ScanTable(table.get(), txn));
+  EXPECT_TRUE(txn->GetRWSet().IsEmpty());
+  EXPECT_TRUE(txn->GetRWSet().GetScans().empty());
+
+  LaunchParallelTest(1, DeleteLessThan, table.get(),
+                     ExecutorTestsUtil::PopulatedValue(tuple_count, 0));
+  EXPECT_EQ(tuple_count * 2, ScanTable(table.get(), txn));
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+
+  // It may not write
+  txn = txn_manager.BeginTransaction(true);
+  auto tile_group = table->GetTileGroup(1);
+  EXPECT_FALSE(txn_manager.AcquireOwnership(tile_group->GetHeader(),
+                                            tile_group->GetTileGroupId(), 0));
+  EXPECT_EQ(Result::RESULT_FAILURE, txn_manager.CommitTransaction());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,467 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// ts_order_txn_manager_test.cpp
+//
+// Identification: test/concurrency/ts_order_txn_manager_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include <atomic>
+#include <thread>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "concurrency/backoff.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/delete_executor.h"
+#include "executor/executor_context.h"
+#include "executor/hybrid_scan_executor.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "executor/update_executor.h"
+#include "expression/expression_util.h"
+#include "logging/checkpoint_tile_scanner.h"
+#include "planner/delete_plan.h"
+#include "planner/hybrid_scan_plan.h"
+#include "planner/project_info.h"
+#include "planner/seq_scan_plan.h"
+#include "planner/update_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+extern int peloton_ownership_wait_us;
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Timestamp Ordering Transaction Manager Tests
+//===--------------------------------------------------------------------===//
+
+class TsOrderTxnManagerTests : public PelotonTest {};
+
+// Delete the first tuple in the current transaction, returns the
+// transaction result
+Result DeleteFirstTuple(storage::DataTable *table) {
+  auto txn = concurrency::current_txn;
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  planner::DeletePlan delete_node(table, false);
+  executor::DeleteExecutor delete_executor(&delete_node, context.get());
+
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(
+              ExecutorTestsUtil::PopulatedValue(1, 0))));
+
+  std::vector<oid_t> column_ids({0});
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_node(
+      new planner::SeqScanPlan(table, predicate, column_ids));
+  executor::SeqScanExecutor seq_scan_executor(seq_scan_node.get(),
+                                              context.get());
+
+  delete_node.AddChild(std::move(seq_scan_node));
+  delete_executor.AddChild(&seq_scan_executor);
+
+  EXPECT_TRUE(delete_executor.Init());
+  delete_executor.Execute();
+
+  return txn->GetResult();
+}
+
+// Delete the first tuple in a transaction of a new thread, which is younger
+// than the transactions of the test thread. Holds the tuple for hold_ms
+// before aborting.
+void DeleteOnNewThread(storage::DataTable *table, int hold_ms,
+                       std::atomic<bool> *done, Result *result) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  *result = DeleteFirstTuple(table);
+  *done = true;
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(hold_ms));
+  txn_manager.AbortTransaction();
+}
+
+// Predicate of the first tuple
+expression::AbstractExpression *FirstTuplePredicate() {
+  return expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(
+              ExecutorTestsUtil::PopulatedValue(1, 0))));
+}
+
+// Read column 2 of the first tuple in the current transaction
+Value ReadFirstTuple(storage::DataTable *table) {
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(concurrency::current_txn));
+
+  std::vector<oid_t> column_ids({2});
+  planner::SeqScanPlan node(table, FirstTuplePredicate(), column_ids);
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  Value value;
+  size_t result_tuple_count = 0;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      value = result_tile->GetValue(tuple_id, 0);
+      result_tuple_count++;
+    }
+  }
+  EXPECT_EQ(1U, result_tuple_count);
+
+  return value;
+}
+
+// Read column 2 of the first tuple in the current transaction with a hybrid
+// scan. The index scan looks the tuple up in the primary key index.
+Value ReadFirstTupleByHybridScan(storage::DataTable *table,
+                                 HybridScanType hybrid_scan_type) {
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(concurrency::current_txn));
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc;
+  if (hybrid_scan_type == HYBRID_SCAN_TYPE_INDEX) {
+    std::vector<oid_t> key_column_ids({0});
+    std::vector<ExpressionType> expr_types({EXPRESSION_TYPE_COMPARE_EQUAL});
+    std::vector<Value> values({ValueFactory::GetIntegerValue(
+        ExecutorTestsUtil::PopulatedValue(0, 0))});
+    std::vector<expression::AbstractExpression *> runtime_keys;
+    index_scan_desc = planner::IndexScanPlan::IndexScanDesc(
+        table->GetIndex(0), key_column_ids, expr_types, values, runtime_keys);
+  }
+
+  std::vector<oid_t> column_ids({2});
+  planner::HybridScanPlan node(table, FirstTuplePredicate(), column_ids,
+                               index_scan_desc, hybrid_scan_type);
+  executor::HybridScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  Value value;
+  size_t result_tuple_count = 0;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      value = result_tile->GetValue(tuple_id, 0);
+      result_tuple_count++;
+    }
+  }
+  EXPECT_EQ(1U, result_tuple_count);
+
+  return value;
+}
+
+// Set column 2 of the first tuple in a transaction of a new thread
+void UpdateOnNewThread(storage::DataTable *table, double value, bool commit,
+                       Result *result) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  TargetList target_list;
+  DirectMapList direct_map_list;
+  target_list.emplace_back(2, expression::ExpressionUtil::ConstantValueFactory(
+                                  ValueFactory::GetDoubleValue(value)));
+  direct_map_list.emplace_back(0, std::pair<oid_t, oid_t>(0, 0));
+  direct_map_list.emplace_back(1, std::pair<oid_t, oid_t>(0, 1));
+  direct_map_list.emplace_back(3, std::pair<oid_t, oid_t>(0, 3));
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(std::move(target_list),
+                               std::move(direct_map_list)));
+  planner::UpdatePlan update_node(table, std::move(project_info));
+  executor::UpdateExecutor update_executor(&update_node, context.get());
+
+  std::vector<oid_t> column_ids({0});
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_node(
+      new planner::SeqScanPlan(table, FirstTuplePredicate(), column_ids));
+  executor::SeqScanExecutor seq_scan_executor(seq_scan_node.get(),
+                                              context.get());
+
+  update_node.AddChild(std::move(seq_scan_node));
+  update_executor.AddChild(&seq_scan_executor);
+
+  EXPECT_TRUE(update_executor.Init());
+  while (update_executor.Execute())
+    ;
+
+  if (commit) {
+    *result = txn_manager.CommitTransaction();
+  } else {
+    *result = txn_manager.AbortTransaction();
+  }
+}
+
+TEST_F(TsOrderTxnManagerTests, InplaceUpdateTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  const size_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  // An older transaction still reads the before-image, but does not commit
+  txn_manager.BeginTransaction();
+  auto old_value = ReadFirstTuple(table.get());
+
+  Result result = Result::RESULT_INVALID;
+  std::thread writer(UpdateOnNewThread, table.get(), 23.5, true, &result);
+  writer.join();
+  EXPECT_EQ(Result::RESULT_SUCCESS, result);
+
+  EXPECT_EQ(0, old_value.Compare(ReadFirstTuple(table.get())));
+  EXPECT_EQ(Result::RESULT_ABORTED, txn_manager.CommitTransaction());
+
+  // The tuple was updated without a new version
+  txn_manager.BeginTransaction();
+  EXPECT_EQ(0, ValueFactory::GetDoubleValue(23.5)
+                   .Compare(ReadFirstTuple(table.get())));
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+  EXPECT_EQ(tuple_count, table->GetTileGroup(0)->GetNextTupleSlot());
+
+  // An abort restores the before-image
+  std::thread aborted_writer(UpdateOnNewThread, table.get(), 42.5, false,
+                             &result);
+  aborted_writer.join();
+  EXPECT_EQ(Result::RESULT_ABORTED, result);
+
+  txn_manager.BeginTransaction();
+  EXPECT_EQ(0, ValueFactory::GetDoubleValue(23.5)
+                   .Compare(ReadFirstTuple(table.get())));
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+}
+
+TEST_F(TsOrderTxnManagerTests, InplaceUpdateSnapshotReadTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  const size_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  // A snapshot read outputs copies of the tuples, which a later update in
+  // place does not overwrite
+  auto txn = txn_manager.BeginTransaction(true);
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  std::vector<oid_t> column_ids({2});
+  planner::SeqScanPlan node(table.get(), FirstTuplePredicate(), column_ids);
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<std::unique_ptr<executor::LogicalTile>> result_tiles;
+  while (executor.Execute()) {
+    result_tiles.emplace_back(executor.GetOutput());
+  }
+
+  Result result = Result::RESULT_INVALID;
+  std::thread writer(UpdateOnNewThread, table.get(), 23.5, true, &result);
+  writer.join();
+  EXPECT_EQ(Result::RESULT_SUCCESS, result);
+
+  auto old_value =
+      ValueFactory::GetDoubleValue(ExecutorTestsUtil::PopulatedValue(0, 2));
+  size_t result_tuple_count = 0;
+  for (auto &result_tile : result_tiles) {
+    for (oid_t tuple_id : *result_tile) {
+      EXPECT_EQ(0, old_value.Compare(result_tile->GetValue(tuple_id, 0)));
+      result_tuple_count++;
+    }
+  }
+  EXPECT_EQ(1U, result_tuple_count);
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+}
+
+TEST_F(TsOrderTxnManagerTests, InplaceUpdateHybridScanTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  const size_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, true));
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  // An older transaction reads the before-image with both scan types
+  txn_manager.BeginTransaction();
+  auto old_value =
+      ReadFirstTupleByHybridScan(table.get(), HYBRID_SCAN_TYPE_SEQUENTIAL);
+
+  Result result = Result::RESULT_INVALID;
+  std::thread writer(UpdateOnNewThread, table.get(), 23.5, true, &result);
+  writer.join();
+  EXPECT_EQ(Result::RESULT_SUCCESS, result);
+
+  EXPECT_EQ(0, old_value.Compare(ReadFirstTupleByHybridScan(
+                   table.get(), HYBRID_SCAN_TYPE_SEQUENTIAL)));
+  EXPECT_EQ(0, old_value.Compare(ReadFirstTupleByHybridScan(
+                   table.get(), HYBRID_SCAN_TYPE_INDEX)));
+  EXPECT_EQ(Result::RESULT_ABORTED, txn_manager.CommitTransaction());
+
+  // A new transaction reads the tuple updated in place
+  txn_manager.BeginTransaction();
+  EXPECT_EQ(0, ValueFactory::GetDoubleValue(23.5)
+                   .Compare(ReadFirstTupleByHybridScan(
+                       table.get(), HYBRID_SCAN_TYPE_SEQUENTIAL)));
+  EXPECT_EQ(0, ValueFactory::GetDoubleValue(23.5)
+                   .Compare(ReadFirstTupleByHybridScan(
+                       table.get(), HYBRID_SCAN_TYPE_INDEX)));
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+}
+
+TEST_F(TsOrderTxnManagerTests, InplaceUpdateCheckpointTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  const size_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  // The open transaction keeps the before-image from being reclaimed, as the
+  // epoch of a checkpoint does
+  auto txn = txn_manager.BeginTransaction();
+  cid_t start_cid = txn->GetBeginCommitId();
+
+  Result result = Result::RESULT_INVALID;
+  std::thread writer(UpdateOnNewThread, table.get(), 23.5, true, &result);
+  writer.join();
+  EXPECT_EQ(Result::RESULT_SUCCESS, result);
+
+  // A checkpoint as of start_cid still includes the tuple updated in place
+  logging::CheckpointTileScanner scanner;
+  std::vector<oid_t> column_ids({2});
+  auto logical_tile =
+      scanner.Scan(table->GetTileGroup(0), column_ids, start_cid);
+  EXPECT_EQ(tuple_count, logical_tile->GetTupleCount());
+  EXPECT_EQ(0, ValueFactory::GetDoubleValue(
+                   ExecutorTestsUtil::PopulatedValue(0, 2))
+                   .Compare(logical_tile->GetValue(0, 0)));
+
+  // A checkpoint as of now includes the new value
+  auto new_logical_tile = scanner.Scan(table->GetTileGroup(0), column_ids,
+                                       txn_manager.GetLastCommitId());
+  EXPECT_EQ(tuple_count, new_logical_tile->GetTupleCount());
+  EXPECT_EQ(0, ValueFactory::GetDoubleValue(23.5)
+                   .Compare(new_logical_tile->GetValue(0, 0)));
+
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+}
+
+TEST_F(TsOrderTxnManagerTests, WaitDieTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  const size_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  peloton_ownership_wait_us = 1000 * 1000;
+
+  // An older transaction waits for the younger owner to abort
+  std::atomic<bool> done(false);
+  Result owner_result = Result::RESULT_INVALID;
+  txn_manager.BeginTransaction();
+  std::thread owner(DeleteOnNewThread, table.get(), 10, &done, &owner_result);
+  while (done == false) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(Result::RESULT_SUCCESS, owner_result);
+  EXPECT_EQ(Result::RESULT_SUCCESS, DeleteFirstTuple(table.get()));
+  owner.join();
+  EXPECT_EQ(1U, table->GetOwnershipWaitCount());
+
+  // A younger transaction dies instead of waiting for the older owner
+  done = false;
+  std::thread waiter(DeleteOnNewThread, table.get(), 0, &done, &owner_result);
+  waiter.join();
+  EXPECT_EQ(Result::RESULT_FAILURE, owner_result);
+  EXPECT_EQ(1U, table->GetConflictCount());
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+
+  // Without waits the owned version is not ownable
+  peloton_ownership_wait_us = 0;
+  table->ResetContentionStats();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), 1, false, false, false);
+  txn_manager.CommitTransaction();
+
+  txn_manager.BeginTransaction();
+  done = false;
+  std::thread second_owner(DeleteOnNewThread, table.get(), 10, &done,
+                           &owner_result);
+  while (done == false) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(Result::RESULT_FAILURE, DeleteFirstTuple(table.get()));
+  txn_manager.AbortTransaction();
+  second_owner.join();
+  EXPECT_EQ(1U, table->GetConflictCount());
+  EXPECT_EQ(0U, table->GetOwnershipWaitCount());
+}
+
+TEST_F(TsOrderTxnManagerTests, TransactionReuseTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  const size_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false);
+  EXPECT_FALSE(txn->IsReadOnly());
+  txn->SetResult(Result::RESULT_FAILURE);
+  txn_manager.AbortTransaction();
+
+  // The next transaction on the thread reuses the object, reset
+  auto next_txn = txn_manager.BeginTransaction(true);
+  EXPECT_EQ(txn, next_txn);
+  EXPECT_TRUE(next_txn->IsReadOnly());
+  EXPECT_TRUE(next_txn->IsSnapshotRead());
+  EXPECT_TRUE(next_txn->GetRWSet().IsEmpty());
+  EXPECT_EQ(Result::RESULT_SUCCESS, next_txn->GetResult());
+  EXPECT_EQ(MAX_CID, next_txn->GetEndCommitId());
+  EXPECT_EQ(Result::RESULT_SUCCESS, txn_manager.CommitTransaction());
+}
+
+TEST_F(TsOrderTxnManagerTests, BackoffTest) {
+  concurrency::Backoff backoff(1, 8);
+
+  for (size_t wait_itr = 0; wait_itr < 8; wait_itr++) {
+    backoff.Wait();
+  }
+  EXPECT_EQ(8U, backoff.GetWaitCount());
+
+  backoff.Reset();
+  EXPECT_EQ(0U, backoff.GetWaitCount());
+}
+
+}  // End test namespace
+}  // End peloton namespace
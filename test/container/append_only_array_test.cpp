@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// append_only_array_test.cpp
+//
+// Identification: test/container/append_only_array_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "container/append_only_array.h"
+
+#include "common/harness.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// AppendOnlyArray Test
+//===--------------------------------------------------------------------===//
+
+class AppendOnlyArrayTest : public PelotonTest {};
+
+// Test basic functionality
+TEST_F(AppendOnlyArrayTest, BasicTest) {
+
+  typedef oid_t value_type;
+
+  {
+    AppendOnlyArray<value_type> array;
+    EXPECT_TRUE(array.IsEmpty());
+
+    // Cross a chunk boundary
+    size_t const element_count = APPEND_ONLY_ARRAY_CHUNK_SIZE + 3;
+    for (size_t element = 0; element < element_count; ++element ) {
+      auto status = array.Append(element);
+      EXPECT_TRUE(status);
+    }
+
+    auto array_size = array.GetSize();
+    EXPECT_EQ(array_size, element_count);
+
+    for (size_t element = 0; element < element_count; ++element ) {
+      EXPECT_EQ(array.Find(element), element);
+    }
+
+    EXPECT_TRUE(array.Contains(APPEND_ONLY_ARRAY_CHUNK_SIZE));
+    EXPECT_FALSE(array.Contains(element_count));
+
+    array.Clear();
+    EXPECT_TRUE(array.IsEmpty());
+  }
+
+}
+
+void AppendOnlyArrayAppend(AppendOnlyArray<oid_t> *array, size_t scale_factor,
+                           uint64_t thread_itr) {
+  for (size_t element = 0; element < scale_factor; ++element) {
+    array->Append(thread_itr * scale_factor + element);
+
+    // Everything published so far must be readable
+    auto array_size = array->GetSize();
+    EXPECT_NE(array->Find(array_size - 1), INVALID_OID);
+  }
+}
+
+// Test concurrent appends
+TEST_F(AppendOnlyArrayTest, MultiThreadedTest) {
+
+  AppendOnlyArray<oid_t> array;
+
+  size_t num_threads = 4;
+  size_t scale_factor = APPEND_ONLY_ARRAY_CHUNK_SIZE;
+
+  LaunchParallelTest(num_threads, AppendOnlyArrayAppend, &array, scale_factor);
+
+  auto array_size = array.GetSize();
+  EXPECT_EQ(array_size, num_threads * scale_factor);
+
+  // Every value shows up exactly once
+  std::vector<bool> seen(num_threads * scale_factor, false);
+  for (size_t element = 0; element < array_size; ++element) {
+    auto value = array.Find(element);
+    EXPECT_FALSE(seen[value]);
+    seen[value] = true;
+  }
+
+}
+
+}  // End test namespace
+}  // End peloton namespace
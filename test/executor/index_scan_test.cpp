@@ -173,6 +173,71 @@ TEST_F(IndexScanTests, MultiColumnPredicateTest) {
   txn_manager.CommitTransaction();
 }
 
+// Index scan of table with an IN-list of keys.
+TEST_F(IndexScanTests, InListTest) {
+  // First, generate the table with index
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // Column ids to be added to logical tile after scan.
+  std::vector<oid_t> column_ids({0, 1, 3});
+
+  //===--------------------------------------------------------------------===//
+  // ATTR 0 IN (120, 10, 70, 1000)
+  //===--------------------------------------------------------------------===//
+
+  auto index = data_table->GetIndex(0);
+  std::vector<oid_t> key_column_ids;
+  std::vector<ExpressionType> expr_types;
+  std::vector<Value> values;
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  key_column_ids.push_back(0);
+
+  // Create index scan desc
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, expr_types, values, runtime_keys);
+  index_scan_desc.key_values_list = {{ValueFactory::GetIntegerValue(120)},
+                                     {ValueFactory::GetIntegerValue(10)},
+                                     {ValueFactory::GetIntegerValue(70)},
+                                     {ValueFactory::GetIntegerValue(1000)}};
+
+  expression::AbstractExpression *predicate = nullptr;
+
+  // Create plan node.
+  planner::IndexScanPlan node(data_table.get(), predicate, column_ids,
+                              index_scan_desc);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  // Run the executor
+  executor::IndexScanExecutor executor(&node, context.get());
+  int expected_num_tiles = 3;
+
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<std::unique_ptr<executor::LogicalTile>> result_tiles;
+
+  for (int i = 0; i < expected_num_tiles; i++) {
+    EXPECT_TRUE(executor.Execute());
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    EXPECT_THAT(result_tile, NotNull());
+    result_tiles.emplace_back(result_tile.release());
+  }
+
+  EXPECT_FALSE(executor.Execute());
+  EXPECT_EQ(result_tiles.size(), expected_num_tiles);
+  for (auto &result_tile : result_tiles) {
+    EXPECT_EQ(result_tile.get()->GetTupleCount(), 1);
+  }
+
+  txn_manager.CommitTransaction();
+}
+
 void ShowTable(std::string database_name, std::string table_name) {
   auto table = catalog::Bootstrapper::global_catalog->GetTableFromDatabase(
       database_name, table_name);
@@ -34,6 +34,7 @@
 #include "planner/seq_scan_plan.h"
 #include "storage/data_table.h"
 #include "storage/tile_group_factory.h"
+#include "storage/tile_group_header.h"
 
 #include "executor/executor_tests_util.h"
 #include "executor/mock_executor.h"
@@ -314,6 +315,110 @@ TEST_F(SeqScanTests, NonLeafNodePredicateTest) {
 
   txn_manager.CommitTransaction();
 }
+
+// Batch visibility check must agree with the per-tuple check.
+TEST_F(SeqScanTests, VisibilityBatchTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // committed tuples
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  // tuples inserted by the running transaction
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false);
+
+  int visible_tuple_count = 0;
+  for (oid_t tile_group_itr = 0; tile_group_itr < table->GetTileGroupCount();
+       tile_group_itr++) {
+    auto tile_group = table->GetTileGroup(tile_group_itr);
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+    std::vector<oid_t> expected_tuple_ids;
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (txn_manager.IsVisible(tile_group_header, tuple_id)) {
+        expected_tuple_ids.push_back(tuple_id);
+      }
+    }
+
+    std::vector<oid_t> visible_tuple_ids;
+    txn_manager.IsVisibleBatch(tile_group_header, 0, active_tuple_count,
+                               visible_tuple_ids);
+
+    EXPECT_EQ(expected_tuple_ids, visible_tuple_ids);
+    visible_tuple_count += visible_tuple_ids.size();
+  }
+
+  EXPECT_EQ(2 * tuple_count, visible_tuple_count);
+
+  txn_manager.CommitTransaction();
+}
+
+// The column header layout takes its own path through the batch check.
+TEST_F(SeqScanTests, VisibilityBatchColumnLayoutTest) {
+  const oid_t tuple_count = 64;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  std::vector<LayoutType> header_layouts = {LAYOUT_TYPE_ROW,
+                                            LAYOUT_TYPE_COLUMN};
+  std::vector<std::vector<oid_t>> layout_tuple_ids;
+
+  for (auto header_layout : header_layouts) {
+    storage::TileGroupHeader header(BACKEND_TYPE_MM, tuple_count,
+                                    header_layout);
+
+    auto txn = txn_manager.BeginTransaction();
+
+    // committed, deleted, own inserted, foreign inserted and empty slots
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      switch (tuple_id % 5) {
+        case 0:
+          header.SetTransactionId(tuple_id, INITIAL_TXN_ID);
+          header.SetBeginCommitId(tuple_id, START_CID);
+          break;
+        case 1:
+          header.SetTransactionId(tuple_id, INITIAL_TXN_ID);
+          header.SetBeginCommitId(tuple_id, START_CID);
+          header.SetEndCommitId(tuple_id, START_CID);
+          break;
+        case 2:
+          header.SetTransactionId(tuple_id, txn->GetTransactionId());
+          break;
+        case 3:
+          header.SetTransactionId(tuple_id, txn->GetTransactionId() + 1);
+          break;
+        default:
+          break;
+      }
+    }
+
+    std::vector<oid_t> expected_tuple_ids;
+    for (oid_t tuple_id = 1; tuple_id < tuple_count; tuple_id++) {
+      if (txn_manager.IsVisible(&header, tuple_id)) {
+        expected_tuple_ids.push_back(tuple_id);
+      }
+    }
+
+    std::vector<oid_t> visible_tuple_ids;
+    txn_manager.IsVisibleBatch(&header, 1, tuple_count, visible_tuple_ids);
+
+    txn_manager.CommitTransaction();
+
+    EXPECT_EQ(expected_tuple_ids, visible_tuple_ids);
+    layout_tuple_ids.push_back(visible_tuple_ids);
+  }
+
+  EXPECT_EQ(layout_tuple_ids[0], layout_tuple_ids[1]);
+  EXPECT_FALSE(layout_tuple_ids[0].empty());
+}
 }
 
 }  // namespace test
@@ -17,6 +17,7 @@
 #include "common/logger.h"
 #include "common/platform.h"
 #include "index/index_factory.h"
+#include "index/index_key.h"
 #include "storage/tuple.h"
 
 namespace peloton {
@@ -815,6 +816,313 @@ TEST_F(IndexTests, NonUniqueKeyMultiThreadedTest) {
   delete tuple_schema;
 }
 
+// Build a BWTree index on two integer columns
+index::Index *BuildIntsIndex() {
+  catalog::Column column1(VALUE_TYPE_INTEGER, GetTypeSize(VALUE_TYPE_INTEGER),
+                          "A", true);
+  catalog::Column column2(VALUE_TYPE_INTEGER, GetTypeSize(VALUE_TYPE_INTEGER),
+                          "B", true);
+  std::vector<catalog::Column> columns({column1, column2});
+
+  // INDEX KEY SCHEMA -- {column1, column2}
+  std::vector<oid_t> key_attrs = {0, 1};
+  key_schema = new catalog::Schema(columns);
+  key_schema->SetIndexedColumns(key_attrs);
+
+  tuple_schema = new catalog::Schema(columns);
+
+  index::IndexMetadata *index_metadata = new index::IndexMetadata(
+      "test_index", 125, INDEX_TYPE_BWTREE, INDEX_CONSTRAINT_TYPE_DEFAULT,
+      tuple_schema, key_schema, key_attrs, false);
+
+  index::Index *index = index::IndexFactory::GetInstance(index_metadata);
+  EXPECT_TRUE(index != NULL);
+
+  return index;
+}
+
+TEST_F(IndexTests, BWTreeRangeScanTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer> locations;
+
+  std::unique_ptr<index::Index> index(BuildIntsIndex());
+
+  // Enough keys to span many leaf pages
+  const oid_t key_count = 1000;
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  for (oid_t key_itr = 0; key_itr < key_count; key_itr++) {
+    for (oid_t sub_itr = 0; sub_itr < 2; sub_itr++) {
+      key->SetValue(0, ValueFactory::GetIntegerValue(key_itr), pool);
+      key->SetValue(1, ValueFactory::GetIntegerValue(sub_itr), pool);
+      index->InsertEntry(key.get(), ItemPointer(key_itr, sub_itr));
+    }
+  }
+
+  auto lower = ValueFactory::GetIntegerValue(100);
+  auto upper = ValueFactory::GetIntegerValue(200);
+  std::vector<ExpressionType> range_exprs(
+      {EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+       EXPRESSION_TYPE_COMPARE_LESSTHAN});
+
+  // FORWARD RANGE SCAN comes in ascending key order
+  index->Scan({lower, upper}, {0, 0}, range_exprs,
+              SCAN_DIRECTION_TYPE_FORWARD, locations);
+  EXPECT_EQ(200U, locations.size());
+  EXPECT_EQ(100U, locations.front().block);
+  EXPECT_EQ(199U, locations.back().block);
+  locations.clear();
+
+  // BACKWARD RANGE SCAN comes in descending key order
+  index->Scan({lower, upper}, {0, 0}, range_exprs,
+              SCAN_DIRECTION_TYPE_BACKWARD, locations);
+  EXPECT_EQ(200U, locations.size());
+  EXPECT_EQ(199U, locations.front().block);
+  EXPECT_EQ(1U, locations.front().offset);
+  EXPECT_EQ(100U, locations.back().block);
+  EXPECT_EQ(0U, locations.back().offset);
+  for (size_t loc_itr = 1; loc_itr < locations.size(); loc_itr++) {
+    EXPECT_GE(locations[loc_itr - 1].block, locations[loc_itr].block);
+  }
+  locations.clear();
+
+  // Unbounded backward scan
+  index->Scan({}, {}, {}, SCAN_DIRECTION_TYPE_BACKWARD, locations);
+  EXPECT_EQ(2 * key_count, locations.size());
+  EXPECT_EQ(key_count - 1, locations.front().block);
+  EXPECT_EQ(0U, locations.back().block);
+  locations.clear();
+
+  // Bounds on the column after an "=="
+  index->Scan({ValueFactory::GetIntegerValue(500),
+               ValueFactory::GetIntegerValue(0)},
+              {0, 1}, {EXPRESSION_TYPE_COMPARE_EQUAL,
+                       EXPRESSION_TYPE_COMPARE_GREATERTHAN},
+              SCAN_DIRECTION_TYPE_BACKWARD, locations);
+  EXPECT_EQ(1U, locations.size());
+  EXPECT_EQ(500U, locations[0].block);
+  EXPECT_EQ(1U, locations[0].offset);
+  locations.clear();
+
+  // Only a bound on the non-leading column
+  index->Scan({ValueFactory::GetIntegerValue(1)}, {1},
+              {EXPRESSION_TYPE_COMPARE_EQUAL}, SCAN_DIRECTION_TYPE_FORWARD,
+              locations);
+  EXPECT_EQ(key_count, locations.size());
+  locations.clear();
+
+  // No key satisfies the predicate
+  index->Scan({upper, lower}, {0, 0}, range_exprs,
+              SCAN_DIRECTION_TYPE_FORWARD, locations);
+  EXPECT_EQ(0U, locations.size());
+
+  delete tuple_schema;
+}
+
+TEST_F(IndexTests, ScanKeyPointTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer> locations;
+
+  std::unique_ptr<index::Index> index(BuildIntsIndex());
+
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  for (oid_t key_itr = 0; key_itr < 100; key_itr++) {
+    key->SetValue(0, ValueFactory::GetIntegerValue(key_itr), pool);
+    key->SetValue(1, ValueFactory::GetIntegerValue(key_itr + 1), pool);
+    index->InsertEntry(key.get(), ItemPointer(key_itr, 0));
+  }
+
+  // Key values are taken in key column order
+  index->ScanKeyPoint({ValueFactory::GetIntegerValue(50),
+                       ValueFactory::GetIntegerValue(51)},
+                      locations);
+  EXPECT_EQ(1U, locations.size());
+  EXPECT_EQ(50U, locations[0].block);
+  locations.clear();
+
+  // Values of another integer type are cast to the column type
+  index->ScanKeyPoint({ValueFactory::GetBigIntValue(50),
+                       ValueFactory::GetSmallIntValue(51)},
+                      locations);
+  EXPECT_EQ(1U, locations.size());
+  locations.clear();
+
+  index->ScanKeyPoint({ValueFactory::GetIntegerValue(50),
+                       ValueFactory::GetIntegerValue(50)},
+                      locations);
+  EXPECT_EQ(0U, locations.size());
+
+  // A scan with "==" on every key column is a point lookup
+  index->Scan({ValueFactory::GetIntegerValue(21),
+               ValueFactory::GetIntegerValue(20)},
+              {1, 0}, {EXPRESSION_TYPE_COMPARE_EQUAL,
+                       EXPRESSION_TYPE_COMPARE_EQUAL},
+              SCAN_DIRECTION_TYPE_FORWARD, locations);
+  EXPECT_EQ(1U, locations.size());
+  EXPECT_EQ(20U, locations[0].block);
+  locations.clear();
+
+  delete tuple_schema;
+
+  // Keys with a varlen column go through a key tuple
+  index.reset(BuildIndex(false));
+  key.reset(new storage::Tuple(key_schema, true));
+  key->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  key->SetValue(1, ValueFactory::GetStringValue("a"), pool);
+  index->InsertEntry(key.get(), item0);
+
+  index->ScanKeyPoint({ValueFactory::GetIntegerValue(100),
+                       ValueFactory::GetStringValue("a")},
+                      locations);
+  EXPECT_EQ(1U, locations.size());
+  EXPECT_EQ(item0.block, locations[0].block);
+
+  delete tuple_schema;
+}
+
+TEST_F(IndexTests, TupleEntryTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer> locations;
+
+  std::unique_ptr<index::Index> index(BuildIntsIndex());
+
+  // Entries are keyed by the indexed columns of the table tuple
+  std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(tuple_schema, true));
+  for (oid_t tuple_itr = 0; tuple_itr < 100; tuple_itr++) {
+    tuple->SetValue(0, ValueFactory::GetIntegerValue(tuple_itr), pool);
+    tuple->SetValue(1, ValueFactory::GetIntegerValue(tuple_itr + 1), pool);
+    EXPECT_TRUE(
+        index->InsertTupleEntry(tuple.get(), ItemPointer(tuple_itr, 0)));
+  }
+
+  // The same keys are found through a key tuple
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  key->SetValue(0, ValueFactory::GetIntegerValue(50), pool);
+  key->SetValue(1, ValueFactory::GetIntegerValue(51), pool);
+  index->ScanKey(key.get(), locations);
+  EXPECT_EQ(1U, locations.size());
+  EXPECT_EQ(50U, locations[0].block);
+  locations.clear();
+
+  tuple->SetValue(0, ValueFactory::GetIntegerValue(50), pool);
+  tuple->SetValue(1, ValueFactory::GetIntegerValue(51), pool);
+  index->ScanTupleKey(tuple.get(), locations);
+  EXPECT_EQ(1U, locations.size());
+  EXPECT_EQ(50U, locations[0].block);
+  locations.clear();
+
+  EXPECT_TRUE(index->DeleteTupleEntry(tuple.get(), ItemPointer(50, 0)));
+  index->ScanTupleKey(tuple.get(), locations);
+  EXPECT_EQ(0U, locations.size());
+
+  delete tuple_schema;
+
+  // Keys with a varlen column go through a key tuple
+  index.reset(BuildIndex(false));
+  tuple.reset(new storage::Tuple(tuple_schema, true));
+  tuple->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  tuple->SetValue(1, ValueFactory::GetStringValue("a"), pool);
+  tuple->SetValue(2, ValueFactory::GetDoubleValue(1.5), pool);
+  tuple->SetValue(3, ValueFactory::GetIntegerValue(1), pool);
+  index->InsertTupleEntry(tuple.get(), item0);
+
+  index->ScanTupleKey(tuple.get(), locations);
+  EXPECT_EQ(1U, locations.size());
+  EXPECT_EQ(item0.block, locations[0].block);
+
+  delete tuple_schema;
+}
+
+TEST_F(IndexTests, ScanBatchTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<std::vector<ItemPointer>> results;
+
+  std::unique_ptr<index::Index> index(BuildIntsIndex());
+
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  for (oid_t key_itr = 0; key_itr < 100; key_itr++) {
+    key->SetValue(0, ValueFactory::GetIntegerValue(key_itr), pool);
+    key->SetValue(1, ValueFactory::GetIntegerValue(key_itr + 1), pool);
+    index->InsertEntry(key.get(), ItemPointer(key_itr, 0));
+  }
+
+  // Results are in the order of the keys, which need not be sorted
+  std::vector<std::vector<Value>> keys;
+  for (int key_itr : {70, 10, 99, 10, 40}) {
+    keys.push_back({ValueFactory::GetIntegerValue(key_itr),
+                    ValueFactory::GetIntegerValue(key_itr + 1)});
+  }
+  keys.push_back({ValueFactory::GetIntegerValue(40),
+                  ValueFactory::GetIntegerValue(40)});
+
+  index->ScanBatch(keys, results);
+  EXPECT_EQ(keys.size(), results.size());
+  std::vector<oid_t> expected_blocks = {70, 10, 99, 10, 40};
+  for (size_t key_itr = 0; key_itr < expected_blocks.size(); key_itr++) {
+    EXPECT_EQ(1U, results[key_itr].size());
+    EXPECT_EQ(expected_blocks[key_itr], results[key_itr][0].block);
+  }
+  EXPECT_EQ(0U, results.back().size());
+
+  delete tuple_schema;
+
+  // Keys with a varlen column
+  index.reset(BuildIndex(false));
+  key.reset(new storage::Tuple(key_schema, true));
+  key->SetValue(0, ValueFactory::GetIntegerValue(100), pool);
+  key->SetValue(1, ValueFactory::GetStringValue("a"), pool);
+  index->InsertEntry(key.get(), item0);
+  key->SetValue(1, ValueFactory::GetStringValue("b"), pool);
+  index->InsertEntry(key.get(), item1);
+
+  results.clear();
+  index->ScanBatch({{ValueFactory::GetIntegerValue(100),
+                     ValueFactory::GetStringValue("b")},
+                    {ValueFactory::GetIntegerValue(100),
+                     ValueFactory::GetStringValue("c")},
+                    {ValueFactory::GetIntegerValue(100),
+                     ValueFactory::GetStringValue("a")}},
+                   results);
+  EXPECT_EQ(3U, results.size());
+  EXPECT_EQ(1U, results[0].size());
+  EXPECT_EQ(item1.offset, results[0][0].offset);
+  EXPECT_EQ(0U, results[1].size());
+  EXPECT_EQ(1U, results[2].size());
+  EXPECT_EQ(item0.offset, results[2][0].offset);
+
+  delete tuple_schema;
+}
+
+TEST_F(IndexTests, IntsKeyTest) {
+  std::vector<catalog::Column> columns(
+      {catalog::Column(VALUE_TYPE_SMALLINT, GetTypeSize(VALUE_TYPE_SMALLINT),
+                       "A", true),
+       catalog::Column(VALUE_TYPE_BIGINT, GetTypeSize(VALUE_TYPE_BIGINT), "B",
+                       true),
+       catalog::Column(VALUE_TYPE_INTEGER, GetTypeSize(VALUE_TYPE_INTEGER),
+                       "C", true)});
+  std::unique_ptr<catalog::Schema> schema(new catalog::Schema(columns));
+
+  std::vector<Value> values = {ValueFactory::GetSmallIntValue(-7),
+                               ValueFactory::GetBigIntValue(1LL << 40),
+                               ValueFactory::GetNullValueByType(
+                                   VALUE_TYPE_INTEGER)};
+  index::IntsKey<2> key;
+  key.SetFromValues(schema.get(), values);
+
+  // Columns are decoded from the packed key, across its words
+  auto tuple = key.GetTupleForComparison(schema.get());
+  for (oid_t column_itr = 0; column_itr < values.size(); column_itr++) {
+    EXPECT_EQ(0, tuple.GetValue(column_itr).Compare(values[column_itr]));
+  }
+  EXPECT_TRUE(tuple.GetValue(2).IsNull());
+
+  // Packed keys order like their values
+  index::IntsKey<2> other_key;
+  values[0] = ValueFactory::GetSmallIntValue(3);
+  other_key.SetFromValues(schema.get(), values);
+  EXPECT_TRUE(index::IntsComparator<2>()(key, other_key));
+}
+
 TEST_F(IndexTests, NonUniqueKeyMultiThreadedStressTest) {
   auto pool = TestingHarness::GetInstance().GetTestingPool();
   std::vector<ItemPointer> locations;
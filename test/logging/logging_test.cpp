@@ -316,6 +316,77 @@ TEST_F(LoggingTests, InsertUpdateDeleteTest) {
   scheduler.Cleanup();
 }
 
+std::mutex acknowledged_mutex;
+
+std::vector<cid_t> acknowledged;
+
+void AcknowledgeCommit(cid_t commit_id) {
+  std::lock_guard<std::mutex> lock(acknowledged_mutex);
+  acknowledged.push_back(commit_id);
+}
+
+// Log and asynchronously commit transactions with the given commit ids
+void AsyncCommits(cid_t begin_commit_id, cid_t end_commit_id,
+                  UNUSED_ATTRIBUTE uint64_t thread_itr) {
+  auto &log_manager = logging::LogManager::GetInstance();
+  concurrency::CommitCallback callback = AcknowledgeCommit;
+
+  for (cid_t commit_id = begin_commit_id; commit_id < end_commit_id;
+       commit_id++) {
+    log_manager.PrepareLogging();
+    log_manager.LogBeginTransaction(commit_id);
+    log_manager.LogCommitTransaction(commit_id, callback);
+  }
+}
+
+TEST_F(LoggingTests, GroupCommitTest) {
+  peloton_logging_mode = LOGGING_TYPE_INVALID;
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.DropFrontendLoggers();
+  log_manager.ResetLogStatus();
+  peloton_logging_mode = LOGGING_TYPE_NVM_WAL;
+
+  log_manager.Configure(LOGGING_TYPE_NVM_WAL, true);
+  log_manager.SetSyncCommit(false);
+  log_manager.SetGroupCommitSize(4);
+  log_manager.StartStandbyMode();
+  log_manager.GetFrontendLogger(0)->SetTestMode(true);
+  log_manager.StartRecoveryMode();
+  log_manager.WaitForModeTransition(LOGGING_STATUS_TYPE_LOGGING, true);
+  log_manager.SetGlobalMaxFlushedCommitId(4);
+
+  // Asynchronous commits return before they are acknowledged. They run on
+  // a new thread, which gets a backend logger of the new frontend logger.
+  LaunchParallelTest(1, AsyncCommits, 5, 9);
+
+  // The group is acknowledged once it is flushed
+  while (log_manager.GetPendingCommitCount() > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_LE(8U, log_manager.GetPersistentFlushedCommitId());
+  {
+    std::lock_guard<std::mutex> lock(acknowledged_mutex);
+    EXPECT_EQ(4U, acknowledged.size());
+    EXPECT_TRUE(std::is_sorted(acknowledged.begin(), acknowledged.end()));
+  }
+
+  // A commit queued only after the flush that covers it was acknowledged
+  // has no later flush to wait for, it is acknowledged at once
+  auto flushed_commit_id = log_manager.GetPersistentFlushedCommitId();
+  log_manager.EnqueueCommit(flushed_commit_id, AcknowledgeCommit);
+  EXPECT_EQ(0U, log_manager.GetPendingCommitCount());
+  {
+    std::lock_guard<std::mutex> lock(acknowledged_mutex);
+    EXPECT_EQ(5U, acknowledged.size());
+    EXPECT_EQ(flushed_commit_id, acknowledged.back());
+  }
+
+  log_manager.EndLogging();
+  log_manager.ResetLogStatus();
+  log_manager.SetGroupCommitSize(peloton_group_commit_size);
+  log_manager.SetSyncCommit(true);
+}
+
 TEST_F(LoggingTests, BasicLogManagerTest) {
   peloton_logging_mode = LOGGING_TYPE_INVALID;
   auto &log_manager = logging::LogManager::GetInstance();
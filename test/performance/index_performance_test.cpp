@@ -14,13 +14,16 @@
 #include "gtest/gtest.h"
 #include "common/harness.h"
 
+#include <random>
 #include <vector>
 #include <thread>
 
 #include "common/logger.h"
 #include "common/platform.h"
 #include "common/timer.h"
+#include "index/bwtree_index.h"
 #include "index/index_factory.h"
+#include "index/index_key.h"
 #include "storage/tuple.h"
 
 namespace peloton {
@@ -39,8 +42,8 @@ catalog::Schema *tuple_schema = nullptr;
 ItemPointer item0(120, 5);
 ItemPointer item1(120, 7);
 
-index::Index *BuildIndex(const bool unique_keys,
-                         const IndexType index_type) {
+index::IndexMetadata *BuildIndexMetadata(const bool unique_keys,
+                                         const IndexType index_type) {
   // Build tuple and key schema
   std::vector<std::vector<std::string>> column_names;
   std::vector<catalog::Column> columns;
@@ -74,8 +77,14 @@ index::Index *BuildIndex(const bool unique_keys,
       "test_index", 125, index_type, INDEX_CONSTRAINT_TYPE_DEFAULT,
       tuple_schema, key_schema, key_attrs, unique_keys);
 
+  return index_metadata;
+}
+
+index::Index *BuildIndex(const bool unique_keys,
+                         const IndexType index_type) {
   // Build index
-  index::Index *index = index::IndexFactory::GetInstance(index_metadata);
+  index::Index *index = index::IndexFactory::GetInstance(
+      BuildIndexMetadata(unique_keys, index_type));
   EXPECT_TRUE(index != NULL);
 
   return index;
@@ -167,6 +176,39 @@ static void DeleteTest1(index::Index *index,
   return;
 }
 
+/*
+ * LookupTest1() - Tests ScanKey() performance for each index type
+ *
+ * This function tests threads looking up the keys inserted by InsertTest1()
+ * on the same consecutive intervals
+ */
+static void LookupTest1(index::Index *index,
+                        size_t num_thread,
+                        size_t num_key,
+                        uint64_t thread_id) {
+  // To avoid compiler warning
+  (void)num_thread;
+
+  size_t start_key = thread_id * num_key;
+  size_t end_key = start_key + num_key;
+
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  std::vector<ItemPointer> locations;
+
+  for (size_t i = start_key;i < end_key;i++) {
+    auto key_value =  ValueFactory::GetIntegerValue(i);
+
+    key->SetValue(0, key_value, nullptr);
+    key->SetValue(1, key_value, nullptr);
+
+    index->ScanKey(key.get(), locations);
+    EXPECT_EQ(locations.size(), 1);
+    locations.clear();
+  }
+
+  return;
+}
+
 /*
  * InsertTest2() - Tests InsertEntry() performance for each index type
  *
@@ -389,6 +431,155 @@ static void TestIndexPerformance(const IndexType& index_type) {
   return;
 }
 
+/*
+ * TestKeyLayoutPerformance() - Test driver for a BwTree key layout
+ *
+ * This tests insert, point lookup and range scan performance of a BwTree
+ * on two integer columns, whose keys are laid out as the index type says
+ */
+static void TestKeyLayoutPerformance(index::Index *index,
+                                     const char *layout) {
+  std::vector<ItemPointer> locations;
+
+  size_t num_thread = 4;
+  size_t num_key = 1024 * 64;
+
+  Timer<> timer;
+
+  timer.Start();
+  LaunchParallelTest(num_thread, InsertTest1, index, num_thread, num_key);
+  timer.Stop();
+  LOG_INFO("Test = KeyLayoutInsert; Layout = %s; Duration = %.2lf",
+           layout,
+           timer.GetDuration());
+
+  timer.Reset();
+  timer.Start();
+  LaunchParallelTest(num_thread, LookupTest1, index, num_thread, num_key);
+  timer.Stop();
+  LOG_INFO("Test = KeyLayoutLookup; Layout = %s; Duration = %.2lf",
+           layout,
+           timer.GetDuration());
+
+  // Range scans on the leading key column
+  size_t num_scan = 100;
+  size_t scan_size = num_thread * num_key / num_scan;
+
+  timer.Reset();
+  timer.Start();
+  for (size_t scan_itr = 0;scan_itr < num_scan;scan_itr++) {
+    index->Scan({ValueFactory::GetIntegerValue(scan_itr * scan_size),
+                 ValueFactory::GetIntegerValue((scan_itr + 1) * scan_size)},
+                {0, 0},
+                {EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+                 EXPRESSION_TYPE_COMPARE_LESSTHAN},
+                SCAN_DIRECTION_TYPE_FORWARD,
+                locations);
+  }
+  timer.Stop();
+  EXPECT_EQ(locations.size(), num_scan * scan_size);
+  LOG_INFO("Test = KeyLayoutScan; Layout = %s; Duration = %.2lf",
+           layout,
+           timer.GetDuration());
+
+  delete index;
+  delete tuple_schema;
+
+  return;
+}
+
+/*
+ * TestBatchLookupPerformance() - Test driver for batched point lookups
+ *
+ * This looks up random batches of keys, as an IN-list or the stock probe of
+ * TPC-C StockLevel would, once with a ScanKeyPoint() per key and once with
+ * one ScanBatch() per batch
+ */
+static void TestBatchLookupPerformance(const IndexType &index_type) {
+  std::unique_ptr<index::Index> index(BuildIndex(false, index_type));
+
+  size_t num_key = 1024 * 256;
+  size_t batch_size = 200;
+  size_t num_batch = 1024 * 4;
+
+  InsertTest1(index.get(), 1, num_key, 0);
+
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> key_dist(0, num_key - 1);
+  std::vector<std::vector<std::vector<Value>>> batches(num_batch);
+  for (auto &batch : batches) {
+    for (size_t key_itr = 0;key_itr < batch_size;key_itr++) {
+      auto key_value = ValueFactory::GetIntegerValue(key_dist(rng));
+      batch.push_back({key_value, key_value});
+    }
+  }
+
+  Timer<> timer;
+  size_t found_count = 0;
+
+  timer.Start();
+  std::vector<ItemPointer> locations;
+  for (auto &batch : batches) {
+    for (auto &key : batch) {
+      index->ScanKeyPoint(key, locations);
+    }
+    found_count += locations.size();
+    locations.clear();
+  }
+  timer.Stop();
+  EXPECT_EQ(found_count, num_batch * batch_size);
+  LOG_INFO("Test = PointLookup; Type = %d; Duration = %.2lf",
+           (int)index_type,
+           timer.GetDuration());
+
+  timer.Reset();
+  found_count = 0;
+
+  timer.Start();
+  std::vector<std::vector<ItemPointer>> results;
+  for (auto &batch : batches) {
+    index->ScanBatch(batch, results);
+    for (auto &result : results) {
+      found_count += result.size();
+    }
+    results.clear();
+  }
+  timer.Stop();
+  EXPECT_EQ(found_count, num_batch * batch_size);
+  LOG_INFO("Test = BatchLookup; Type = %d; Duration = %.2lf",
+           (int)index_type,
+           timer.GetDuration());
+
+  delete tuple_schema;
+
+  return;
+}
+
+TEST_F(IndexPerformanceTests, BatchLookupTest) {
+  std::vector<IndexType> index_types = {INDEX_TYPE_SKIPLIST, INDEX_TYPE_BWTREE};
+
+  for(auto index_type : index_types) {
+    TestBatchLookupPerformance(index_type);
+  }
+}
+
+TEST_F(IndexPerformanceTests, KeyLayoutTest) {
+  // The index factory packs integer keys into an IntsKey
+  TestKeyLayoutPerformance(BuildIndex(false, INDEX_TYPE_BWTREE), "IntsKey");
+
+  // The same columns stored as a tuple in a GenericKey
+  TestKeyLayoutPerformance(
+      new index::BWTreeIndex<index::GenericKey<8>,
+                             ItemPointer,
+                             index::GenericComparator<8>,
+                             index::GenericEqualityChecker<8>,
+                             index::GenericHasher<8>,
+                             index::ItemPointerComparator,
+                             index::ItemPointerHashFunc>(
+          BuildIndexMetadata(false, INDEX_TYPE_BWTREE)),
+      "GenericKey");
+}
+
 TEST_F(IndexPerformanceTests, MultiThreadedTest) {
   std::vector<IndexType> index_types = {INDEX_TYPE_BTREE, INDEX_TYPE_SKIPLIST, INDEX_TYPE_BWTREE};
 
@@ -0,0 +1,116 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_directory_performance_test.cpp
+//
+// Identification: test/performance/tile_group_directory_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "gtest/gtest.h"
+#include "common/harness.h"
+
+#include <vector>
+#include <thread>
+
+#include "common/logger.h"
+#include "common/platform.h"
+#include "common/timer.h"
+#include "container/append_only_array.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Directory Performance Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupDirectoryPerformanceTests : public PelotonTest {};
+
+// Number of tile groups in the directory
+size_t directory_size = 1024;
+
+// Number of full passes over the directory done by each reader
+size_t scan_count = 100;
+
+// RWLock-protected vector, the directory layout DataTable used before
+struct LockedDirectory {
+  RWLock lock;
+  std::vector<oid_t> tile_groups;
+};
+
+void ScanLockedDirectory(LockedDirectory *directory,
+                         UNUSED_ATTRIBUTE uint64_t thread_itr) {
+  oid_t checksum = 0;
+
+  for (size_t scan_itr = 0; scan_itr < scan_count; scan_itr++) {
+    directory->lock.ReadLock();
+    size_t tile_group_count = directory->tile_groups.size();
+    directory->lock.Unlock();
+
+    for (size_t offset = 0; offset < tile_group_count; offset++) {
+      directory->lock.ReadLock();
+      checksum += directory->tile_groups.at(offset);
+      directory->lock.Unlock();
+    }
+  }
+
+  EXPECT_NE(checksum, INVALID_OID);
+}
+
+void ScanAppendOnlyDirectory(AppendOnlyArray<oid_t> *directory,
+                             UNUSED_ATTRIBUTE uint64_t thread_itr) {
+  oid_t checksum = 0;
+
+  for (size_t scan_itr = 0; scan_itr < scan_count; scan_itr++) {
+    size_t tile_group_count = directory->GetSize();
+
+    for (size_t offset = 0; offset < tile_group_count; offset++) {
+      checksum += directory->Find(offset);
+    }
+  }
+
+  EXPECT_NE(checksum, INVALID_OID);
+}
+
+TEST_F(TileGroupDirectoryPerformanceTests, ReadScalingTest) {
+  std::vector<size_t> thread_counts = {1, 2, 4, 8, 16, 32, 64};
+
+  LockedDirectory locked_directory;
+  AppendOnlyArray<oid_t> append_only_directory;
+
+  for (size_t offset = 0; offset < directory_size; offset++) {
+    locked_directory.tile_groups.push_back(offset + 1);
+    append_only_directory.Append(offset + 1);
+  }
+
+  for (auto num_thread : thread_counts) {
+    Timer<> timer;
+    double lookups = num_thread * scan_count * directory_size;
+
+    timer.Start();
+    LaunchParallelTest(num_thread, ScanLockedDirectory, &locked_directory);
+    timer.Stop();
+    auto locked_duration = timer.GetDuration();
+
+    timer.Reset();
+    timer.Start();
+    LaunchParallelTest(num_thread, ScanAppendOnlyDirectory,
+                       &append_only_directory);
+    timer.Stop();
+    auto append_only_duration = timer.GetDuration();
+
+    LOG_INFO(
+        "Threads = %lu; RWLock = %.2lf M lookups/s; AppendOnly = %.2lf M "
+        "lookups/s",
+        num_thread, lookups / locked_duration / 1000000,
+        lookups / append_only_duration / 1000000);
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_header_performance_test.cpp
+//
+// Identification: test/performance/tile_group_header_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "gtest/gtest.h"
+#include "common/harness.h"
+
+#include <cstdlib>
+#include <vector>
+
+#include "common/logger.h"
+#include "common/timer.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Header Performance Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupHeaderPerformanceTests : public PelotonTest {};
+
+// Number of tuple slots in the header
+oid_t header_tuple_count = 1000 * 100;
+
+// Number of full passes over the header done by the scan
+size_t header_scan_count = 100;
+
+// Number of random slots updated
+size_t header_update_count = 1000 * 1000 * 10;
+
+// Read the commit ids of every slot, like a visibility check does
+cid_t ScanHeader(storage::TileGroupHeader *header, const cid_t &read_cid) {
+  cid_t visible_count = 0;
+
+  for (size_t scan_itr = 0; scan_itr < header_scan_count; scan_itr++) {
+    for (oid_t tuple_id = 0; tuple_id < header_tuple_count; tuple_id++) {
+      if (header->GetBeginCommitId(tuple_id) <= read_cid &&
+          header->GetEndCommitId(tuple_id) > read_cid) {
+        visible_count++;
+      }
+    }
+  }
+
+  return visible_count;
+}
+
+// Install new versions at random slots, like a commit does
+void UpdateHeader(storage::TileGroupHeader *header,
+                  const std::vector<oid_t> &tuple_ids) {
+  cid_t commit_id = 1;
+
+  for (auto tuple_id : tuple_ids) {
+    header->SetEndCommitId(tuple_id, commit_id);
+    header->SetNextItemPointer(tuple_id, ItemPointer(0, tuple_id));
+    header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+    commit_id++;
+  }
+}
+
+TEST_F(TileGroupHeaderPerformanceTests, LayoutTest) {
+  std::vector<LayoutType> header_layouts = {LAYOUT_TYPE_ROW,
+                                            LAYOUT_TYPE_COLUMN};
+
+  std::srand(0);
+  std::vector<oid_t> tuple_ids;
+  for (size_t update_itr = 0; update_itr < header_update_count; update_itr++) {
+    tuple_ids.push_back(std::rand() % header_tuple_count);
+  }
+
+  for (auto header_layout : header_layouts) {
+    storage::TileGroupHeader header(BACKEND_TYPE_MM, header_tuple_count,
+                                    header_layout);
+
+    for (oid_t tuple_id = 0; tuple_id < header_tuple_count; tuple_id++) {
+      header.SetTransactionId(tuple_id, INITIAL_TXN_ID);
+      header.SetBeginCommitId(tuple_id, tuple_id);
+    }
+
+    Timer<> timer;
+
+    timer.Start();
+    auto visible_count = ScanHeader(&header, header_tuple_count / 2);
+    timer.Stop();
+    auto scan_duration = timer.GetDuration();
+
+    EXPECT_EQ(header_scan_count * (header_tuple_count / 2 + 1),
+              visible_count);
+
+    timer.Reset();
+    timer.Start();
+    UpdateHeader(&header, tuple_ids);
+    timer.Stop();
+    auto update_duration = timer.GetDuration();
+
+    double scanned = header_scan_count * header_tuple_count;
+    double updated = header_update_count;
+
+    LOG_INFO("Layout = %s; Scan = %.2lf M slots/s; Update = %.2lf M slots/s",
+             (header_layout == LAYOUT_TYPE_ROW) ? "ROW" : "COLUMN",
+             scanned / scan_duration / 1000000,
+             updated / update_duration / 1000000);
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
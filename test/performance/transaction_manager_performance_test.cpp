@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// transaction_manager_performance_test.cpp
+//
+// Identification: test/performance/transaction_manager_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "gtest/gtest.h"
+#include "common/harness.h"
+
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "common/logger.h"
+#include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Transaction Manager Performance Tests
+//===--------------------------------------------------------------------===//
+
+class TransactionManagerPerformanceTests : public PelotonTest {};
+
+// Number of transactions run by each thread
+size_t txn_count_per_thread = 1000 * 10;
+
+std::mutex txn_ids_mutex;
+
+std::set<txn_id_t> txn_ids;
+
+// Begin and commit read-only transactions
+void BeginCommit(uint64_t thread_itr UNUSED_ATTRIBUTE) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::vector<txn_id_t> thread_txn_ids;
+
+  for (size_t txn_itr = 0; txn_itr < txn_count_per_thread; txn_itr++) {
+    auto txn = txn_manager.BeginTransaction();
+    thread_txn_ids.push_back(txn->GetTransactionId());
+    txn_manager.CommitTransaction();
+  }
+
+  std::lock_guard<std::mutex> lock(txn_ids_mutex);
+  txn_ids.insert(thread_txn_ids.begin(), thread_txn_ids.end());
+}
+
+// Take the commit ids of writing transactions
+void AllocateCommitIds(uint64_t thread_itr UNUSED_ATTRIBUTE) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  cid_t last_commit_id = INVALID_CID;
+
+  for (size_t txn_itr = 0; txn_itr < txn_count_per_thread; txn_itr++) {
+    auto commit_id = txn_manager.GetNextCommitId();
+    EXPECT_GT(commit_id, last_commit_id);
+    last_commit_id = commit_id;
+  }
+}
+
+TEST_F(TransactionManagerPerformanceTests, BeginCommitTest) {
+  std::vector<size_t> thread_counts = {1, 2, 4, 8, 16, 32, 64};
+
+  for (auto thread_count : thread_counts) {
+    Timer<> timer;
+    txn_ids.clear();
+
+    timer.Start();
+    LaunchParallelTest(thread_count, BeginCommit);
+    timer.Stop();
+    auto txn_duration = timer.GetDuration();
+
+    // Transaction ids are unique across threads
+    EXPECT_EQ(thread_count * txn_count_per_thread, txn_ids.size());
+
+    timer.Reset();
+    timer.Start();
+    LaunchParallelTest(thread_count, AllocateCommitIds);
+    timer.Stop();
+    auto commit_id_duration = timer.GetDuration();
+
+    double txns = thread_count * txn_count_per_thread;
+
+    LOG_INFO("Threads = %lu; Begin/Commit = %.2lf M txns/s; "
+             "Commit ids = %.2lf M ids/s",
+             thread_count, txns / txn_duration / 1000000,
+             txns / commit_id_duration / 1000000);
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
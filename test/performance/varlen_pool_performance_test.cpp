@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// varlen_pool_performance_test.cpp
+//
+// Identification: test/performance/varlen_pool_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "gtest/gtest.h"
+#include "common/harness.h"
+
+#include <memory>
+#include <vector>
+
+#include "common/logger.h"
+#include "common/pool.h"
+#include "common/timer.h"
+#include "common/value_factory.h"
+#include "storage/data_table.h"
+#include "storage/tuple.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Varlen Pool Performance Tests
+//===--------------------------------------------------------------------===//
+
+class VarlenPoolPerformanceTests : public PelotonTest {};
+
+// Number of tuples inserted by each thread
+size_t varlen_insert_count = 1000 * 100;
+
+// Number of tuple slots in each tile group
+int varlen_tuples_per_tile_group = 1000;
+
+// Insert tuples with a VARCHAR column, copying the string into the tile pool
+void InsertVarlenTuples(storage::DataTable *table, uint64_t thread_itr) {
+  const bool allocate = true;
+  std::unique_ptr<VarlenPool> pool(new VarlenPool(BACKEND_TYPE_MM));
+  storage::Tuple tuple(table->GetSchema(), allocate);
+
+  for (size_t insert_itr = 0; insert_itr < varlen_insert_count; insert_itr++) {
+    int populate_value = thread_itr * varlen_insert_count + insert_itr;
+    tuple.SetValue(0, ValueFactory::GetIntegerValue(populate_value),
+                   pool.get());
+    tuple.SetValue(1, ValueFactory::GetIntegerValue(populate_value),
+                   pool.get());
+    tuple.SetValue(2, ValueFactory::GetDoubleValue(populate_value),
+                   pool.get());
+    tuple.SetValue(3, ValueFactory::GetStringValue(
+                          std::to_string(populate_value), pool.get()),
+                   pool.get());
+
+    auto location = table->InsertTuple(&tuple);
+    EXPECT_NE(INVALID_OID, location.block);
+
+    // Keep the thread's own pool small
+    if (insert_itr % 1000 == 0) pool->Purge();
+  }
+}
+
+TEST_F(VarlenPoolPerformanceTests, InsertTest) {
+  std::vector<uint64_t> thread_counts = {1, 2, 4, 8};
+
+  for (auto thread_count : thread_counts) {
+    std::unique_ptr<storage::DataTable> table(
+        ExecutorTestsUtil::CreateTable(varlen_tuples_per_tile_group, false));
+
+    Timer<> timer;
+    timer.Start();
+    LaunchParallelTest(thread_count, InsertVarlenTuples, table.get());
+    timer.Stop();
+
+    double inserted = thread_count * varlen_insert_count;
+    LOG_INFO("Threads = %lu; Insert = %.2lf M tuples/s", thread_count,
+             inserted / timer.GetDuration() / 1000000);
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
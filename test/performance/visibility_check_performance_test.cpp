@@ -0,0 +1,116 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// visibility_check_performance_test.cpp
+//
+// Identification: test/performance/visibility_check_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "gtest/gtest.h"
+#include "common/harness.h"
+
+#include <vector>
+
+#include "common/logger.h"
+#include "common/timer.h"
+#include "concurrency/ts_order_txn_manager.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Visibility Check Performance Tests
+//===--------------------------------------------------------------------===//
+
+class VisibilityCheckPerformanceTests : public PelotonTest {};
+
+// Number of tuple slots in the header
+oid_t visibility_tuple_count = 1000 * 100;
+
+// Number of full passes over the header done by each scan
+size_t visibility_scan_count = 100;
+
+// Check every slot with one virtual call per tuple
+void ScanPerTuple(concurrency::TransactionManager &txn_manager,
+                  storage::TileGroupHeader *header,
+                  std::vector<oid_t> &visible_tuple_ids) {
+  for (size_t scan_itr = 0; scan_itr < visibility_scan_count; scan_itr++) {
+    visible_tuple_ids.clear();
+    for (oid_t tuple_id = 0; tuple_id < visibility_tuple_count; tuple_id++) {
+      if (txn_manager.IsVisible(header, tuple_id)) {
+        visible_tuple_ids.push_back(tuple_id);
+      }
+    }
+  }
+}
+
+// Check every slot with one batch call per pass
+void ScanBatch(concurrency::TransactionManager &txn_manager,
+               storage::TileGroupHeader *header,
+               std::vector<oid_t> &visible_tuple_ids) {
+  for (size_t scan_itr = 0; scan_itr < visibility_scan_count; scan_itr++) {
+    visible_tuple_ids.clear();
+    txn_manager.IsVisibleBatch(header, 0, visibility_tuple_count,
+                               visible_tuple_ids);
+  }
+}
+
+TEST_F(VisibilityCheckPerformanceTests, ScanTest) {
+  std::vector<LayoutType> header_layouts = {LAYOUT_TYPE_ROW,
+                                            LAYOUT_TYPE_COLUMN};
+
+  auto &txn_manager = concurrency::TsOrderTxnManager::GetInstance();
+
+  for (auto header_layout : header_layouts) {
+    storage::TileGroupHeader header(BACKEND_TYPE_MM, visibility_tuple_count,
+                                    header_layout);
+
+    // Every other slot holds a committed version, the rest are empty
+    for (oid_t tuple_id = 0; tuple_id < visibility_tuple_count; tuple_id++) {
+      if (tuple_id % 2 == 0) {
+        header.SetTransactionId(tuple_id, INITIAL_TXN_ID);
+        header.SetBeginCommitId(tuple_id, 1);
+      } else {
+        header.SetTransactionId(tuple_id, INVALID_TXN_ID);
+      }
+    }
+
+    txn_manager.BeginTransaction();
+
+    std::vector<oid_t> per_tuple_ids;
+    std::vector<oid_t> batch_ids;
+    Timer<> timer;
+
+    timer.Start();
+    ScanPerTuple(txn_manager, &header, per_tuple_ids);
+    timer.Stop();
+    auto per_tuple_duration = timer.GetDuration();
+
+    timer.Reset();
+    timer.Start();
+    ScanBatch(txn_manager, &header, batch_ids);
+    timer.Stop();
+    auto batch_duration = timer.GetDuration();
+
+    txn_manager.CommitTransaction();
+
+    EXPECT_EQ(visibility_tuple_count / 2, per_tuple_ids.size());
+    EXPECT_EQ(per_tuple_ids, batch_ids);
+
+    double scanned = visibility_scan_count * visibility_tuple_count;
+
+    LOG_INFO("Layout = %s; Per tuple = %.2lf M slots/s; Batch = %.2lf M slots/s",
+             (header_layout == LAYOUT_TYPE_ROW) ? "ROW" : "COLUMN",
+             scanned / per_tuple_duration / 1000000,
+             scanned / batch_duration / 1000000);
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -88,5 +88,45 @@ TEST_F(DataTableTests, GlobalTableTest) {
   data_table_test_table.release();
 }
 
+void InsertIntoActiveTileGroups(storage::DataTable *table, oid_t tuple_count,
+                                uint64_t thread_itr) {
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    auto tuple = ExecutorTestsUtil::GetTuple(
+        table, thread_itr * tuple_count + tuple_itr, testing_pool);
+    auto location = table->InsertTuple(tuple.get());
+    EXPECT_NE(location.block, INVALID_OID);
+  }
+}
+
+TEST_F(DataTableTests, ActiveTileGroupTest) {
+  const oid_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  const size_t active_tile_group_count = 4;
+
+  peloton_active_tile_group_count = active_tile_group_count;
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  peloton_active_tile_group_count = 1;
+
+  // Each active slot starts out with its own tile group
+  EXPECT_EQ(data_table->GetTileGroupCount(), active_tile_group_count);
+
+  LaunchParallelTest(active_tile_group_count, InsertIntoActiveTileGroups,
+                     data_table.get(), tuple_count);
+
+  // Every inserted tuple must land in exactly one slot
+  size_t inserted_tuple_count = 0;
+  auto tile_group_count = data_table->GetTileGroupCount();
+  for (size_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+       tile_group_itr++) {
+    auto tile_group = data_table->GetTileGroup(tile_group_itr);
+    inserted_tuple_count += tile_group->GetNextTupleSlot();
+  }
+
+  EXPECT_EQ(inserted_tuple_count, active_tile_group_count * tuple_count);
+  EXPECT_GE(tile_group_count, active_tile_group_count);
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,181 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// frozen_tile_group_test.cpp
+//
+// Identification: test/storage/frozen_tile_group_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/expression_util.h"
+#include "logging/checkpoint_tile_scanner.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "storage/frozen_tile_group.h"
+#include "storage/tile_group.h"
+#include "storage/tuple.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Frozen Tile Group Tests
+//===--------------------------------------------------------------------===//
+
+class FrozenTileGroupTests : public PelotonTest {};
+
+// Count the tuples where column 3 equals the value
+size_t ScanEqual(storage::DataTable *table, int value) {
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_EQUAL,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_VARCHAR, 0, 3),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetStringValue(std::to_string(value))));
+
+  std::vector<oid_t> column_ids({0, 3});
+  planner::SeqScanPlan node(table, predicate, column_ids);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  auto expected = ValueFactory::GetStringValue(std::to_string(value));
+  size_t result_tuple_count = 0;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (auto tuple_id : *result_tile) {
+      EXPECT_EQ(0, expected.Compare(result_tile->GetValue(tuple_id, 1)));
+    }
+    result_tuple_count += result_tile->GetTupleCount();
+  }
+
+  txn_manager.CommitTransaction();
+
+  return result_tuple_count;
+}
+
+TEST_F(FrozenTileGroupTests, FreezeTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+
+  // The last tile group is not full
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count * 2 + 1, false,
+                                   false, false);
+  txn_manager.CommitTransaction();
+
+  auto old_tile_group = table->GetTileGroup(0);
+  oid_t column_count = old_tile_group->GetColumnMap().size();
+
+  std::vector<std::vector<Value>> values(tuple_count);
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      values[tuple_itr].push_back(
+          old_tile_group->GetValue(tuple_itr, column_itr));
+    }
+  }
+
+  // Versions newer than the max dead commit id are not frozen
+  EXPECT_EQ(nullptr, table->FreezeTileGroup(0, 0));
+
+  auto max_dead_cid = txn_manager.GetCurrentCommitId();
+  EXPECT_EQ(nullptr, table->FreezeTileGroup(2, max_dead_cid));
+
+  // A version owned by a writer keeps the tile group from being frozen
+  auto old_header = old_tile_group->GetHeader();
+  txn_id_t writer_txn_id = START_TXN_ID;
+  EXPECT_TRUE(old_header->SetAtomicTransactionId(1, writer_txn_id));
+  EXPECT_EQ(nullptr, table->FreezeTileGroup(0, max_dead_cid));
+  EXPECT_EQ(INITIAL_TXN_ID, old_header->GetTransactionId(0));
+  EXPECT_EQ(0U, old_header->GetOwnerCount());
+  old_header->SetTransactionId(1, INITIAL_TXN_ID);
+
+  auto frozen_tile_group = table->FreezeTileGroup(0, max_dead_cid);
+  EXPECT_NE(nullptr, frozen_tile_group);
+  EXPECT_TRUE(frozen_tile_group->IsFrozen());
+  EXPECT_EQ(frozen_tile_group, table->GetTileGroup(0).get());
+  EXPECT_EQ(nullptr, table->FreezeTileGroup(0, max_dead_cid));
+
+  // Writers can own the versions of the frozen copy but not of the original
+  EXPECT_EQ(INITIAL_TXN_ID,
+            frozen_tile_group->GetHeader()->GetTransactionId(0));
+  EXPECT_EQ(0U, frozen_tile_group->GetHeader()->GetOwnerCount());
+  EXPECT_FALSE(old_header->SetAtomicTransactionId(0, writer_txn_id));
+
+  auto frozen = frozen_tile_group->GetFrozenTileGroup();
+  EXPECT_EQ(COLUMN_ENCODING_TYPE_BIT_PACKED, frozen->GetColumnEncoding(0));
+  EXPECT_EQ(COLUMN_ENCODING_TYPE_PLAIN, frozen->GetColumnEncoding(2));
+  EXPECT_EQ(COLUMN_ENCODING_TYPE_DICTIONARY, frozen->GetColumnEncoding(3));
+
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      EXPECT_EQ(0, values[tuple_itr][column_itr].Compare(
+                       frozen_tile_group->GetValue(tuple_itr, column_itr)));
+    }
+  }
+
+  // A scan that rejects all tuples reads the frozen values in place
+  EXPECT_EQ(0U, ScanEqual(table.get(), 7));
+  EXPECT_TRUE(frozen_tile_group->IsFrozen());
+
+  // Producing a logical tile decodes the frozen values as well
+  EXPECT_EQ(1U, ScanEqual(table.get(), ExecutorTestsUtil::PopulatedValue(
+                                           tuple_count - 1, 3)));
+  EXPECT_TRUE(frozen_tile_group->IsFrozen());
+
+  // Checkpoints read the frozen values at their tuple slots
+  logging::CheckpointTileScanner scanner;
+  std::vector<oid_t> column_ids({0, 3});
+  std::unique_ptr<executor::LogicalTile> checkpoint_tile(
+      scanner.Scan(table->GetTileGroup(0), column_ids, max_dead_cid));
+  EXPECT_EQ(tuple_count, checkpoint_tile->GetTupleCount());
+  for (auto tuple_id : *checkpoint_tile) {
+    EXPECT_EQ(0, values[tuple_id][3].Compare(
+                     checkpoint_tile->GetValue(tuple_id, 1)));
+  }
+
+  // Writers locate the copied tuples in the frozen tile group
+  EXPECT_EQ(frozen_tile_group, checkpoint_tile->GetBaseTile(0)->GetTileGroup());
+  EXPECT_TRUE(frozen_tile_group->IsFrozen());
+
+  // Writing a tuple thaws the tile group and releases the frozen values
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  storage::Tuple tuple(table->GetSchema(), true);
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    tuple.SetValue(column_itr, values[0][column_itr], testing_pool);
+  }
+  frozen_tile_group->CopyTuple(&tuple, 0);
+  EXPECT_FALSE(frozen_tile_group->IsFrozen());
+  EXPECT_EQ(nullptr, frozen_tile_group->GetFrozenTileGroup());
+  EXPECT_EQ(1U, ScanEqual(table.get(), ExecutorTestsUtil::PopulatedValue(
+                                           tuple_count - 1, 3)));
+
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      EXPECT_EQ(0, values[tuple_itr][column_itr].Compare(
+                       frozen_tile_group->GetValue(tuple_itr, column_itr)));
+    }
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
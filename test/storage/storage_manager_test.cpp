@@ -11,10 +11,19 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+
 #include "common/harness.h"
 
 #include "storage/storage_manager.h"
 
+extern bool peloton_huge_page_allocation;
+
+extern bool peloton_numa_aware_allocation;
+
 namespace peloton {
 namespace test {
 
@@ -55,5 +64,79 @@ TEST_F(StorageManagerTests, BasicTest) {
   }
 }
 
+/**
+ * Large blocks are mapped when huge pages or NUMA placement are enabled
+ */
+TEST_F(StorageManagerTests, MappedAllocationTest) {
+  peloton::storage::StorageManager storage_manager;
+
+  size_t small_length = 1024;
+  size_t large_length = 4 * 1024 * 1024;
+
+  peloton_huge_page_allocation = true;
+  peloton_numa_aware_allocation = true;
+
+  auto small_location =
+      storage_manager.Allocate(BACKEND_TYPE_MM, small_length);
+  EXPECT_EQ(0U, storage_manager.GetMappedAllocationCount());
+
+  auto large_location =
+      storage_manager.Allocate(BACKEND_TYPE_MM, large_length);
+  EXPECT_EQ(1U, storage_manager.GetMappedAllocationCount());
+  EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(large_location) %
+                    sysconf(_SC_PAGESIZE));
+
+  // Blocks allocated in either mode can be released in the other one
+  peloton_huge_page_allocation = false;
+  peloton_numa_aware_allocation = false;
+
+  PL_MEMSET(small_location, '-', small_length);
+  PL_MEMSET(large_location, '-', large_length);
+
+  storage_manager.Release(BACKEND_TYPE_MM, small_location);
+  storage_manager.Release(BACKEND_TYPE_MM, large_location);
+
+  large_location = storage_manager.Allocate(BACKEND_TYPE_MM, large_length);
+  EXPECT_EQ(1U, storage_manager.GetMappedAllocationCount());
+  storage_manager.Release(BACKEND_TYPE_MM, large_location);
+}
+
+/**
+ * A power-of-two block fills its huge pages exactly
+ */
+TEST_F(StorageManagerTests, HugePageAllocationTest) {
+  peloton::storage::StorageManager storage_manager;
+
+  size_t huge_page_size = 2 * 1024 * 1024;
+  size_t length = 4 * 1024 * 1024;
+
+  // Huge pages must be reserved up front (see vm.nr_hugepages)
+  size_t free_huge_page_count = 0;
+  std::ifstream meminfo("/proc/meminfo");
+  std::string line;
+  while (std::getline(meminfo, line)) {
+    if (line.find("HugePages_Free:") == 0) {
+      free_huge_page_count = std::stoul(line.substr(line.find(':') + 1));
+    }
+  }
+
+  if (free_huge_page_count * huge_page_size < length) {
+    LOG_INFO("Skipping test : %lu free huge pages", free_huge_page_count);
+    return;
+  }
+
+  peloton_huge_page_allocation = true;
+
+  auto location = storage_manager.Allocate(BACKEND_TYPE_MM, length);
+  EXPECT_EQ(1U, storage_manager.GetMappedAllocationCount());
+  EXPECT_EQ(1U, storage_manager.GetHugePageAllocationCount());
+  EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(location) % huge_page_size);
+
+  PL_MEMSET(location, '-', length);
+  storage_manager.Release(BACKEND_TYPE_MM, location);
+
+  peloton_huge_page_allocation = false;
+}
+
 }  // End test namespace
 }  // End peloton namespace
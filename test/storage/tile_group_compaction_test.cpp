@@ -0,0 +1,229 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compaction_test.cpp
+//
+// Identification: test/storage/tile_group_compaction_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include <chrono>
+#include <thread>
+
+#include "common/harness.h"
+
+#include "brain/tile_group_compactor.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/delete_executor.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/expression_util.h"
+#include "index/index.h"
+#include "planner/delete_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compaction Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupCompactionTests : public PelotonTest {};
+
+// Count the visible tuples of the table
+size_t CountTuples(storage::DataTable *table) {
+  std::vector<oid_t> column_ids({0});
+  planner::SeqScanPlan node(table, nullptr, column_ids);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  size_t result_tuple_count = 0;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    result_tuple_count += result_tile->GetTupleCount();
+  }
+
+  txn_manager.CommitTransaction();
+
+  return result_tuple_count;
+}
+
+// Delete the tuples where column 0 is less than the value
+void DeleteLessThan(storage::DataTable *table, int value) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  planner::DeletePlan delete_node(table, false);
+  executor::DeleteExecutor delete_executor(&delete_node, context.get());
+
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(value)));
+
+  std::vector<oid_t> column_ids({0});
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_node(
+      new planner::SeqScanPlan(table, predicate, column_ids));
+  executor::SeqScanExecutor seq_scan_executor(seq_scan_node.get(),
+                                              context.get());
+
+  delete_node.AddChild(std::move(seq_scan_node));
+  delete_executor.AddChild(&seq_scan_executor);
+
+  EXPECT_TRUE(delete_executor.Init());
+  EXPECT_TRUE(delete_executor.Execute());
+
+  txn_manager.CommitTransaction();
+}
+
+// Index entries of the key in column 0 of the primary index
+std::vector<ItemPointer> ScanPrimaryKey(storage::DataTable *table, int value) {
+  auto index = table->GetIndex(0);
+  std::unique_ptr<storage::Tuple> key(
+      new storage::Tuple(index->GetKeySchema(), true));
+  key->SetValue(0, ValueFactory::GetIntegerValue(value), index->GetPool());
+
+  std::vector<ItemPointer> locations;
+  index->ScanKey(key.get(), locations);
+  return locations;
+}
+
+TEST_F(TileGroupCompactionTests, CompactTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, true));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count * 2 + 1, false,
+                                   false, false);
+  txn_manager.CommitTransaction();
+
+  // Leave two live tuples in the first tile group
+  DeleteLessThan(table.get(),
+                 ExecutorTestsUtil::PopulatedValue(tuple_count - 2, 0));
+  size_t live_tuple_count = tuple_count + 3;
+  EXPECT_EQ(live_tuple_count, CountTuples(table.get()));
+
+  auto tile_group_id = table->GetTileGroup(0)->GetTileGroupId();
+  auto moved_value = ExecutorTestsUtil::PopulatedValue(tuple_count - 1, 0);
+
+  // Dense tile groups and recent versions are not compacted
+  auto max_dead_cid = txn_manager.GetCurrentCommitId();
+  EXPECT_FALSE(table->CompactTileGroup(1, 0.5, max_dead_cid));
+  EXPECT_FALSE(table->CompactTileGroup(0, 0.5, 0));
+  EXPECT_FALSE(table->CompactTileGroup(0, 0.2, max_dead_cid));
+  EXPECT_EQ(tile_group_id, ScanPrimaryKey(table.get(), moved_value)[0].block);
+
+  // Move the live tuples
+  EXPECT_FALSE(table->CompactTileGroup(0, 0.5, max_dead_cid));
+  EXPECT_EQ(live_tuple_count, CountTuples(table.get()));
+
+  // A writer that owns a version behind the tile group keeps it linked
+  max_dead_cid = txn_manager.GetCurrentCommitId();
+  auto old_location = ScanPrimaryKey(table.get(), moved_value)[0];
+  auto new_location = table->GetTileGroupById(old_location.block)
+                          ->GetHeader()
+                          ->GetNextItemPointer(old_location.offset);
+  auto new_header = table->GetTileGroupById(new_location.block)->GetHeader();
+  txn_id_t writer_txn_id = START_TXN_ID;
+  EXPECT_TRUE(
+      new_header->SetAtomicTransactionId(new_location.offset, writer_txn_id));
+  EXPECT_FALSE(table->CompactTileGroup(0, 0.5, max_dead_cid));
+  EXPECT_EQ(tile_group_id, ScanPrimaryKey(table.get(), moved_value)[0].block);
+  new_header->SetTransactionId(new_location.offset, INITIAL_TXN_ID);
+
+  // Unlink the tile group once the old versions are dead
+  EXPECT_FALSE(table->CompactTileGroup(0, 0.5, max_dead_cid));
+  EXPECT_EQ(live_tuple_count, CountTuples(table.get()));
+
+  auto locations = ScanPrimaryKey(table.get(), moved_value);
+  EXPECT_EQ(1U, locations.size());
+  EXPECT_NE(tile_group_id, locations[0].block);
+  auto moved_tile_group = table->GetTileGroupById(locations[0].block);
+  EXPECT_EQ(moved_value, moved_tile_group->GetValue(locations[0].offset, 0)
+                             .GetIntegerForTestsOnly());
+
+  for (oid_t index_itr = 0; index_itr < table->GetIndexCount(); index_itr++) {
+    std::vector<ItemPointer> index_locations;
+    table->GetIndex(index_itr)->ScanAllKeys(index_locations);
+    for (auto location : index_locations) {
+      EXPECT_NE(tile_group_id, location.block);
+    }
+  }
+
+  // Drop it once no transaction can still reach it
+  max_dead_cid = txn_manager.GetCurrentCommitId();
+  EXPECT_TRUE(table->CompactTileGroup(0, 0.5, max_dead_cid));
+  EXPECT_EQ(nullptr, table->GetTileGroup(0));
+  EXPECT_FALSE(table->CompactTileGroup(0, 0.5, max_dead_cid));
+  EXPECT_EQ(live_tuple_count, CountTuples(table.get()));
+}
+
+TEST_F(TileGroupCompactionTests, CompactorTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, true));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count * 2 + 1, false,
+                                   false, false);
+  txn_manager.CommitTransaction();
+
+  // Leave one live tuple in the first tile group
+  DeleteLessThan(table.get(),
+                 ExecutorTestsUtil::PopulatedValue(tuple_count - 1, 0));
+  size_t live_tuple_count = tuple_count + 2;
+  EXPECT_EQ(live_tuple_count, CountTuples(table.get()));
+
+  auto tile_group_id = table->GetTileGroup(0)->GetTileGroupId();
+  auto moved_value = ExecutorTestsUtil::PopulatedValue(tuple_count - 1, 0);
+
+  auto &tile_group_compactor = brain::TileGroupCompactor::GetInstance();
+  tile_group_compactor.AddTable(table.get());
+  tile_group_compactor.Start();
+
+  // The compactor relocates the live tuple, unlinks the tile group and drops
+  // it as the max dead cid passes each step
+  auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (table->GetTileGroup(0) != nullptr &&
+         std::chrono::steady_clock::now() < timeout) {
+    txn_manager.BeginTransaction();
+    txn_manager.CommitTransaction();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  tile_group_compactor.Stop();
+  tile_group_compactor.ClearTables();
+
+  EXPECT_EQ(nullptr, table->GetTileGroup(0));
+  EXPECT_EQ(live_tuple_count, CountTuples(table.get()));
+
+  auto locations = ScanPrimaryKey(table.get(), moved_value);
+  EXPECT_EQ(1U, locations.size());
+  EXPECT_NE(tile_group_id, locations[0].block);
+}
+
+}  // End test namespace
+}  // End peloton namespace
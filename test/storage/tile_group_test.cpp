@@ -543,5 +543,63 @@ TEST_F(TileGroupTests, TileCopyTest) {
   delete schema;
 }
 
+TEST_F(TileGroupTests, HeaderLayoutTest) {
+  const int tuple_count = 100;
+
+  storage::TileGroupHeader row_header(BACKEND_TYPE_MM, tuple_count,
+                                      LAYOUT_TYPE_ROW);
+  storage::TileGroupHeader column_header(BACKEND_TYPE_MM, tuple_count,
+                                         LAYOUT_TYPE_COLUMN);
+
+  EXPECT_EQ(LAYOUT_TYPE_ROW, row_header.GetHeaderLayout());
+  EXPECT_EQ(LAYOUT_TYPE_COLUMN, column_header.GetHeaderLayout());
+
+  for (oid_t tuple_id = 0; tuple_id < (oid_t)tuple_count; tuple_id++) {
+    ItemPointer next(tuple_id, tuple_id + 1);
+    ItemPointer prev(tuple_id, tuple_id + 2);
+
+    for (auto header : {&row_header, &column_header}) {
+      header->SetTransactionId(tuple_id, tuple_id + 1);
+      header->SetBeginCommitId(tuple_id, tuple_id + 2);
+      header->SetEndCommitId(tuple_id, tuple_id + 3);
+      header->SetNextItemPointer(tuple_id, next);
+      header->SetPrevItemPointer(tuple_id, prev);
+      header->SetInsertCommit(tuple_id, tuple_id % 2 == 0);
+      header->SetDeleteCommit(tuple_id, tuple_id % 3 == 0);
+      PL_MEMSET(header->GetReservedFieldRef(tuple_id), tuple_id,
+                storage::TileGroupHeader::GetReservedSize());
+    }
+  }
+
+  // Both layouts must return the same values
+  for (oid_t tuple_id = 0; tuple_id < (oid_t)tuple_count; tuple_id++) {
+    EXPECT_EQ(row_header.GetTransactionId(tuple_id),
+              column_header.GetTransactionId(tuple_id));
+    EXPECT_EQ(row_header.GetBeginCommitId(tuple_id),
+              column_header.GetBeginCommitId(tuple_id));
+    EXPECT_EQ(row_header.GetEndCommitId(tuple_id),
+              column_header.GetEndCommitId(tuple_id));
+    EXPECT_EQ(row_header.GetNextItemPointer(tuple_id).offset,
+              column_header.GetNextItemPointer(tuple_id).offset);
+    EXPECT_EQ(row_header.GetPrevItemPointer(tuple_id).offset,
+              column_header.GetPrevItemPointer(tuple_id).offset);
+    EXPECT_EQ(row_header.GetInsertCommit(tuple_id),
+              column_header.GetInsertCommit(tuple_id));
+    EXPECT_EQ(row_header.GetDeleteCommit(tuple_id),
+              column_header.GetDeleteCommit(tuple_id));
+    EXPECT_EQ(0, std::memcmp(row_header.GetReservedFieldRef(tuple_id),
+                             column_header.GetReservedFieldRef(tuple_id),
+                             storage::TileGroupHeader::GetReservedSize()));
+  }
+
+  // Each field is stored contiguously in the column layout
+  EXPECT_EQ(column_header.GetReservedFieldRef(0) +
+                storage::TileGroupHeader::GetReservedSize(),
+            column_header.GetReservedFieldRef(1));
+  EXPECT_EQ(row_header.GetReservedFieldRef(0) +
+                storage::TileGroupHeader::header_entry_size,
+            row_header.GetReservedFieldRef(1));
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,170 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map_test.cpp
+//
+// Identification: test/storage/zone_map_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tuple.h"
+#include "storage/zone_map.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Zone Map Tests
+//===--------------------------------------------------------------------===//
+
+class ZoneMapTests : public PelotonTest {};
+
+// column 0 BETWEEN [lower, upper)
+expression::AbstractExpression *CreateRangePredicate(int lower, int upper) {
+  auto lower_predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(lower)));
+
+  auto upper_predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(upper)),
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0));
+
+  return expression::ExpressionUtil::ConjunctionFactory(
+      EXPRESSION_TYPE_CONJUNCTION_AND, lower_predicate, upper_predicate);
+}
+
+TEST_F(ZoneMapTests, RangeTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(),
+                                   tuple_count * DEFAULT_TILEGROUP_COUNT,
+                                   false, false, false);
+  txn_manager.CommitTransaction();
+
+  // Tile group i holds column 0 values [50 * i, 50 * i + 40]
+  for (oid_t tile_group_itr = 0; tile_group_itr < DEFAULT_TILEGROUP_COUNT;
+       tile_group_itr++) {
+    auto tile_group = table->GetTileGroup(tile_group_itr);
+    auto &zone_map = tile_group->GetZoneMap();
+
+    int min_value = ExecutorTestsUtil::PopulatedValue(
+        tile_group_itr * tuple_count, 0);
+    int max_value = ExecutorTestsUtil::PopulatedValue(
+        (tile_group_itr + 1) * tuple_count - 1, 0);
+
+    EXPECT_TRUE(zone_map.IsTracked(0));
+    EXPECT_EQ(0, zone_map.GetMinValue(0).Compare(
+                     ValueFactory::GetIntegerValue(min_value)));
+    EXPECT_EQ(0, zone_map.GetMaxValue(0).Compare(
+                     ValueFactory::GetIntegerValue(max_value)));
+    EXPECT_EQ(0U, zone_map.GetNullCount(0));
+
+    // VARCHAR columns are not tracked
+    EXPECT_FALSE(zone_map.IsTracked(3));
+  }
+
+  // Only the second tile group can hold values in [50, 100)
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      CreateRangePredicate(50, 100));
+
+  for (oid_t tile_group_itr = 0; tile_group_itr < DEFAULT_TILEGROUP_COUNT;
+       tile_group_itr++) {
+    auto tile_group = table->GetTileGroup(tile_group_itr);
+    bool skip = tile_group->GetZoneMap().CanSkip(
+        predicate.get(), tile_group->GetNextTupleSlot());
+    EXPECT_EQ(tile_group_itr != 1, skip);
+  }
+
+  // The scan still finds every matching tuple
+  std::vector<oid_t> column_ids({0, 1});
+  planner::SeqScanPlan node(table.get(), CreateRangePredicate(40, 110),
+                            column_ids);
+
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  size_t result_tuple_count = 0;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    result_tuple_count += result_tile->GetTupleCount();
+  }
+
+  txn_manager.CommitTransaction();
+
+  // 40, 50, ... , 100
+  EXPECT_EQ(7U, result_tuple_count);
+}
+
+// Widen the zone map with 100 tuples, (i, -i / 2) for i in
+// [100 * thread_itr, 100 * thread_itr + 100)
+void UpdateZoneMap(storage::ZoneMap *zone_map, catalog::Schema *schema,
+                   uint64_t thread_itr) {
+  storage::Tuple tuple(schema, true);
+  for (int tuple_itr = 0; tuple_itr < 100; tuple_itr++) {
+    int value = static_cast<int>(thread_itr) * 100 + tuple_itr;
+    tuple.SetValue(0, ValueFactory::GetIntegerValue(value), nullptr);
+    tuple.SetValue(1, ValueFactory::GetDoubleValue(-value / 2.0), nullptr);
+    zone_map->Update(&tuple, true);
+  }
+}
+
+TEST_F(ZoneMapTests, ConcurrentUpdateTest) {
+  std::unique_ptr<catalog::Schema> schema(
+      new catalog::Schema({ExecutorTestsUtil::GetColumnInfo(0),
+                           ExecutorTestsUtil::GetColumnInfo(2)}));
+  storage::ZoneMap zone_map({VALUE_TYPE_INTEGER, VALUE_TYPE_DOUBLE});
+
+  LaunchParallelTest(4, UpdateZoneMap, &zone_map, schema.get());
+
+  EXPECT_EQ(400U, zone_map.GetCoveredTupleCount());
+  EXPECT_EQ(0, zone_map.GetMinValue(0).Compare(
+                   ValueFactory::GetIntegerValue(0)));
+  EXPECT_EQ(0, zone_map.GetMaxValue(0).Compare(
+                   ValueFactory::GetIntegerValue(399)));
+  EXPECT_EQ(0, zone_map.GetMinValue(1).Compare(
+                   ValueFactory::GetDoubleValue(-199.5)));
+  EXPECT_EQ(0, zone_map.GetMaxValue(1).Compare(
+                   ValueFactory::GetDoubleValue(0)));
+
+  // Negative doubles keep their order
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_LESSTHAN,
+          expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_DOUBLE, 0,
+                                                        1),
+          expression::ExpressionUtil::ConstantValueFactory(
+              ValueFactory::GetDoubleValue(-200))));
+  EXPECT_TRUE(zone_map.CanSkip(predicate.get(), 400));
+}
+
+}  // End test namespace
+}  // End peloton namespace